@@ -17,7 +17,7 @@ size_t PeriodicScheduler::events() const{
     return m_events.size();
 }
 bool PeriodicScheduler::add_event(void* event, std::chrono::milliseconds period, WallClock start){
-    auto ret = m_events.emplace(event, PeriodicEvent{m_callback_id, period});
+    auto ret = m_events.emplace(event, PeriodicEvent{m_callback_id, period, period, start});
     if (!ret.second){
         //  Already exists. Do nothing.
         return false;
@@ -68,8 +68,9 @@ void* PeriodicScheduler::request_next_event(WallClock timestamp){
         }
 
         //  Schedule the next event first so that we retain strong exception safety if it throws.
-        WallClock next = std::max(iter0->first + iter1->second.period, timestamp);
+        WallClock next = std::max(iter0->first + iter1->second.current_period, timestamp);
         m_schedule.emplace(next, iter0->second);
+        iter1->second.last_run = iter0->first;
 
         //  Now remove the current event.
         m_schedule.erase(iter0);
@@ -77,6 +78,39 @@ void* PeriodicScheduler::request_next_event(WallClock timestamp){
         return event.event;
     }
 }
+void PeriodicScheduler::report(void* event, PeriodicActivity activity, bool yield){
+    auto iter = m_events.find(event);
+    if (iter == m_events.end()){
+        return;
+    }
+    PeriodicEvent& entry = iter->second;
+
+    if (activity == PeriodicActivity::ACTIVE && yield){
+        activity = PeriodicActivity::STILL;
+    }
+
+    std::chrono::milliseconds period = entry.period;
+    switch (activity){
+    case PeriodicActivity::STILL:
+        period = std::max(entry.current_period, entry.period) * 2;
+        period = std::min(period, entry.period * MAX_STRETCH);
+        break;
+    case PeriodicActivity::ACTIVE:
+        break;
+    case PeriodicActivity::URGENT:
+        period = std::max(entry.period / 2, std::chrono::milliseconds(1));
+        break;
+    }
+    if (period == entry.current_period){
+        return;
+    }
+
+    //  Reschedule. Changing the ID makes the old entry in the schedule stale
+    //  so it gets skipped over.
+    m_schedule.emplace(entry.last_run + period, SingleEvent{m_callback_id, event});
+    entry.current_period = period;
+    entry.id = m_callback_id++;
+}
 
 
 
@@ -104,8 +138,9 @@ private:
 
 
 
-PeriodicRunner::PeriodicRunner(AsyncDispatcher& dispatcher)
+PeriodicRunner::PeriodicRunner(AsyncDispatcher& dispatcher, double utilization_ceiling)
     : m_dispatcher(dispatcher)
+    , m_utilization_ceiling(utilization_ceiling)
     , m_pending_waits(0)
 {}
 bool PeriodicRunner::add_event(void* event, std::chrono::milliseconds period, WallClock start){
@@ -136,6 +171,22 @@ void PeriodicRunner::remove_event(void* event){
         m_utilization.push_idle();
     }
 }
+void PeriodicRunner::report(void* event, PeriodicActivity activity, bool allow_backoff){
+    //  Called from run() so we already hold "m_lock".
+    if (!allow_backoff){
+        if (activity == PeriodicActivity::STILL){
+            activity = PeriodicActivity::ACTIVE;
+        }
+        m_scheduler.report(event, activity, false);
+        return;
+    }
+    bool yield;
+    {
+        ReadSpinLock lg(m_stats_lock);
+        yield = m_utilization.utilization() > m_utilization_ceiling;
+    }
+    m_scheduler.report(event, activity, yield);
+}
 bool PeriodicRunner::cancel(std::exception_ptr exception) noexcept{
     if (Cancellable::cancel(std::move(exception))){
         return true;
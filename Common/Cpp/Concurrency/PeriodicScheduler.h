@@ -22,6 +22,15 @@
 namespace PokemonAutomation{
 
 
+//  What happened the last time an event ran. Used to adapt its period.
+enum class PeriodicActivity{
+    STILL,      //  Nothing changed since the last run. Back off.
+    ACTIVE,     //  Something changed. Run at the normal period.
+    URGENT,     //  Close to triggering. Run faster than normal.
+};
+
+
+
 //
 //  This is the raw (unprotected) data structure that tracks all the events
 //  and determines what event should be fired next and when.
@@ -41,11 +50,23 @@ public:
     //  If nothing is before the current timestamp, return nullptr.
     void* request_next_event(WallClock timestamp = current_time());
 
+    //  Adapt the period of an event that was just returned by request_next_event().
+    //    - STILL doubles the period, up to MAX_STRETCH times the original.
+    //    - ACTIVE goes back to the original period. If "yield" is true, it
+    //      is treated as STILL instead.
+    //    - URGENT halves the original period.
+    //  If the period changes, the event is rescheduled from its last run.
+    void report(void* event, PeriodicActivity activity, bool yield = false);
+
+    static constexpr int MAX_STRETCH = 4;
+
 private:
     //  "id" is needed to solve the ABA problem if the same pointer is removed/re-added.
     struct PeriodicEvent{
         uint64_t id;
         std::chrono::milliseconds period;
+        std::chrono::milliseconds current_period;
+        WallClock last_run;
     };
     struct SingleEvent{
         uint64_t id;
@@ -73,10 +94,18 @@ public:
     double current_utilization() const;
 
 protected:
-    PeriodicRunner(AsyncDispatcher& dispatcher);
+    //  If the runner is busier than "utilization_ceiling", events that allow
+    //  it and aren't urgent are backed off so that the others can keep up.
+    PeriodicRunner(AsyncDispatcher& dispatcher, double utilization_ceiling = 0.80);
     bool add_event(void* event, std::chrono::milliseconds period, WallClock start = current_time());
     void remove_event(void* event);
 
+    //  Adapt the period of "event". See PeriodicScheduler::report().
+    //  If "allow_backoff" is false, the event never runs slower than its
+    //  requested period. It can still be sped up by URGENT.
+    //  This can only be called from inside run() for the event being run.
+    void report(void* event, PeriodicActivity activity, bool allow_backoff);
+
     //  Run the event. "is_back_to_back" is true if there was no wait between
     //  this event and the previous one.
     //  This can be used is a performance hint to the child class to reuse
@@ -91,6 +120,7 @@ protected:
 
 private:
     AsyncDispatcher& m_dispatcher;
+    const double m_utilization_ceiling;
 
     std::atomic<size_t> m_pending_waits;
     std::mutex m_lock;
@@ -42,6 +42,9 @@ public:
     void emplace_back(Args&&... args);
     void pop_back();
 
+    //  Make room for at least "items" objects without reallocating.
+    void reserve(size_t items);
+
     void clear();
 
     const Object* begin() const;
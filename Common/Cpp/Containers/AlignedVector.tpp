@@ -145,7 +145,13 @@ void AlignedVector<Object>::clear(){
 
 template <typename Object>
 PA_NO_INLINE void AlignedVector<Object>::expand(){
-    size_t size = m_capacity == 0 ? 1 : m_capacity * 2;
+    reserve(m_capacity == 0 ? 1 : m_capacity * 2);
+}
+template <typename Object>
+void AlignedVector<Object>::reserve(size_t size){
+    if (size <= m_capacity){
+        return;
+    }
     Object* ptr = (Object*)aligned_malloc(size * sizeof(Object), PA_ALIGNMENT);
     if (ptr == nullptr){
         throw std::bad_alloc();
@@ -2,204 +2,140 @@
  *
  *  From: https://github.com/PokemonAutomation/Arduino-Source
  *
- *      This class is experimental. It currently doesn't actually accomplish
- *  what it was intended for.
+ *  A spatial index over a set of boxes.
+ *
+ *  The plane is divided into square cells and each box is recorded in every
+ *  cell that it touches. A query only looks at the cells that it touches. So
+ *  as long as the cell size is on the order of the box sizes, a query costs
+ *  about the same regardless of how many boxes are in the set.
+ *
+ *  This is meant for the small-to-medium sets of detections that come out of
+ *  waterfill. It replaces the nested loops that were used to dedupe and merge
+ *  overlapping boxes.
  *
  */
 
 #ifndef PokemonAutomation_BoxSet_H
 #define PokemonAutomation_BoxSet_H
 
+#include <stdint.h>
 #include <string>
-#include <map>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+#include <algorithm>
 #include "Common/Cpp/Rectangle.h"
-#include "Common/Cpp/Exceptions.h"
 
 namespace PokemonAutomation{
 
 
 
 //
-//  An unordered container holding a set of boxes.
-//
-//  Iterating this container normally will iterate all the boxes in a fixed, but
-//  undefined order.
-//
-//  This class provides "axis iterators" that allow you to iterate the elements
-//  in order of each of the axis points on the box. This lets you efficiently
-//  iterate boxes that overlap with a point or another box.
+//  Boxes are referred to by the order in which they were inserted. Boxes
+//  cannot be removed individually.
 //
 template <typename Type>
 class BoxSet{
-public:
-    size_t size() const{ return m_boxes.size(); }
-    std::string dump() const;
+    static_assert(std::is_integral<Type>::value && std::is_unsigned<Type>::value, "BoxSet requires unsigned coordinates.");
 
-public:
-    class Entry;
+    //  Boxes that touch more cells than this are kept in a separate list that
+    //  is checked by every query instead of being spread across the grid.
+    static constexpr size_t MAX_CELLS_PER_BOX = 256;
 
-    //  Normal iterators. These iterate all the elements in a fixed, but
-    //  undefined order.
-    class iterator;
-    class const_iterator;
+public:
+    //  If "cell_size" is zero, it is picked from the boxes of the first bulk
+    //  insert. If the first insert is a single box, its size is used.
+    BoxSet(Type cell_size = 0)
+        : m_cell_size(cell_size)
+    {}
 
-    const_iterator cbegin() const;
-    const_iterator begin () const;
-          iterator begin ();
+    //  Bulk load.
+    template <typename BoxType>
+    BoxSet(const std::vector<BoxType>& boxes)
+        : m_cell_size(0)
+    {
+        insert(boxes);
+    }
 
-    const_iterator cend() const;
-    const_iterator end () const;
-          iterator end ();
+    size_t size() const{ return m_boxes.size(); }
+    bool empty() const{ return m_boxes.empty(); }
+    Type cell_size() const{ return m_cell_size; }
 
-public:
-    //  Axis iterator. These iterate the elements in increasing order either on
-    //  the X or Y axis.
+    const Rectangle<Type>& operator[](size_t index) const{ return m_boxes[index]; }
 
-    using axis_iterator = typename std::multimap<Type, Entry*>::const_iterator;
+    typename std::vector<Rectangle<Type>>::const_iterator begin() const{ return m_boxes.begin(); }
+    typename std::vector<Rectangle<Type>>::const_iterator end() const{ return m_boxes.end(); }
 
-    axis_iterator end_min_x() const{ return m_min_x.end(); }
-    axis_iterator end_max_x() const{ return m_max_x.end(); }
-    axis_iterator end_min_y() const{ return m_min_y.end(); }
-    axis_iterator end_max_y() const{ return m_max_y.end(); }
+    void clear();
 
-    axis_iterator lower_bound_min_x(Type x) const{ return m_min_x.lower_bound(x); }
-    axis_iterator upper_bound_min_x(Type x) const{ return m_min_x.upper_bound(x); }
-    axis_iterator lower_bound_max_x(Type x) const{ return m_max_x.lower_bound(x); }
-    axis_iterator upper_bound_max_x(Type x) const{ return m_max_x.upper_bound(x); }
-    axis_iterator lower_bound_min_y(Type y) const{ return m_min_y.lower_bound(y); }
-    axis_iterator upper_bound_min_y(Type y) const{ return m_min_y.upper_bound(y); }
-    axis_iterator lower_bound_max_y(Type y) const{ return m_max_y.lower_bound(y); }
-    axis_iterator upper_bound_max_y(Type y) const{ return m_max_y.upper_bound(y); }
+    std::string dump() const;
 
 public:
-    //  Insert box into set and return a normal iterator to it.
-    iterator insert(const Rectangle<Type>& box);
+    //  Insert a box and return its index.
+    size_t insert(const Rectangle<Type>& box);
 
-    //  Erase an iterator and return the next iterator. This will invalidate
-    //  all other iterators pointing to the same element.
-    iterator erase(iterator item);
-    axis_iterator erase(axis_iterator item);
+    //  Insert all the boxes. The first one gets index "size()" before the call.
+    template <typename BoxType>
+    void insert(const std::vector<BoxType>& boxes);
 
 public:
-    //  Advanced Functions
+    //  Queries. The lambda is called as "lambda(size_t index, const Rectangle<Type>& box)"
+    //  once for each box that matches. The order is unspecified.
 
-    //  Iterate on all boxes which either contain this point or on its border.
-    template <typename Func>
-    void iterate_in_or_on(Type x, Type y, Func&& lambda);
+    //  All boxes that overlap with "box". Boxes that only touch it don't count.
+    //  (same as "Rectangle::overlaps_with()")
+    template <typename Lambda>
+    void for_each_overlapping(const Rectangle<Type>& box, Lambda&& lambda) const;
 
+    //  All boxes that contain the point (x, y) or have it on their border.
+    //  (same as "Rectangle::is_inside_or_on()")
+    template <typename Lambda>
+    void for_each_containing(Type x, Type y, Lambda&& lambda) const;
 
-private:
-    static size_t get_key(const Rectangle<Type>& box);
+    std::vector<size_t> overlapping(const Rectangle<Type>& box) const;
+    std::vector<size_t> containing(Type x, Type y) const;
 
-private:
-    std::multimap<Type, Entry> m_boxes;
-    std::multimap<Type, Entry*> m_min_x;
-    std::multimap<Type, Entry*> m_max_x;
-    std::multimap<Type, Entry*> m_min_y;
-    std::multimap<Type, Entry*> m_max_y;
-};
-
-
-
-template <typename Type>
-class BoxSet<Type>::Entry{
-public:
-    Entry(const Rectangle<Type>& box)
-        : m_box(box)
-    {}
-
-    operator const Rectangle<Type>&() const{ return m_box; }
-    const Rectangle<Type>* operator->() const{ return &m_box; }
-    const Rectangle<Type>& box() const{ return m_box; }
 
 private:
-    friend class BoxSet<Type>;
-    Rectangle<Type> m_box;
-    typename std::multimap<Type, Entry*>::iterator m_min_x;
-    typename std::multimap<Type, Entry*>::iterator m_max_x;
-    typename std::multimap<Type, Entry*>::iterator m_min_y;
-    typename std::multimap<Type, Entry*>::iterator m_max_y;
-};
-
-
-template <typename Type>
-class BoxSet<Type>::iterator{
-public:
-    bool operator==(const iterator& iter) const{ return m_iter == iter.m_iter; }
-
-    iterator operator++(){
-        ++m_iter;
-        return *this;
-    }
-    auto operator*() const{ return *m_iter; }
-    auto operator*(){ return *m_iter; }
-    auto operator->() const{ return m_iter.operator->(); }
-    auto operator->(){ return m_iter.operator->(); }
-
-    axis_iterator iterator_min_x() const{
-        return m_iter->second.m_min_x;
-    }
-    axis_iterator iterator_max_x() const{
-        return m_iter->second.m_max_x;
+    static uint64_t cell_key(size_t x, size_t y){
+        return (uint64_t)x | ((uint64_t)y << 32);
     }
-    axis_iterator iterator_min_y() const{
-        return m_iter->second.m_min_y;
-    }
-    axis_iterator iterator_max_y() const{
-        return m_iter->second.m_max_y;
+    size_t cell(Type coordinate) const{
+        return (size_t)(coordinate / m_cell_size);
     }
+    void add_to_grid(size_t index);
 
 private:
-    friend class BoxSet<Type>;
-    friend class const_iterator;
-
-    typename std::multimap<Type, Entry>::iterator m_iter;
-
-    iterator(typename std::multimap<Type, Entry>::iterator iter)
-        : m_iter(iter)
-    {}
+    Type m_cell_size;
+    std::vector<Rectangle<Type>> m_boxes;
+    std::unordered_map<uint64_t, std::vector<size_t>> m_cells;
+    std::vector<size_t> m_large;
 };
 
 
-template <typename Type>
-class BoxSet<Type>::const_iterator{
-public:
-    bool operator==(const iterator& iter) const{ return m_iter == iter.m_iter; }
-
-    const_iterator(iterator iter)
-        : m_iter(iter.m_iter)
-    {}
-    const_iterator operator++(){
-        ++m_iter;
-        return *this;
-    }
-    auto operator*() const{ return *m_iter; }
-    auto operator*(){ return *m_iter; }
-    auto operator->() const{ return m_iter.operator->(); }
-    auto operator->(){ return m_iter.operator->(); }
-
-    axis_iterator iterator_min_x() const{
-        return m_iter->second.m_min_x;
-    }
-    axis_iterator iterator_max_x() const{
-        return m_iter->second.m_max_x;
-    }
-    axis_iterator iterator_min_y() const{
-        return m_iter->second.m_min_y;
-    }
-    axis_iterator iterator_max_y() const{
-        return m_iter->second.m_max_y;
-    }
-
-private:
-    friend class BoxSet<Type>;
 
-    typename std::multimap<Type, Entry>::iterator m_iter;
+//
+//  Merge Helpers
+//
 
-    const_iterator(typename std::multimap<Type, Entry>::iterator iter)
-        : m_iter(iter)
-    {}
-};
+//  Group boxes that overlap each other, either directly or through a chain of
+//  other boxes. If "same_group(a, b)" is given, two overlapping boxes are only
+//  joined if it also returns true.
+//
+//  Returns the group of each box. Groups are numbered from zero in the order
+//  of their first box.
+template <typename BoxType>
+std::vector<size_t> cluster_overlapping_boxes(const std::vector<BoxType>& boxes);
+template <typename BoxType, typename Predicate>
+std::vector<size_t> cluster_overlapping_boxes(const std::vector<BoxType>& boxes, Predicate&& same_group);
+
+//  Replace every group of overlapping boxes with its bounding box. The result
+//  is in the order of the first box of each group.
+//
+//  The resulting boxes may still overlap each other. Two groups don't overlap,
+//  but their bounding boxes can.
+template <typename BoxType>
+std::vector<BoxType> merge_overlapping_boxes(const std::vector<BoxType>& boxes);
 
 
 
@@ -210,40 +146,11 @@ private:
 //
 
 
-
 template <typename Type>
-inline typename BoxSet<Type>::const_iterator BoxSet<Type>::cbegin() const{
-    return m_boxes.cbegin();
-}
-template <typename Type>
-inline typename BoxSet<Type>::const_iterator BoxSet<Type>::begin () const{
-    return m_boxes.begin();
-}
-template <typename Type>
-inline typename BoxSet<Type>::iterator BoxSet<Type>::begin(){
-    return m_boxes.begin();
-}
-
-template <typename Type>
-inline typename BoxSet<Type>::const_iterator BoxSet<Type>::cend() const{
-    return m_boxes.cend();
-}
-template <typename Type>
-inline typename BoxSet<Type>::const_iterator BoxSet<Type>::end() const{
-    return m_boxes.end();
-}
-template <typename Type>
-inline typename BoxSet<Type>::iterator BoxSet<Type>::end(){
-    return m_boxes.end();
-}
-
-
-
-template <typename Type>
-size_t BoxSet<Type>::get_key(const Rectangle<Type>& box){
-    //  Basically a simple hash function that preserves some sort of visual
-    //  order if everything is small.
-    return box.min_x + (box.min_y << 32) + (box.min_y >> 32);
+void BoxSet<Type>::clear(){
+    m_boxes.clear();
+    m_cells.clear();
+    m_large.clear();
 }
 
 template <typename Type>
@@ -254,99 +161,235 @@ std::string BoxSet<Type>::dump() const{
         str += "\r\n";
         return str;
     }
-    str += std::to_string(m_boxes.size()) + " items\r\n";
-    for (const auto& item : m_boxes){
-        str += "    {" + std::to_string(item.second.m_box.min_x);
-        str += "-" + std::to_string(item.second.m_box.max_x);
-        str += ", " + std::to_string(item.second.m_box.min_y);
-        str += "-" + std::to_string(item.second.m_box.max_y);
+    str += std::to_string(m_boxes.size()) + " items";
+    str += ", cell size = " + std::to_string(m_cell_size);
+    str += ", cells = " + std::to_string(m_cells.size());
+    str += ", large = " + std::to_string(m_large.size()) + "\r\n";
+    for (const Rectangle<Type>& box : m_boxes){
+        str += "    {" + std::to_string(box.min_x);
+        str += "-" + std::to_string(box.max_x);
+        str += ", " + std::to_string(box.min_y);
+        str += "-" + std::to_string(box.max_y);
         str += "}\r\n";
     }
     return str;
 }
 
+
 template <typename Type>
-typename BoxSet<Type>::iterator BoxSet<Type>::insert(const Rectangle<Type>& box){
-    auto iter = m_boxes.end();
-    auto min_x = m_min_x.end();
-    auto max_x = m_max_x.end();
-    auto min_y = m_min_y.end();
-    auto max_y = m_max_y.end();
-    try{
-        iter = m_boxes.emplace(get_key(box), box);
-        min_x = m_min_x.emplace(box.min_x, &iter->second);
-        max_x = m_max_x.emplace(box.max_x, &iter->second);
-        min_y = m_min_y.emplace(box.min_y, &iter->second);
-        max_y = m_max_y.emplace(box.max_y, &iter->second);
-        iter->second.m_min_x = min_x;
-        iter->second.m_max_x = max_x;
-        iter->second.m_min_y = min_y;
-        iter->second.m_max_y = max_y;
-    }catch (...){
-        if (iter != m_boxes.end()){ m_boxes.erase(iter); }
-        if (min_x != m_min_x.end()){ m_min_x.erase(min_x); }
-        if (max_x != m_max_x.end()){ m_max_x.erase(max_x); }
-        if (min_y != m_min_y.end()){ m_min_y.erase(min_x); }
-        if (max_y != m_max_y.end()){ m_max_y.erase(max_x); }
-        throw;
+size_t BoxSet<Type>::insert(const Rectangle<Type>& box){
+    if (m_cell_size == 0){
+        m_cell_size = std::max<Type>(std::max(box.width(), box.height()), 1);
     }
-    return iter;
+    size_t index = m_boxes.size();
+    m_boxes.emplace_back(box);
+    add_to_grid(index);
+    return index;
 }
 template <typename Type>
-typename BoxSet<Type>::iterator BoxSet<Type>::erase(iterator item){
-    m_min_x.erase(item.iterator_min_x());
-    m_max_x.erase(item.iterator_max_x());
-    m_min_y.erase(item.iterator_min_y());
-    m_max_y.erase(item.iterator_max_y());
-    return m_boxes.erase(item.m_iter);
+template <typename BoxType>
+void BoxSet<Type>::insert(const std::vector<BoxType>& boxes){
+    if (boxes.empty()){
+        return;
+    }
+    if (m_cell_size == 0){
+        //  Use the median of the larger dimension. Most boxes then touch at
+        //  most 4 cells, and the occasional huge box doesn't blow up the cells
+        //  of everything else.
+        std::vector<Type> sizes;
+        sizes.reserve(boxes.size());
+        for (const BoxType& box : boxes){
+            sizes.emplace_back(std::max(box.width(), box.height()));
+        }
+        auto mid = sizes.begin() + sizes.size() / 2;
+        std::nth_element(sizes.begin(), mid, sizes.end());
+        m_cell_size = std::max<Type>(*mid, 1);
+    }
+    m_boxes.reserve(m_boxes.size() + boxes.size());
+    for (const BoxType& box : boxes){
+        size_t index = m_boxes.size();
+        m_boxes.emplace_back(box);
+        add_to_grid(index);
+    }
 }
 template <typename Type>
-typename BoxSet<Type>::axis_iterator BoxSet<Type>::erase(axis_iterator item){
-    axis_iterator next = item;
-    ++next;
-
-    size_t key = get_key(*item->second);
-    auto iter = m_boxes.find(key);
-    Entry* entry = item->second;
-
-    //  Find element in the boxes map.
-    while (true){
-        if (iter == m_boxes.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "axis_iterator points in invalid box.");
-        }
-        if (&iter->second == entry){
-            break;
+void BoxSet<Type>::add_to_grid(size_t index){
+    const Rectangle<Type>& box = m_boxes[index];
+    size_t min_x = cell(box.min_x);
+    size_t min_y = cell(box.min_y);
+    size_t max_x = cell(box.max_x);
+    size_t max_y = cell(box.max_y);
+    if ((max_x - min_x + 1) * (max_y - min_y + 1) > MAX_CELLS_PER_BOX){
+        m_large.emplace_back(index);
+        return;
+    }
+    for (size_t y = min_y; y <= max_y; y++){
+        for (size_t x = min_x; x <= max_x; x++){
+            m_cells[cell_key(x, y)].emplace_back(index);
         }
-        ++iter;
     }
-
-    //  Remove it.
-    erase(iter);
-
-    return next;
 }
 
 
-#if 0
 template <typename Type>
-template <typename Func>
-void BoxSet<Type>::iterate_in_or_on(Type x, Type y, Func&& lambda){
-    axis_iterator iter = lower_bound_min_x(x);
+template <typename Lambda>
+void BoxSet<Type>::for_each_overlapping(const Rectangle<Type>& box, Lambda&& lambda) const{
+    if (m_boxes.empty()){
+        return;
+    }
+
+    size_t min_x = cell(box.min_x);
+    size_t min_y = cell(box.min_y);
+    size_t max_x = cell(box.max_x);
+    size_t max_y = cell(box.max_y);
+
+    //  The query is so large that it's cheaper to just check everything.
+    if ((max_x - min_x + 1) * (max_y - min_y + 1) > m_boxes.size()){
+        for (size_t index = 0; index < m_boxes.size(); index++){
+            if (m_boxes[index].overlaps_with(box)){
+                lambda(index, m_boxes[index]);
+            }
+        }
+        return;
+    }
 
-    //  Iterate for every x within
-    while (iter == end_min_x() && iter->first <= x){
-        Entry& entry = *iter->second;
+    for (size_t index : m_large){
+        if (m_boxes[index].overlaps_with(box)){
+            lambda(index, m_boxes[index]);
+        }
+    }
+    for (size_t y = min_y; y <= max_y; y++){
+        for (size_t x = min_x; x <= max_x; x++){
+            auto iter = m_cells.find(cell_key(x, y));
+            if (iter == m_cells.end()){
+                continue;
+            }
+            for (size_t index : iter->second){
+                const Rectangle<Type>& current = m_boxes[index];
+                if (!current.overlaps_with(box)){
+                    continue;
+                }
+
+                //  A box can be in more than one of the cells we are looking
+                //  at. Only report it from the first cell that both it and the
+                //  query touch.
+                if (x != std::max(min_x, cell(current.min_x)) || y != std::max(min_y, cell(current.min_y))){
+                    continue;
+                }
+                lambda(index, current);
+            }
+        }
+    }
+}
+template <typename Type>
+template <typename Lambda>
+void BoxSet<Type>::for_each_containing(Type x, Type y, Lambda&& lambda) const{
+    for (size_t index : m_large){
+        if (m_boxes[index].is_inside_or_on(x, y)){
+            lambda(index, m_boxes[index]);
+        }
+    }
+    if (m_cells.empty()){
+        return;
+    }
 
-        ++iter;
-        if (entry.m_min_y <= y && y <= entry.m_min_y){
-            lambda();
+    //  A box is recorded in every cell it touches including its border. So
+    //  the cell that the point is in has everything we need.
+    auto iter = m_cells.find(cell_key(cell(x), cell(y)));
+    if (iter == m_cells.end()){
+        return;
+    }
+    for (size_t index : iter->second){
+        if (m_boxes[index].is_inside_or_on(x, y)){
+            lambda(index, m_boxes[index]);
         }
     }
 }
-#endif
 
+template <typename Type>
+std::vector<size_t> BoxSet<Type>::overlapping(const Rectangle<Type>& box) const{
+    std::vector<size_t> ret;
+    for_each_overlapping(box, [&](size_t index, const Rectangle<Type>&){
+        ret.emplace_back(index);
+    });
+    return ret;
+}
+template <typename Type>
+std::vector<size_t> BoxSet<Type>::containing(Type x, Type y) const{
+    std::vector<size_t> ret;
+    for_each_containing(x, y, [&](size_t index, const Rectangle<Type>&){
+        ret.emplace_back(index);
+    });
+    return ret;
+}
+
+
+
+template <typename BoxType>
+std::vector<size_t> cluster_overlapping_boxes(const std::vector<BoxType>& boxes){
+    return cluster_overlapping_boxes(boxes, [](const BoxType&, const BoxType&){ return true; });
+}
+template <typename BoxType, typename Predicate>
+std::vector<size_t> cluster_overlapping_boxes(const std::vector<BoxType>& boxes, Predicate&& same_group){
+    using Type = decltype(boxes[0].min_x);
+
+    //  Union-find over the box indices.
+    std::vector<size_t> parent(boxes.size());
+    for (size_t c = 0; c < boxes.size(); c++){
+        parent[c] = c;
+    }
+    auto find = [&](size_t x){
+        while (parent[x] != x){
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    BoxSet<Type> index(boxes);
+    for (size_t c = 0; c < boxes.size(); c++){
+        index.for_each_overlapping(boxes[c], [&](size_t other, const Rectangle<Type>&){
+            if (other <= c){
+                return;
+            }
+            size_t a = find(c);
+            size_t b = find(other);
+            if (a == b || !same_group(boxes[c], boxes[other])){
+                return;
+            }
+            parent[std::max(a, b)] = std::min(a, b);
+        });
+    }
 
+    //  Number the groups in order of their first box. The root of a group is
+    //  always its lowest index.
+    std::vector<size_t> group(boxes.size());
+    size_t groups = 0;
+    for (size_t c = 0; c < boxes.size(); c++){
+        size_t root = find(c);
+        group[c] = root == c ? groups++ : group[root];
+    }
+    return group;
+}
 
+template <typename BoxType>
+std::vector<BoxType> merge_overlapping_boxes(const std::vector<BoxType>& boxes){
+    std::vector<size_t> group = cluster_overlapping_boxes(boxes);
+    std::vector<BoxType> ret;
+    for (size_t c = 0; c < boxes.size(); c++){
+        const BoxType& box = boxes[c];
+        if (group[c] == ret.size()){
+            ret.emplace_back(box);
+            continue;
+        }
+        BoxType& merged = ret[group[c]];
+        merged.min_x = std::min(merged.min_x, box.min_x);
+        merged.min_y = std::min(merged.min_y, box.min_y);
+        merged.max_x = std::max(merged.max_x, box.max_x);
+        merged.max_y = std::max(merged.max_y, box.max_y);
+    }
+    return ret;
+}
 
 
 
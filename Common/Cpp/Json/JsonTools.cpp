@@ -8,6 +8,7 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QFile>
+#include <QSaveFile>
 #include "Common/Cpp/Exceptions.h"
 #include "JsonTools.h"
 #include "JsonArray.h"
@@ -29,14 +30,18 @@ void string_to_file(const std::string& filename, const std::string& str){
         previous = ch;
     }
 
-    QFile file(QString::fromStdString(filename));
+    //  Write to a temporary file and rename it over the original. So a crash
+    //  in the middle of the write can't leave a truncated file behind.
+    QSaveFile file(QString::fromStdString(filename));
     if (!file.open(QFile::WriteOnly)){
         throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to create file.", filename);
     }
     if (file.write(json_out.c_str(), json_out.size()) != (int)json_out.size()){
         throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write file.", filename);
     }
-    file.close();
+    if (!file.commit()){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write file.", filename);
+    }
 }
 std::string file_to_string(const std::string& filename){
     QFile file(QString::fromStdString(filename));
@@ -73,6 +73,12 @@ void MisalignedStreamConverter::add_listener(StreamListener& listener){
 void MisalignedStreamConverter::remove_listener(StreamListener& listener){
     m_listeners.erase(&listener);
 }
+void MisalignedStreamConverter::set_passthrough(size_t alignment){
+    if (alignment != 0 && m_object_size_in != m_object_size_out){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Passthrough requires matching object sizes.");
+    }
+    m_passthrough_alignment = alignment;
+}
 void MisalignedStreamConverter::push_bytes(const void* data, size_t bytes){
 //    cout << "push: ";
 //    print_u8((uint8_t*)data, bytes);
@@ -98,6 +104,23 @@ void MisalignedStreamConverter::push_bytes(const void* data, size_t bytes){
     }
 
     size_t objects = bytes / m_object_size_in;
+
+    //  Send whole objects straight to the listeners.
+    if (objects > 0 && m_passthrough_alignment != 0 && (size_t)data % m_passthrough_alignment == 0){
+        if (stored > 0){
+            for (StreamListener* listener : m_listeners){
+                listener->on_objects(m_buffer.data(), stored);
+            }
+            stored = 0;
+        }
+        for (StreamListener* listener : m_listeners){
+            listener->on_objects(data, objects);
+        }
+        data = (char*)data + objects * m_object_size_in;
+        bytes -= objects * m_object_size_in;
+        objects = 0;
+    }
+
     while (stored + objects > 0){
         size_t block = std::min(objects, m_buffer_capacity - stored);
 //        cout << "stored = " << stored << endl;
@@ -76,9 +76,16 @@ public:
 protected:
     virtual void convert(void* out, const void* in, size_t count) = 0;
 
+    //  Use this when "convert()" is a plain copy. Whole objects in the input
+    //  are then sent to the listeners directly instead of being copied first.
+    //  This is only done when the input is aligned to "alignment".
+    //  Set "alignment" to zero to disable.
+    void set_passthrough(size_t alignment);
+
 private:
     size_t m_object_size_in;
     size_t m_object_size_out;
+    size_t m_passthrough_alignment = 0;
 
     AlignedVector<char> m_edge;
     size_t m_edge_size = 0;
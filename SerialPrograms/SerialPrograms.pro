@@ -202,7 +202,9 @@ SOURCES += \
     Source/CommonFramework/ImageTools/ImageBoxes.cpp \
     Source/CommonFramework/ImageTools/ImageFilter.cpp \
     Source/CommonFramework/ImageTools/ImageGradient.cpp \
+    Source/CommonFramework/ImageTools/ImageIntegral.cpp \
     Source/CommonFramework/ImageTools/ImageManip.cpp \
+    Source/CommonFramework/ImageTools/ImagePyramid.cpp \
     Source/CommonFramework/ImageTools/ImageStats.cpp \
     Source/CommonFramework/ImageTools/SolidColorTest.cpp \
     Source/CommonFramework/ImageTools/WaterfillUtilities.cpp \
@@ -220,6 +222,7 @@ SOURCES += \
     Source/CommonFramework/Inference/FrozenImageDetector.cpp \
     Source/CommonFramework/Inference/ImageMatchDetector.cpp \
     Source/CommonFramework/Inference/ImageTools.cpp \
+    Source/CommonFramework/Inference/LocationTracker.cpp \
     Source/CommonFramework/Inference/SpectrogramMatcher.cpp \
     Source/CommonFramework/Inference/StatAccumulator.cpp \
     Source/CommonFramework/InferenceInfra/AudioInferencePivot.cpp \
@@ -296,6 +299,7 @@ SOURCES += \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWidget.cpp \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWindow.cpp \
     Source/CommonFramework/VideoPipeline/UI/VideoOverlayWidget.cpp \
+    Source/CommonFramework/VideoPipeline/VideoHistory.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlayOption.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlaySession.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlayTypes.cpp \
@@ -325,6 +329,8 @@ SOURCES += \
     Source/Kernels/Algorithm/Kernels_Algorithm_DisjointSet.cpp \
     Source/Kernels/AudioStreamConversion/AudioStreamConversion.cpp \
     Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_Default.cpp \
+    Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_arm64_NEON.cpp \
+    Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_x86_AVX2.cpp \
     Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_x86_SSE41.cpp \
     Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.cpp \
     Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters_Core_64x16_x64_AVX2.cpp \
@@ -343,18 +349,36 @@ SOURCES += \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_Core_x64_AVX2.cpp \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_Core_x64_AVX512.cpp \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_Core_x64_SSE42.cpp \
+    Source/Kernels/ImageConvert/Kernels_ImageConvert_HSV32.cpp \
+    Source/Kernels/ImageConvert/Kernels_ImageConvert_HSV32_Default.cpp \
+    Source/Kernels/ImageConvert/Kernels_ImageConvert_HSV32_arm64_NEON.cpp \
+    Source/Kernels/ImageConvert/Kernels_ImageConvert_HSV32_x64_AVX2.cpp \
+    Source/Kernels/ImageConvert/Kernels_ImageConvert_HSV32_x64_AVX512.cpp \
+    Source/Kernels/ImageConvert/Kernels_ImageConvert_HSV32_x64_SSE41.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_Default.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_arm64_NEON.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX2.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX512.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_SSE42.cpp \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient.cpp \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_Default.cpp \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_x64_AVX2.cpp \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_x64_SSE41.cpp \
+    Source/Kernels/ImageScale/Kernels_ImageScale_Halve.cpp \
+    Source/Kernels/ImageScale/Kernels_ImageScale_Halve_Default.cpp \
+    Source/Kernels/ImageScale/Kernels_ImageScale_Halve_x64_AVX2.cpp \
+    Source/Kernels/ImageScale/Kernels_ImageScale_Halve_x64_SSE41.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_Default.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_arm64_NEON.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX2.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX512.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_SSE41.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral_Default.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral_x64_AVX2.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral_x64_SSE41.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_Default.cpp \
@@ -384,6 +408,8 @@ SOURCES += \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x8_arm64_NEON.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x8_x64_SSE42.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.cpp \
+    Source/Kernels/Waterfill/Kernels_Waterfill_FilterRgb32Range.cpp \
+    Source/Kernels/Waterfill/Kernels_Waterfill_ObjectList.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Session.cpp \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_Device.cpp \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_DigitEntry.cpp \
@@ -750,6 +776,7 @@ SOURCES += \
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterRNG.cpp \
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterRNGTable.cpp \
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.cpp \
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch.cpp \
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterTools.cpp \
     Source/PokemonSV/Programs/PokemonSV_AreaZero.cpp \
     Source/PokemonSV/Programs/PokemonSV_ConnectToInternet.cpp \
@@ -971,6 +998,8 @@ SOURCES += \
     Source/PokemonSwSh/ShinyHuntTracker.cpp \
     Source/Tests/CommandLineTests.cpp \
     Source/Tests/CommonFramework_Tests.cpp \
+    Source/Tests/InferenceReplay.cpp \
+    Source/Tests/Kernels_Benchmarks.cpp \
     Source/Tests/Kernels_Tests.cpp \
     Source/Tests/NintendoSwitch_Tests.cpp \
     Source/Tests/PokemonLA_Tests.cpp \
@@ -1240,7 +1269,9 @@ HEADERS += \
     Source/CommonFramework/ImageTools/ImageBoxes.h \
     Source/CommonFramework/ImageTools/ImageFilter.h \
     Source/CommonFramework/ImageTools/ImageGradient.h \
+    Source/CommonFramework/ImageTools/ImageIntegral.h \
     Source/CommonFramework/ImageTools/ImageManip.h \
+    Source/CommonFramework/ImageTools/ImagePyramid.h \
     Source/CommonFramework/ImageTools/ImageStats.h \
     Source/CommonFramework/ImageTools/SolidColorTest.h \
     Source/CommonFramework/ImageTools/WaterfillUtilities.h \
@@ -1260,6 +1291,7 @@ HEADERS += \
     Source/CommonFramework/Inference/ImageMatchDetector.h \
     Source/CommonFramework/Inference/ImageTools.h \
     Source/CommonFramework/Inference/InferenceThrottler.h \
+    Source/CommonFramework/Inference/LocationTracker.h \
     Source/CommonFramework/Inference/SpectrogramMatcher.h \
     Source/CommonFramework/Inference/StatAccumulator.h \
     Source/CommonFramework/Inference/TimeWindowStatTracker.h \
@@ -1347,6 +1379,7 @@ HEADERS += \
     Source/CommonFramework/VideoPipeline/UI/VideoOverlayWidget.h \
     Source/CommonFramework/VideoPipeline/UI/VideoWidget.h \
     Source/CommonFramework/VideoPipeline/VideoFeed.h \
+    Source/CommonFramework/VideoPipeline/VideoHistory.h \
     Source/CommonFramework/VideoPipeline/VideoOverlay.h \
     Source/CommonFramework/VideoPipeline/VideoOverlayOption.h \
     Source/CommonFramework/VideoPipeline/VideoOverlayScopes.h \
@@ -1417,8 +1450,16 @@ HEADERS += \
     Source/Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixCore.tpp \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.h \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.tpp \
+    Source/Kernels/ImageConvert/Kernels_ImageConvert_HSV32.h \
+    Source/Kernels/ImageConvert/Kernels_ImageConvert_HSV32_Default.h \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.h \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient.h \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_Default.h \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_Routines.h \
+    Source/Kernels/ImageScale/Kernels_ImageScale_Halve.h \
+    Source/Kernels/ImageScale/Kernels_ImageScale_Halve_Routines.h \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h \
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h \
     Source/Kernels/Kernels_Alignment.h \
@@ -1445,8 +1486,10 @@ HEADERS += \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x8_arm64_NEON.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x8_x64_SSE42.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.h \
+    Source/Kernels/Waterfill/Kernels_Waterfill_FilterRgb32Range.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Intrinsics_x64_AVX512-GF.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Intrinsics_x64_AVX512.h \
+    Source/Kernels/Waterfill/Kernels_Waterfill_ObjectList.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Routines.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Session.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Session.tpp \
@@ -1827,6 +1870,7 @@ HEADERS += \
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterRNG.h \
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterRNGTable.h \
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.h \
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch.h \
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterTools.h \
     Source/PokemonSV/Programs/PokemonSV_AreaZero.h \
     Source/PokemonSV/Programs/PokemonSV_ConnectToInternet.h \
@@ -2053,6 +2097,8 @@ HEADERS += \
     Source/PokemonSwSh/ShinyHuntTracker.h \
     Source/Tests/CommandLineTests.h \
     Source/Tests/CommonFramework_Tests.h \
+    Source/Tests/InferenceReplay.h \
+    Source/Tests/Kernels_Benchmarks.h \
     Source/Tests/Kernels_Tests.h \
     Source/Tests/NintendoSwitch_Tests.h \
     Source/Tests/PokemonLA_Tests.h \
@@ -46,11 +46,25 @@ public:
 
     //  Return all the spectrums with stamps greater or equal to `starting_stamp`
     //  Returned spectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
-    virtual std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum) = 0;
+    std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum){
+        std::vector<AudioSpectrum> ret;
+        load_spectrums_since(ret, starting_seqnum);
+        return ret;
+    }
 
     //  Return a specific number of latest spectrums.
     //  Returned spectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
-    virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) = 0;
+    std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums){
+        std::vector<AudioSpectrum> ret;
+        load_spectrums_latest(ret, num_last_spectrums);
+        return ret;
+    }
+
+    //  Same as above, but write into `spectrums` instead. `spectrums` is
+    //  cleared first. Anything polling the feed should keep the same vector
+    //  around so that this doesn't allocate every time.
+    virtual void load_spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_seqnum) = 0;
+    virtual void load_spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_last_spectrums) = 0;
 
     //  Add visual overlay to the spectrums starting at `starting_stamp` and before `end_stamp` with `color`.
     virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) = 0;
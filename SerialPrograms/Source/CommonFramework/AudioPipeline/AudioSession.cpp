@@ -252,11 +252,11 @@ void AudioSession::reset(){
         );
     }
 }
-std::vector<AudioSpectrum> AudioSession::spectrums_since(uint64_t starting_seqnum){
-    return m_spectrum_holder.spectrums_since(starting_seqnum);
+void AudioSession::load_spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_seqnum){
+    m_spectrum_holder.spectrums_since(spectrums, starting_seqnum);
 }
-std::vector<AudioSpectrum> AudioSession::spectrums_latest(size_t num_last_spectrums){
-    return m_spectrum_holder.spectrums_latest(num_last_spectrums);
+void AudioSession::load_spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_last_spectrums){
+    m_spectrum_holder.spectrums_latest(spectrums, num_last_spectrums);
 }
 void AudioSession::add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color){
     m_spectrum_holder.add_overlay(starting_seqnum, end_seqnum, color);
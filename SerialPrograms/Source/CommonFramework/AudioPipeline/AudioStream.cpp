@@ -79,6 +79,11 @@ AudioStreamToFloat::AudioStreamToFloat(
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Reverse channels only works with 2 samples/frame.");
     }
     MisalignedStreamConverter::add_listener(*this);
+
+    //  Float input that needs no changes can go straight to the listeners.
+    if (input_format == AudioSampleFormat::FLOAT32 && volume_multiplier == 1.0 && !reverse_channels){
+        MisalignedStreamConverter::set_passthrough(alignof(float));
+    }
 }
 void AudioStreamToFloat::on_objects(const void* data, size_t objects){
     for (AudioFloatStreamListener* listener : m_listeners){
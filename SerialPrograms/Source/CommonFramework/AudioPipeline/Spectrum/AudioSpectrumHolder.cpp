@@ -91,6 +91,8 @@ AudioSpectrumHolder::AudioSpectrumHolder()
 
     // saveAudioFrequenciesToDisk(true);
 
+    m_spectrums.reserve(m_spectrum_history_length);
+
     m_spectrograph.reset(new Spectrograph(blocks, m_num_freq_windows));
     m_last_spectrum.values.resize(blocks);
     m_last_spectrum.colors.resize(blocks);
@@ -114,10 +116,10 @@ void AudioSpectrumHolder::clear(){
     {
         // update m_spectrum_stamp_start in case the audio widget is used
         // again to store new spectrums.
-        if (m_spectrums.size() > 0){
-            m_spectrum_stamp_start = m_spectrums.front().stamp + 1;
-        }
+        m_spectrum_stamp_start = m_next_stamp;
         m_spectrums.clear();
+        m_pending_visualization.clear();
+        m_dropped_visualization = 0;
 
         m_spectrograph->clear();
         memset(m_last_spectrum.values.data(), 0, m_last_spectrum.values.size() * sizeof(float));
@@ -158,23 +160,69 @@ PA_FORCE_INLINE uint32_t jetColorMap(float v){
 void AudioSpectrumHolder::push_spectrum(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output){
     std::lock_guard<std::mutex> lg(m_state_lock);
 
-    const AlignedVector<float>& output = *fft_output;
+    const uint64_t stamp = m_next_stamp++;
+
+    //  Don't draw anything here. This is the audio thread. Queue it up for
+    //  whoever renders it next.
+    m_pending_visualization.emplace_back(stamp, sample_rate, fft_output);
+    size_t max_pending = m_listeners.empty()
+        ? m_spectrum_history_length
+        : m_num_freq_windows;
+    while (m_pending_visualization.size() > max_pending){
+        m_pending_visualization.pop_front();
+        m_dropped_visualization++;
+    }
 
-    {
-        const size_t stamp = (m_spectrums.size() > 0) ? m_spectrums.front().stamp + 1 : m_spectrum_stamp_start;
-        m_spectrums.emplace_front(stamp, sample_rate, fft_output);
-        if (m_spectrums.size() > m_spectrum_history_length){
-            m_spectrums.pop_back();
+    if (m_saveFreqToDisk){
+        const AlignedVector<float>& output = *fft_output;
+        for(size_t i = 0; i < m_num_freqs; i++){
+            m_freqStream << output[i] << " ";
         }
+        m_freqStream << std::endl;
+    }
+
+    if (m_spectrums.size() < m_spectrum_history_length){
+        m_spectrums.emplace_back(stamp, sample_rate, std::move(fft_output));
+    }else{
+        AudioSpectrum& slot = m_spectrums[(stamp - m_spectrum_stamp_start) % m_spectrum_history_length];
+        slot.stamp = stamp;
+        slot.sample_rate = sample_rate;
+        slot.magnitudes = std::move(fft_output);
+    }
+
+    for (Listener* listener : m_listeners){
+        listener->state_changed();
+    }
+}
+void AudioSpectrumHolder::push_visualization(uint64_t stamp, const uint32_t* colors){
+    m_freqVisStamps[m_nextFFTWindowIndex] = stamp;
+    m_spectrograph->push_spectrum(colors);
+    m_nextFFTWindowIndex = (m_nextFFTWindowIndex+1) % m_num_freq_windows;
+}
+void AudioSpectrumHolder::update_visualization(){
+    if (m_pending_visualization.empty()){
+        return;
+    }
 
-        // std::cout << "Load FFT output , stamp " << spectrum->stamp << std::endl;
-        m_freqVisStamps[m_nextFFTWindowIndex] = stamp;
+    //  Spectrums that were dropped before they were drawn are older than
+    //  everything still pending. Leave their columns blank so the stamps still
+    //  line up with the overlays.
+    size_t dropped = std::min(m_dropped_visualization, m_num_freq_windows);
+    m_dropped_visualization = 0;
+    if (dropped > 0){
+        uint64_t first_stamp = m_pending_visualization.front().stamp;
+        std::vector<uint32_t> blank(m_last_spectrum.colors.size(), combine_rgb(0, 0, 0));
+        for (size_t c = dropped; c > 0; c--){
+            push_visualization(first_stamp - c, blank.data());
+        }
     }
 
-    //  Scale the by the square root of the transform length.
-    //  For random noise input, the frequency domain will have an average
-    //  magnitude of sqrt(transform length).
-    float scale = std::sqrt(0.25f / (float)output.size());
+    for (const AudioSpectrum& spectrum : m_pending_visualization){
+        const AlignedVector<float>& output = *spectrum.magnitudes;
+        //  Scale the by the square root of the transform length.
+        //  For random noise input, the frequency domain will have an average
+        //  magnitude of sqrt(transform length).
+        float scale = std::sqrt(0.25f / (float)output.size());
 
 //    //  Divide by output size. Since samples can never be larger than 1.0, the
 //    //  frequency domain can never be larger than the FFT length. So we scale by
@@ -184,52 +232,41 @@ void AudioSpectrumHolder::push_spectrum(size_t sample_rate, std::shared_ptr<cons
 //    float skew_factor = 999.;
 //    float skew_scale = 1.f / (float)std::log1pf(skew_factor);
 
-    // For one window, use how many blocks to show all frequencies:
-    float previous = 0;
-    for (size_t i = 0; i < m_freq_visualization_block_boundaries.size() - 1; i++){
-        float mag = 0.0f;
-        for(size_t j = m_freq_visualization_block_boundaries[i]; j < m_freq_visualization_block_boundaries[i+1]; j++){
-            mag += output[j];
-        }
+        // For one window, use how many blocks to show all frequencies:
+        float previous = 0;
+        for (size_t i = 0; i < m_freq_visualization_block_boundaries.size() - 1; i++){
+            float mag = 0.0f;
+            for(size_t j = m_freq_visualization_block_boundaries[i]; j < m_freq_visualization_block_boundaries[i+1]; j++){
+                mag += output[j];
+            }
 
-        size_t width = m_freq_visualization_block_boundaries[i+1] - m_freq_visualization_block_boundaries[i];
+            size_t width = m_freq_visualization_block_boundaries[i+1] - m_freq_visualization_block_boundaries[i];
 
-        if (width == 0){
-            mag = previous;
-        }else{
-            mag /= width;
-            mag *= scale;
+            if (width == 0){
+                mag = previous;
+            }else{
+                mag /= width;
+                mag *= scale;
 
-            mag = std::sqrt(mag);
+                mag = std::sqrt(mag);
 //            mag = std::log1pf(mag * skew_factor) * skew_scale;
 //            mag = std::log1pf(std::sqrtf(mag)) * std::log1pf(1);
 //            mag = std::sqrt(2*mag - mag*mag);
 //            float m1 = 1 - mag;
 //            mag = std::sqrtf(1 - m1*m1);
 
-            // Clamp to [0.0, 1.0]
-            mag = std::min(mag, 1.0f);
-            mag = std::max(mag, 0.0f);
-        }
-
-        m_last_spectrum.values[i] = mag;
-        m_last_spectrum.colors[i] = jetColorMap(mag);
-        previous = mag;
-    }
-    m_spectrograph->push_spectrum(m_last_spectrum.colors.data());
-    m_nextFFTWindowIndex = (m_nextFFTWindowIndex+1) % m_num_freq_windows;
-    // std::cout << "Computed FFT! "  << magSum << std::endl;
+                // Clamp to [0.0, 1.0]
+                mag = std::min(mag, 1.0f);
+                mag = std::max(mag, 0.0f);
+            }
 
-    if (m_saveFreqToDisk){
-        for(size_t i = 0; i < m_num_freqs; i++){
-            m_freqStream << output[i] << " ";
+            m_last_spectrum.values[i] = mag;
+            m_last_spectrum.colors[i] = jetColorMap(mag);
+            previous = mag;
         }
-        m_freqStream << std::endl;
-    }
-
-    for (Listener* listener : m_listeners){
-        listener->state_changed();
+        push_visualization(spectrum.stamp, m_last_spectrum.colors.data());
     }
+    m_pending_visualization.clear();
 }
 void AudioSpectrumHolder::add_overlay(uint64_t starting_stamp, uint64_t end_stamp, Color color){
     std::lock_guard<std::mutex> lg(m_state_lock);
@@ -238,10 +275,11 @@ void AudioSpectrumHolder::add_overlay(uint64_t starting_stamp, uint64_t end_stam
 
     // Now try to remove old overlays that are no longer showed on the spectrogram view.
 
-    // get the timestamp of the oldest window in the display history.
-    uint64_t oldestStamp = m_freqVisStamps[m_nextFFTWindowIndex];
-    // SIZE_MAX means this slot is not yet assigned an FFT window
-    if (oldestStamp != SIZE_MAX){
+    // get the timestamp of the oldest window in the display history. Go off the
+    // newest spectrum rather than what has been drawn so far so that this
+    // doesn't grow forever when nothing is rendering the spectrogram.
+    if (!m_spectrums.empty() && m_next_stamp >= m_num_freq_windows){
+        uint64_t oldestStamp = m_next_stamp - m_num_freq_windows;
         // Note: in this file we never consider the case that stamp may overflow.
         // It requires on the order of 1e10 years to overflow if we have about 25ms per stamp.
         while(!m_overlay.empty() && std::get<1>(m_overlay.back()) <= oldestStamp){
@@ -254,41 +292,35 @@ void AudioSpectrumHolder::add_overlay(uint64_t starting_stamp, uint64_t end_stam
     }
 }
 
-std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_since(uint64_t starting_stamp){
-    std::vector<AudioSpectrum> spectrums;
+void AudioSpectrumHolder::spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_stamp){
+    spectrums.clear();
 
     std::lock_guard<std::mutex> lg(m_state_lock);
 
-    for (const auto& ptr : m_spectrums){
-        if (ptr.stamp >= starting_stamp){
-            spectrums.emplace_back(ptr);
-        }else{
-            break;
-        }
+    uint64_t oldest_stamp = m_next_stamp - m_spectrums.size();
+    starting_stamp = std::max(starting_stamp, oldest_stamp);
+    for (uint64_t stamp = m_next_stamp; stamp > starting_stamp; stamp--){
+        spectrums.emplace_back(spectrum_at(stamp - 1));
     }
-    return spectrums;
 }
-std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_latest(size_t num_latest_spectrums){
-    std::vector<AudioSpectrum> spectrums;
+void AudioSpectrumHolder::spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_latest_spectrums){
+    spectrums.clear();
 
     std::lock_guard<std::mutex> lg(m_state_lock);
 
-    size_t i = 0;
-    for (const auto& ptr : m_spectrums){
-        if (i == num_latest_spectrums){
-            break;
-        }
-        spectrums.push_back(ptr);
-        i++;
+    num_latest_spectrums = std::min(num_latest_spectrums, m_spectrums.size());
+    for (size_t c = 1; c <= num_latest_spectrums; c++){
+        spectrums.emplace_back(spectrum_at(m_next_stamp - c));
     }
-    return spectrums;
 }
-AudioSpectrumHolder::SpectrumSnapshot AudioSpectrumHolder::get_last_spectrum() const{
+AudioSpectrumHolder::SpectrumSnapshot AudioSpectrumHolder::get_last_spectrum(){
     std::lock_guard<std::mutex> lg(m_state_lock);
+    update_visualization();
     return m_last_spectrum;
 }
-AudioSpectrumHolder::SpectrographSnapshot AudioSpectrumHolder::get_spectrograph() const{
+AudioSpectrumHolder::SpectrographSnapshot AudioSpectrumHolder::get_spectrograph(){
     std::lock_guard<std::mutex> lg(m_state_lock);
+    update_visualization();
 
     SpectrographSnapshot ret;
     ret.image = m_spectrograph->to_image();
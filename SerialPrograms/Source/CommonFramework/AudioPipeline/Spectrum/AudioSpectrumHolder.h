@@ -8,6 +8,7 @@
 #define PokemonAutomation_AudioPipeline_AudioSpectrumHolder_H
 
 #include <list>
+#include <deque>
 #include <set>
 #include <mutex>
 #include <fstream>
@@ -36,27 +37,34 @@ public:
 
 
 public:
+    //  This is on the audio capture path. It only records the spectrum. The
+    //  visualization is computed later when one of the getters below is
+    //  called.
     void push_spectrum(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output);
     void add_overlay(uint64_t starting_stamp, uint64_t end_stamp, Color color);
 
 
 public:
     //  Asynchronous and thread-safe getters.
+    //
+    //  "get_last_spectrum()" and "get_spectrograph()" first draw the spectrums
+    //  that came in since the last call.
 
-    std::vector<AudioSpectrum> spectrums_since(uint64_t starting_stamp);
-    std::vector<AudioSpectrum> spectrums_latest(size_t num_latest_spectrums);
+    //  These clear "spectrums" and fill it in newest first.
+    void spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_stamp);
+    void spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_latest_spectrums);
 
     struct SpectrumSnapshot{
         std::vector<float> values;
         std::vector<uint32_t> colors;
     };
-    SpectrumSnapshot get_last_spectrum() const;
+    SpectrumSnapshot get_last_spectrum();
 
     struct SpectrographSnapshot{
         ImageRGB32 image;
         std::vector<std::tuple<size_t, size_t, Color>> overlays;
     };
-    SpectrographSnapshot get_spectrograph() const;
+    SpectrographSnapshot get_spectrograph();
 
 
 public:
@@ -65,6 +73,16 @@ public:
     void saveAudioFrequenciesToDisk(bool enable);
 
 
+private:
+    //  Draw the pending spectrums into "m_last_spectrum" and "m_spectrograph".
+    //  Must be called under "m_state_lock".
+    void update_visualization();
+    void push_visualization(uint64_t stamp, const uint32_t* colors);
+
+    const AudioSpectrum& spectrum_at(uint64_t stamp) const{
+        return m_spectrums[(stamp - m_spectrum_stamp_start) % m_spectrum_history_length];
+    }
+
 private:
     // Num frequencies to store for the output of one fft computation.
     const size_t m_num_freqs;
@@ -88,12 +106,22 @@ private:
 
     // record the past FFT output frequencies to serve as the interface
     // of audio inference for automation programs.
-    // The head of the list is the most recent FFT window, while the tail
-    // is the oldest in history.
-    std::list<AudioSpectrum> m_spectrums;
-    size_t m_spectrum_history_length = 40;
+    // This is a ring buffer indexed by stamp. Use spectrum_at() to find a
+    // spectrum. The stamps in it are [m_next_stamp - m_spectrums.size(), m_next_stamp).
+    std::vector<AudioSpectrum> m_spectrums;
+    const size_t m_spectrum_history_length = 40;
     // The initial timestamp for the incoming spectrums.
-    size_t m_spectrum_stamp_start = 0;
+    uint64_t m_spectrum_stamp_start = 0;
+    // The timestamp of the next incoming spectrum.
+    uint64_t m_next_stamp = 0;
+
+    // Spectrums that have not been drawn yet. Oldest first.
+    // With no listeners, nothing gets drawn. So only the spectrums that are
+    // also in "m_spectrums" are kept. Otherwise, only as many as can be shown.
+    std::deque<AudioSpectrum> m_pending_visualization;
+    // # of spectrums before "m_pending_visualization" that were dropped before
+    // they could be drawn. They are drawn as blank columns.
+    size_t m_dropped_visualization = 0;
 
     // Develop purpose: used to save received frequencies to disk
     bool m_saveFreqToDisk = false;
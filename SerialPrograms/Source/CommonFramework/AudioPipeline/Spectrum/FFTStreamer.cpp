@@ -7,6 +7,7 @@
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "Kernels/AbsFFT/Kernels_AbsFFT.h"
+#include "Kernels/AudioStreamConversion/AudioStreamConversion.h"
 #include "CommonFramework/AudioPipeline/AudioConstants.h"
 #include "FFTStreamer.h"
 
@@ -95,9 +96,7 @@ void AudioFloatToFFT::convert(float* fft_input, const float* audio_stream, size_
         memcpy(fft_input, audio_stream, frames * sizeof(float));
         return;
     }
-    for (size_t c = 0; c < frames; c++){
-        fft_input[c] = (audio_stream[2*c + 0] + audio_stream[2*c + 1]) * 0.5f;
-    }
+    Kernels::AudioStreamConversion::convert_audio_stereo_to_mono(fft_input, audio_stream, frames);
 }
 void AudioFloatToFFT::run_fft(){
     float* ptr = m_fft_input.data();
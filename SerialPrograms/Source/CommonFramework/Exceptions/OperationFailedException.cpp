@@ -39,6 +39,9 @@ void OperationFailedException::send_notification(ProgramEnvironment& env, EventN
     if (m_send_error_report == ErrorReport::SEND_ERROR_REPORT && m_screenshot){
         std::string label = name();
         std::string filename = dump_image_alone(env.logger(), env.program_info(), label, *m_screenshot);
+        if (m_video_history){
+            dump_video_history(env.logger(), env.program_info(), label, *m_video_history);
+        }
         send_program_telemetry(
             env.logger(), true, COLOR_RED,
             env.program_info(),
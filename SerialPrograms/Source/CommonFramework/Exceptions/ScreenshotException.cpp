@@ -6,6 +6,7 @@
 
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "CommonFramework/VideoPipeline/VideoHistory.h"
 #include "CommonFramework/Tools/ConsoleHandle.h"
 #include "ScreenshotException.h"
 
@@ -30,6 +31,10 @@ ScreenshotException::ScreenshotException(ErrorReport error_report, ConsoleHandle
         if (m_screenshot == nullptr || !*m_screenshot){
             console.log("Camera returned empty screenshot. Is the camera frozen?", COLOR_RED);
         }
+        VideoHistory* video_history = console.video_history();
+        if (video_history != nullptr){
+            m_video_history = std::make_shared<const VideoHistoryClip>(video_history->clip());
+        }
     }
 }
 void ScreenshotException::attach_screenshot(std::shared_ptr<const ImageRGB32> screenshot){
@@ -14,6 +14,7 @@ namespace PokemonAutomation{
 
 class ImageViewRGB32;
 class ImageRGB32;
+class VideoHistoryClip;
 class EventNotificationOption;
 struct ProgramInfo;
 class ProgramEnvironment;
@@ -48,6 +49,9 @@ public:
     ErrorReport m_send_error_report;
     std::string m_message;
     std::shared_ptr<const ImageRGB32> m_screenshot;
+
+    //  The video leading up to the error. Null if it wasn't being recorded.
+    std::shared_ptr<const VideoHistoryClip> m_video_history;
 };
 
 
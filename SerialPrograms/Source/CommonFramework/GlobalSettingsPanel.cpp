@@ -150,6 +150,15 @@ GlobalSettings::GlobalSettings()
         LockMode::LOCK_WHILE_RUNNING,
         true
     )
+    , ERROR_REPORT_VIDEO_SECONDS(
+        "<b>Error Report Video:</b><br>"
+        "While a program is running, keep this many seconds of low-resolution video in memory. "
+        "When the program fails, save these frames along with the error screenshot. Set to zero to disable.<br>"
+        "<font color=\"red\">This uses up to 64 MB of memory per console. "
+        "Noisy capture cards barely compress, so expect most of that to be used.</font>",
+        LockMode::LOCK_WHILE_RUNNING,
+        0, 0, 60
+    )
 //    , NAUGHTY_MODE_OPTION("<b>Naughty Mode:</b>", false)
     , HIDE_NOTIF_DISCORD_LINK(
         "<b>Hide Discord Link in Notifications:</b><br>"
@@ -174,6 +183,14 @@ GlobalSettings::GlobalSettings()
         "Thread priority of computation threads.",
         DEFAULT_PRIORITY_COMPUTE
     )
+    , BATCH_MULTI_CONSOLE_INFERENCE(
+        "<b>Batch Multi-Console Inference:</b><br>"
+        "In multi-Switch programs, run visual inference for all the consoles on a single thread. "
+        "The same detectors are run on all the consoles back-to-back which is more cache-friendly. "
+        "But the consoles no longer run their inference in parallel, so a slow detector on one console will slow down all of them.",
+        LockMode::LOCK_WHILE_RUNNING,
+        false
+    )
     , AUDIO_FILE_VOLUME_SCALE(
         "<b>Audio File Input Volume Scale:</b><br>"
         "Multiply audio file playback by this factor. (This is linear scale. So each factor of 10 is 20dB.)",
@@ -244,12 +261,14 @@ GlobalSettings::GlobalSettings()
     PA_ADD_STATIC(m_advanced_options);
     PA_ADD_OPTION(LOG_EVERYTHING);
     PA_ADD_OPTION(SAVE_DEBUG_IMAGES);
+    PA_ADD_OPTION(ERROR_REPORT_VIDEO_SECONDS);
 //    PA_ADD_OPTION(NAUGHTY_MODE);
     PA_ADD_OPTION(HIDE_NOTIF_DISCORD_LINK);
 
     PA_ADD_OPTION(REALTIME_THREAD_PRIORITY0);
     PA_ADD_OPTION(INFERENCE_PRIORITY0);
     PA_ADD_OPTION(COMPUTE_PRIORITY0);
+    PA_ADD_OPTION(BATCH_MULTI_CONSOLE_INFERENCE);
 
     PA_ADD_OPTION(AUDIO_FILE_VOLUME_SCALE);
     PA_ADD_OPTION(AUDIO_DEVICE_VOLUME_SCALE);
@@ -97,6 +97,7 @@ public:
 
     BooleanCheckBoxOption LOG_EVERYTHING;
     BooleanCheckBoxOption SAVE_DEBUG_IMAGES;
+    SimpleIntegerOption<uint8_t> ERROR_REPORT_VIDEO_SECONDS;
 //    BooleanCheckBoxOption NAUGHTY_MODE_OPTION;
 
     BooleanCheckBoxOption HIDE_NOTIF_DISCORD_LINK;
@@ -105,6 +106,7 @@ public:
     ThreadPriorityOption REALTIME_THREAD_PRIORITY0;
     ThreadPriorityOption INFERENCE_PRIORITY0;
     ThreadPriorityOption COMPUTE_PRIORITY0;
+    BooleanCheckBoxOption BATCH_MULTI_CONSOLE_INFERENCE;
 
     FloatingPointOption AUDIO_FILE_VOLUME_SCALE;
     FloatingPointOption AUDIO_DEVICE_VOLUME_SCALE;
@@ -180,9 +180,12 @@ PackedBinaryMatrix compress_rgb32_to_binary_multirange(
         ret.set_zero();
         return ret;
     }
-    PackedBinaryMatrix ret = compress_rgb32_to_binary_range(image, filters[0].first, filters[0].second);
-    for (size_t c = 1; c < filters.size(); c++){
-        ret |= compress_rgb32_to_binary_range(image, filters[c].first, filters[c].second);
+
+    //  Filter everything in one pass over the image. Then merge the results.
+    std::vector<PackedBinaryMatrix> matrices = compress_rgb32_to_binary_range(image, filters);
+    PackedBinaryMatrix ret = std::move(matrices[0]);
+    for (size_t c = 1; c < matrices.size(); c++){
+        ret |= matrices[c];
     }
     return ret;
 }
@@ -0,0 +1,104 @@
+/*  Image Integral
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "ImageIntegral.h"
+
+namespace PokemonAutomation{
+
+
+
+//  The squares are 32-bit. (see "pixel_integral()")
+const size_t MAX_INTEGRAL_BOX_PIXELS = 65536;
+
+
+
+ImageIntegral::~ImageIntegral() = default;
+ImageIntegral::ImageIntegral(const ImageViewRGB32& region)
+    : m_region(region)
+{}
+
+bool ImageIntegral::box_sums(Kernels::PixelSums& sums, const ImageViewRGB32& box) const{
+    if (!m_region || !box){
+        return false;
+    }
+    if (box.width() * box.height() > MAX_INTEGRAL_BOX_PIXELS){
+        return false;
+    }
+    if (box.bytes_per_row() != m_region.bytes_per_row()){
+        return false;
+    }
+
+    //  Find where the box is in the region. Pixels left of the region wrap
+    //  around to an "x" that is past its right edge.
+    const char* base = (const char*)m_region.data();
+    const char* ptr = (const char*)box.data();
+    size_t bytes_per_row = m_region.bytes_per_row();
+    if (ptr < base || ptr >= base + bytes_per_row * m_region.height()){
+        return false;
+    }
+    size_t offset = ptr - base;
+    if (offset % sizeof(uint32_t) != 0){
+        return false;
+    }
+    size_t x = offset % bytes_per_row / sizeof(uint32_t);
+    size_t y = offset / bytes_per_row;
+    if (x + box.width() > m_region.width() || y + box.height() > m_region.height()){
+        return false;
+    }
+
+    size_t stride = m_region.width() + 1;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (!m_built){
+            m_table = AlignedVector<Kernels::PixelIntegralEntry>(stride * (m_region.height() + 1));
+            Kernels::pixel_integral(
+                m_table.data(), stride,
+                m_region.width(), m_region.height(),
+                m_region.data(), m_region.bytes_per_row()
+            );
+            m_built = true;
+        }
+    }
+
+    const Kernels::PixelIntegralEntry& a = m_table[y * stride + x];
+    const Kernels::PixelIntegralEntry& b = m_table[y * stride + x + box.width()];
+    const Kernels::PixelIntegralEntry& c = m_table[(y + box.height()) * stride + x];
+    const Kernels::PixelIntegralEntry& d = m_table[(y + box.height()) * stride + x + box.width()];
+
+    sums.count  += (uint32_t)(d.count - b.count - c.count + a.count);
+    sums.sumR   += (uint32_t)(d.sumR - b.sumR - c.sumR + a.sumR);
+    sums.sumG   += (uint32_t)(d.sumG - b.sumG - c.sumG + a.sumG);
+    sums.sumB   += (uint32_t)(d.sumB - b.sumB - c.sumB + a.sumB);
+    sums.sqrR   += (uint32_t)(d.sqrR - b.sqrR - c.sqrR + a.sqrR);
+    sums.sqrG   += (uint32_t)(d.sqrG - b.sqrG - c.sqrG + a.sqrG);
+    sums.sqrB   += (uint32_t)(d.sqrB - b.sqrB - c.sqrB + a.sqrB);
+    return true;
+}
+
+
+
+namespace{
+thread_local const ImageIntegral* current_integral = nullptr;
+}
+
+ImageIntegralScope::ImageIntegralScope(const ImageIntegral* integral)
+    : m_previous(current_integral)
+{
+    if (integral != nullptr){
+        current_integral = integral;
+    }
+}
+ImageIntegralScope::~ImageIntegralScope(){
+    current_integral = m_previous;
+}
+const ImageIntegral* ImageIntegralScope::current(){
+    return current_integral;
+}
+
+
+
+}
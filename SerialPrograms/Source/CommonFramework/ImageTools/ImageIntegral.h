@@ -0,0 +1,75 @@
+/*  Image Integral
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  A summed-area table over part of an image. Once it's built, the stats of
+ *  any box inside that part take constant time instead of a pass over the box.
+ *
+ *  Building it is a pass over the region and the table is 32 bytes per pixel
+ *  of the region. So keep the region tight. It only pays off when the boxes
+ *  that are looked at overlap and add up to more than the region.
+ *
+ *  To use it, put an "ImageIntegralScope" around the code that computes the
+ *  stats. "image_stats()", "image_average()" and "image_stddev()" will then
+ *  use it for any box inside the region.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImageIntegral_H
+#define PokemonAutomation_CommonFramework_ImageIntegral_H
+
+#include <mutex>
+#include "Common/Cpp/Containers/AlignedVector.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelIntegral.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+
+namespace PokemonAutomation{
+
+
+class ImageIntegral{
+public:
+    //  "region" is the part of an image to build the table over. The image
+    //  must outlive this. Nothing is built until the table is first needed.
+    ImageIntegral(const ImageViewRGB32& region);
+    ~ImageIntegral();
+
+    const ImageViewRGB32& region() const{ return m_region; }
+
+    //  If "box" is inside the region and is small enough for the table,
+    //  add its sums to "sums" and return true. Otherwise return false.
+    //  Thread-safe. The table is built on the first call.
+    bool box_sums(Kernels::PixelSums& sums, const ImageViewRGB32& box) const;
+
+
+private:
+    ImageViewRGB32 m_region;
+
+    mutable std::mutex m_lock;
+    mutable bool m_built = false;
+    mutable AlignedVector<Kernels::PixelIntegralEntry> m_table;
+};
+
+
+
+//  While this is alive, the image stats functions on this thread use
+//  "integral" for boxes inside its region. Scopes can be nested.
+//  "integral" can be null, in which case this does nothing.
+class ImageIntegralScope{
+    ImageIntegralScope(const ImageIntegralScope&) = delete;
+    void operator=(const ImageIntegralScope&) = delete;
+public:
+    ImageIntegralScope(const ImageIntegral* integral);
+    ~ImageIntegralScope();
+
+    //  The integral of the innermost scope on this thread, if any.
+    static const ImageIntegral* current();
+
+private:
+    const ImageIntegral* m_previous;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,61 @@
+/*  Image Pyramid
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels/ImageScale/Kernels_ImageScale_Halve.h"
+#include "ImagePyramid.h"
+
+namespace PokemonAutomation{
+
+
+
+ImagePyramid::ImagePyramid(std::shared_ptr<const ImageRGB32> image)
+    : m_image(std::move(image))
+{}
+
+ImageViewRGB32 ImagePyramid::level(size_t level) const{
+    if (!m_image){
+        return ImageViewRGB32();
+    }
+    if (level == 0){
+        return *m_image;
+    }
+    level = std::min(level, LEVELS - 1);
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    while (m_built < level){
+        ImageViewRGB32 previous = m_built == 0 ? ImageViewRGB32(*m_image) : ImageViewRGB32(m_levels[m_built - 1]);
+        if (previous.width() < 2 || previous.height() < 2){
+            return previous;
+        }
+        ImageRGB32 next(previous.width() / 2, previous.height() / 2);
+        Kernels::halve_image(
+            previous.width(), previous.height(),
+            previous.data(), previous.bytes_per_row(),
+            next.data(), next.bytes_per_row()
+        );
+        m_levels[m_built] = std::move(next);
+        m_built++;
+    }
+    return m_levels[level - 1];
+}
+ImageViewRGB32 ImagePyramid::smallest_at_least(size_t min_width, size_t min_height) const{
+    if (!m_image){
+        return ImageViewRGB32();
+    }
+    size_t level = 0;
+    size_t width = m_image->width();
+    size_t height = m_image->height();
+    while (level + 1 < LEVELS && width / 2 >= min_width && height / 2 >= min_height){
+        width /= 2;
+        height /= 2;
+        level++;
+    }
+    return this->level(level);
+}
+
+
+
+}
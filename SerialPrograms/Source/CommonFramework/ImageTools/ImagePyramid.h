@@ -0,0 +1,53 @@
+/*  Image Pyramid
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Copies of an image shrunk to 1/2, 1/4 and 1/8 of the width and height.
+ *  Each level is built from the one before it the first time it is needed.
+ *
+ *  Detectors that only need a coarse look at the screen can use one of the
+ *  smaller levels instead of shrinking the image themselves.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImagePyramid_H
+#define PokemonAutomation_CommonFramework_ImagePyramid_H
+
+#include <memory>
+#include <mutex>
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+
+namespace PokemonAutomation{
+
+
+class ImagePyramid{
+public:
+    //  # of levels including the original image.
+    static constexpr size_t LEVELS = 4;
+
+    ImagePyramid(std::shared_ptr<const ImageRGB32> image);
+
+    const std::shared_ptr<const ImageRGB32>& image() const{ return m_image; }
+
+    //  Level 0 is the original image. Level n is 1/2^n the width and height.
+    //  If the image is too small to shrink that far, this returns the smallest
+    //  level there is.
+    //  Thread-safe. The returned view is valid for the lifetime of the pyramid.
+    ImageViewRGB32 level(size_t level) const;
+
+    //  The smallest level that is at least "min_width" x "min_height".
+    ImageViewRGB32 smallest_at_least(size_t min_width, size_t min_height) const;
+
+
+private:
+    std::shared_ptr<const ImageRGB32> m_image;
+
+    mutable std::mutex m_lock;
+    mutable size_t m_built = 0;
+    mutable ImageRGB32 m_levels[LEVELS - 1];
+};
+
+
+
+}
+#endif
@@ -9,6 +9,7 @@
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "ImageBoxes.h"
+#include "ImageIntegral.h"
 #include "ImageStats.h"
 
 #include <iostream>
@@ -19,13 +20,27 @@ namespace PokemonAutomation{
 
 
 
-FloatPixel image_average(const ImageViewRGB32& image){
-    Kernels::PixelSums sums;
+namespace{
+
+void add_pixel_sums(Kernels::PixelSums& sums, const ImageViewRGB32& image){
+    const ImageIntegral* integral = ImageIntegralScope::current();
+    if (integral != nullptr && integral->box_sums(sums, image)){
+        return;
+    }
     Kernels::pixel_sum_sqr(
         sums, image.width(), image.height(),
         image.data(), image.bytes_per_row(),
         image.data(), image.bytes_per_row()
     );
+}
+
+}
+
+
+
+FloatPixel image_average(const ImageViewRGB32& image){
+    Kernels::PixelSums sums;
+    add_pixel_sums(sums, image);
 
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
 
@@ -33,11 +48,7 @@ FloatPixel image_average(const ImageViewRGB32& image){
 }
 FloatPixel image_stddev(const ImageViewRGB32& image){
     Kernels::PixelSums sums;
-    Kernels::pixel_sum_sqr(
-        sums, image.width(), image.height(),
-        image.data(), image.bytes_per_row(),
-        image.data(), image.bytes_per_row()
-    );
+    add_pixel_sums(sums, image);
 
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
     FloatPixel sqr((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
@@ -52,11 +63,7 @@ FloatPixel image_stddev(const ImageViewRGB32& image){
 }
 ImageStats image_stats(const ImageViewRGB32& image){
     Kernels::PixelSums sums;
-    Kernels::pixel_sum_sqr(
-        sums, image.width(), image.height(),
-        image.data(), image.bytes_per_row(),
-        image.data(), image.bytes_per_row()
-    );
+    add_pixel_sums(sums, image);
 
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
     FloatPixel sqr((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
@@ -111,7 +118,7 @@ ImageStats image_border_stats(const ImageViewRGB32& image){
         sqr_sum += p * p;
     }
     for (size_t r = 0; r < h; r++){
-        FloatPixel p(image.pixel(0, h - 1));
+        FloatPixel p(image.pixel(w - 1, r));
         sum += p;
         sqr_sum += p * p;
     }
@@ -27,11 +27,13 @@ struct ImageStats{
 
 
 //  Pixels with alpha < 128 are ignored.
+//  If there is an "ImageIntegralScope" whose region contains "image", these
+//  take constant time. (see ImageIntegral.h)
 FloatPixel image_average(const ImageViewRGB32& image);
 FloatPixel image_stddev(const ImageViewRGB32& image);
 ImageStats image_stats(const ImageViewRGB32& image);
 
-
+//  Stats of the pixels on the edges of the image.
 ImageStats image_border_stats(const ImageViewRGB32& image);
 
 
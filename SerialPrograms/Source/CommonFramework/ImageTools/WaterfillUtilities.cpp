@@ -6,10 +6,12 @@
 
 #include <map>
 #include "Common/Cpp/Color.h"
+#include "Common/Cpp/Containers/BoxSet.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
-#include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Types.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_FilterRgb32Range.h"
 #include "CommonFramework/ImageMatch/WaterfillTemplateMatcher.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
@@ -22,6 +24,25 @@
 namespace PokemonAutomation{
 
 
+namespace{
+
+//  Whether "box" is the same object as one that was already matched. Different
+//  filters pick up slightly different pixels of the same object. So count it
+//  as the same if at least half of the smaller box overlaps.
+bool is_duplicate_match(const BoxSet<size_t>& matched, const ImagePixelBox& box){
+    bool duplicate = false;
+    matched.for_each_overlapping(box, [&](size_t, const Rectangle<size_t>& existing){
+        size_t smaller = std::min(box.area(), existing.area());
+        if (2 * box.overlapping_area(existing) >= smaller){
+            duplicate = true;
+        }
+    });
+    return duplicate;
+}
+
+}
+
+
 std::pair<PackedBinaryMatrix, size_t> remove_center_pixels(
     const Kernels::Waterfill::WaterfillObject& object,
     size_t num_pixels_to_remove
@@ -88,12 +109,26 @@ bool match_template_by_waterfill(
         }
         std::cout << ")" << std::endl;
     }
-    auto matrices = compress_rgb32_to_binary_range(image, filters);
+    //  The image is filtered and waterfilled in bands of rows. So no bit plane
+    //  of the whole image is built for any of the filters.
+    const size_t min_area = area_thresholds.first;
+    std::vector<std::vector<Kernels::Waterfill::WaterfillObject>> objects = Kernels::Waterfill::find_objects_rgb32_range(
+        image.data(), image.bytes_per_row(),
+        image.width(), image.height(),
+        filters, min_area
+    );
+
+    //  Matches from earlier filters. Matches from the current filter are added
+    //  once the filter is done. Objects from the same filter are never the
+    //  same object even if their boxes overlap.
+    BoxSet<size_t> matched;
+    std::vector<ImagePixelBox> matched_current;
 
     bool detected = false;
     bool stop_match = false;
-    for(PokemonAutomation::PackedBinaryMatrix &matrix : matrices){
+    for (size_t c = 0; c < filters.size(); c++){
         if (PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
+            PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(image, filters[c].first, filters[c].second);
             ImageRGB32 binaryImage = image.copy();
             filter_by_mask(matrix, binaryImage, Color(COLOR_BLACK), true);
             //filter_by_mask(matrix, binaryImage, Color(COLOR_WHITE), true);
@@ -104,13 +139,7 @@ bool match_template_by_waterfill(
                 binaryImage);
         }
 
-        std::unique_ptr<Kernels::Waterfill::WaterfillSession> session = Kernels::Waterfill::make_WaterfillSession();
-        Kernels::Waterfill::WaterfillObject object;
-        const size_t min_area = area_thresholds.first;
-        session->set_source(matrix);
-        auto finder = session->make_iterator(min_area);
-        const bool keep_object_matrix = false;
-        while (finder->find_next(object, keep_object_matrix)){
+        for (Kernels::Waterfill::WaterfillObject& object : objects[c]){
             if (PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
                 std::cout << "------------" << std::endl;
                 std::cout << "Object area: " << object.area << std::endl;
@@ -126,7 +155,16 @@ bool match_template_by_waterfill(
 
             if (rmsd < rmsd_threshold){
                 detected = true;
-                
+
+                ImagePixelBox box(object);
+                if (is_duplicate_match(matched, box)){
+                    if (PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
+                        std::cout << "Already matched by an earlier filter." << std::endl;
+                    }
+                    continue;
+                }
+                matched_current.emplace_back(box);
+
                 if (check_matched_object(object)){
                     stop_match = true;
                     break;
@@ -137,6 +175,8 @@ bool match_template_by_waterfill(
         if (stop_match){
             break;
         }
+        matched.insert(matched_current);
+        matched_current.clear();
     }
     if (PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
         std::cout << "End match template by waterfill" << std::endl;
@@ -53,6 +53,7 @@ std::pair<PackedBinaryMatrix, size_t> remove_center_pixels(
 // rmsd_threshold: RMSD threshold. If RMSD of the waterfill object and template is smaller than this threshold, consider it a match.
 // check_matched_object: if a matcher is found, pass the matched object to this function. If the function returns true, stop the
 //   entire template matching operation.
+//   An object that was already matched by an earlier filter (at least half of the smaller box overlaps) is not passed again.
 bool match_template_by_waterfill(
     const ImageViewRGB32 &image,
     const ImageMatch::WaterfillTemplateMatcher &matcher,
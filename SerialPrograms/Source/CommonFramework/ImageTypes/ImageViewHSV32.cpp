@@ -6,6 +6,8 @@
 
 #include <string.h>
 #include "Common/Cpp/Exceptions.h"
+#include "Kernels/ImageConvert/Kernels_ImageConvert_HSV32.h"
+#include "ImageRGB32.h"
 #include "ImageHSV32.h"
 #include "ImageViewHSV32.h"
 
@@ -34,6 +36,18 @@ ImageHSV32 ImageViewHSV32::copy() const{
     }
     return ret;
 }
+ImageRGB32 ImageViewHSV32::to_rgb32() const{
+    if (m_ptr == nullptr){
+        return ImageRGB32();
+    }
+    ImageRGB32 ret(m_width, m_height);
+    Kernels::convert_hsv32_to_rgb32(
+        m_ptr, m_bytes_per_row,
+        ret.data(), ret.bytes_per_row(),
+        m_width, m_height
+    );
+    return ret;
+}
 
 
 
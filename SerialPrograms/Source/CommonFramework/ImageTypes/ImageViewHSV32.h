@@ -13,6 +13,7 @@
 namespace PokemonAutomation{
 
 
+class ImageRGB32;
 class ImageHSV32;
 
 
@@ -37,6 +38,9 @@ public:
 public:
     ImageHSV32 copy() const;
 
+    //  Convert this image back to RGB32.
+    ImageRGB32 to_rgb32() const;
+
 private:
     ImageViewHSV32(const ImageViewPlanar32& x)
         : ImageViewPlanar32(x)
@@ -37,15 +37,21 @@ void FrozenImageDetector::make_overlays(VideoOverlaySet& set) const{
     set.add(m_color, m_box);
 }
 bool FrozenImageDetector::process_frame(const VideoSnapshot& frame){
-    if (m_previous->width() != frame->width() || m_previous->height() != frame->height()){
-        m_previous = frame;
+    VideoSnapshot current = frame;
+    current.make_pyramid();
+
+    if (m_previous->width() != current->width() || m_previous->height() != current->height()){
+        m_previous = std::move(current);
         return false;
     }
 
-    double rmsd = ImageMatch::pixel_RMSD(m_previous, frame);
+    //  Compare the half-size copies. This reads a quarter of the pixels and a
+    //  frozen screen is just as frozen at that size. "m_previous" keeps its
+    //  pyramid, so each frame is only shrunk once.
+    double rmsd = ImageMatch::pixel_RMSD(m_previous.downscaled(1), current.downscaled(1));
 //    cout << "rmsd = " << rmsd << endl;
     if (rmsd > m_rmsd_threshold){
-        m_previous = frame;
+        m_previous = std::move(current);
         return false;
     }
 
@@ -54,6 +54,9 @@ public:
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override;
 
+    //  The hold duration is measured with the wall clock.
+    virtual bool process_repeated_frames() const override{ return m_last_match; }
+
 private:
     std::chrono::milliseconds m_hold_duration;
 
@@ -0,0 +1,170 @@
+/*  Location Tracker
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "LocationTracker.h"
+
+namespace PokemonAutomation{
+
+
+//  Don't extrapolate the velocity across a gap longer than this. After such
+//  a gap the window is centered on the last known location.
+const double MAX_EXTRAPOLATION_SECONDS = 0.5;
+
+//  The window always extends at least this many object sizes past each side
+//  of the object. This covers locator jitter and an object that starts to
+//  move from rest, as long as it moves less than this much in one frame.
+const double MIN_MARGIN = 0.75;
+
+//  How many frames' worth of recent peak motion the window extends past the
+//  object. The prediction is off by twice the object's motion when it turns
+//  around between two frames. The rest is slack for locator jitter.
+const double MOTION_MARGIN = 2.5;
+
+//  How much of the peak speed is kept on each new detection.
+const double SPEED_DECAY = 0.9;
+
+
+//  Return the time from "start" to "end" in seconds. Return -1 if either
+//  time is unknown.
+static double seconds_between(WallClock start, WallClock end){
+    if (start == WallClock::min() || end == WallClock::min()){
+        return -1;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000000.;
+}
+
+
+
+LocationTracker::LocationTracker(
+    const ImageFloatBox& full_box,
+    double object_width, double object_height,
+    double initial_margin
+)
+    : m_full_box(full_box)
+    , m_object_width(object_width)
+    , m_object_height(object_height)
+    , m_initial_margin(initial_margin)
+{}
+
+void LocationTracker::reset(){
+    m_last_x = -1;
+    m_last_y = -1;
+    m_last_time = WallClock::min();
+    m_has_velocity = false;
+    m_velocity_x = 0;
+    m_velocity_y = 0;
+    m_speed = 0;
+}
+
+
+double LocationTracker::margin(double object_size, double dt) const{
+    if (!m_has_velocity || dt <= 0){
+        return m_initial_margin * object_size;
+    }
+    double ret = std::max(MIN_MARGIN * object_size, MOTION_MARGIN * m_speed * std::min(dt, MAX_EXTRAPOLATION_SECONDS));
+    if (dt > MAX_EXTRAPOLATION_SECONDS){
+        //  The object may have done anything since we last saw it.
+        ret = std::max(ret, m_initial_margin * object_size);
+    }
+    return ret;
+}
+
+
+ImageFloatBox LocationTracker::search_window(WallClock timestamp) const{
+    if (!tracking()){
+        return m_full_box;
+    }
+
+    double x = m_last_x;
+    double y = m_last_y;
+
+    double dt = seconds_between(m_last_time, timestamp);
+    if (m_has_velocity && dt > 0){
+        double extrapolate = std::min(dt, MAX_EXTRAPOLATION_SECONDS);
+        x += m_velocity_x * extrapolate;
+        y += m_velocity_y * extrapolate;
+    }
+
+    double width = m_object_width + 2 * margin(m_object_width, dt);
+    double height = m_object_height + 2 * margin(m_object_height, dt);
+
+    //  Clip the window to the full box.
+    double min_x = std::max(x - width / 2, m_full_box.x);
+    double min_y = std::max(y - height / 2, m_full_box.y);
+    double max_x = std::min(x + width / 2, m_full_box.x + m_full_box.width);
+    double max_y = std::min(y + height / 2, m_full_box.y + m_full_box.height);
+    if (min_x >= max_x || min_y >= max_y){
+        return m_full_box;
+    }
+    return ImageFloatBox(min_x, min_y, max_x - min_x, max_y - min_y);
+}
+
+
+std::pair<double, double> LocationTracker::locate(
+    const ImageViewRGB32& frame, WallClock timestamp,
+    const Locator& locator
+){
+    bool searched_full_box = false;
+    if (tracking()){
+        ImageFloatBox window = search_window(timestamp);
+        std::pair<double, double> location = locator(frame, window);
+        if (location.first >= 0){
+            m_window_hits++;
+            update(location.first, location.second, timestamp);
+            return location;
+        }
+
+        //  A fast object can get a window that covers the whole box. Don't
+        //  search it twice.
+        searched_full_box =
+            window.x <= m_full_box.x && window.y <= m_full_box.y &&
+            window.x + window.width >= m_full_box.x + m_full_box.width &&
+            window.y + window.height >= m_full_box.y + m_full_box.height;
+    }
+
+    m_full_searches++;
+    std::pair<double, double> location(-1, -1);
+    if (!searched_full_box){
+        location = locator(frame, m_full_box);
+    }
+    if (location.first >= 0){
+        update(location.first, location.second, timestamp);
+    }else{
+        reset();
+    }
+    return location;
+}
+
+
+void LocationTracker::update(double x, double y, WallClock timestamp){
+    double dt = seconds_between(m_last_time, timestamp);
+    if (tracking() && dt > 0 && dt <= MAX_EXTRAPOLATION_SECONDS){
+        double velocity_x = (x - m_last_x) / dt;
+        double velocity_y = (y - m_last_y) / dt;
+        m_speed = std::max(std::sqrt(velocity_x * velocity_x + velocity_y * velocity_y), m_speed * SPEED_DECAY);
+        if (m_has_velocity){
+            //  Smooth out the jitter of the locator.
+            velocity_x = 0.5 * (velocity_x + m_velocity_x);
+            velocity_y = 0.5 * (velocity_y + m_velocity_y);
+        }
+        m_velocity_x = velocity_x;
+        m_velocity_y = velocity_y;
+        m_has_velocity = true;
+    }else if (dt != 0){
+        m_has_velocity = false;
+        m_speed = 0;
+    }
+
+    m_last_x = x;
+    m_last_y = y;
+    m_last_time = timestamp;
+}
+
+
+
+}
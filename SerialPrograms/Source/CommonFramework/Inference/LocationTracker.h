@@ -0,0 +1,108 @@
+/*  Location Tracker
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Track a moving object across video frames for a locator.
+ *
+ *  Locators such as hand, arrow and cursor finders search a large box on
+ *  every frame. But between two frames the object only moves a little. This
+ *  class remembers where the object was, predicts where it will be from its
+ *  recent velocity, and has the locator search a window around that point
+ *  first. The full box is only searched when the window misses.
+ *
+ *  The window is sized from how fast the object has actually been moving,
+ *  not from a fixed multiple of its size. A still object gets a window not
+ *  much bigger than itself. A fast one gets a window big enough to catch it
+ *  even if it turns around between two frames.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_LocationTracker_H
+#define PokemonAutomation_CommonFramework_LocationTracker_H
+
+#include <stdint.h>
+#include <utility>
+#include <functional>
+#include "Common/Cpp/Time.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+class ImageViewRGB32;
+
+
+class LocationTracker{
+public:
+    //  Search "area" of "frame" for the object. Return the center of the
+    //  object in screen coordinates [0, 1). Return (-1, -1) if not found.
+    using Locator = std::function<std::pair<double, double>(const ImageViewRGB32& frame, const ImageFloatBox& area)>;
+
+    //  "full_box" is where the object can be. It is searched when there is
+    //  no prediction or when the prediction misses.
+    //
+    //  "object_width" and "object_height" are the size of the object on the
+    //  screen. Until the object's speed is known, the window extends
+    //  "initial_margin" times this size past each side of the object. The
+    //  default of 1.5 gives a window 4 times the object size, the same as
+    //  re-centering a box of that size on every detection.
+    LocationTracker(
+        const ImageFloatBox& full_box,
+        double object_width, double object_height,
+        double initial_margin = 1.5
+    );
+
+    const ImageFloatBox& full_box() const{ return m_full_box; }
+    void set_full_box(const ImageFloatBox& full_box){ m_full_box = full_box; }
+
+    //  Forget the object's history. The next search will use the full box.
+    void reset();
+
+    //  Find the object in "frame", which was taken at "timestamp".
+    std::pair<double, double> locate(
+        const ImageViewRGB32& frame, WallClock timestamp,
+        const Locator& locator
+    );
+
+    //  The box that will be searched first for a frame taken at "timestamp".
+    //  This is the full box if the object is not being tracked.
+    ImageFloatBox search_window(WallClock timestamp) const;
+
+    //  Number of frames where the object was found in the small window and
+    //  number of frames that needed a search of the full box.
+    uint64_t window_hits() const{ return m_window_hits; }
+    uint64_t full_searches() const{ return m_full_searches; }
+
+
+private:
+    bool tracking() const{ return m_last_x >= 0; }
+    void update(double x, double y, WallClock timestamp);
+    double margin(double object_size, double dt) const;
+
+private:
+    ImageFloatBox m_full_box;
+    double m_object_width;
+    double m_object_height;
+    double m_initial_margin;
+
+    double m_last_x = -1;
+    double m_last_y = -1;
+    WallClock m_last_time = WallClock::min();
+
+    //  Velocity in screen units per second.
+    bool m_has_velocity = false;
+    double m_velocity_x = 0;
+    double m_velocity_y = 0;
+
+    //  Recent peak speed in screen units per second. This is the same for
+    //  both axes since the object can turn any way. It decays slowly so one
+    //  slow frame doesn't shrink the window.
+    double m_speed = 0;
+
+    uint64_t m_window_hits = 0;
+    uint64_t m_full_searches = 0;
+};
+
+
+
+}
+#endif
@@ -2,6 +2,7 @@
 
 #include <cfloat>
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 //#include "Common/Cpp/Exceptions.h"
@@ -46,6 +47,28 @@ std::vector<float> buildSpikeKernel(size_t numFrequencies, size_t halfSampleRate
 // }
 
 
+static float dot_product(const float* x, const float* y, size_t length){
+    //  Keep separate partial sums so the compiler can vectorize this.
+    float sum[8] = {};
+    size_t lc = length / 8;
+    while (lc--){
+        for (size_t c = 0; c < 8; c++){
+            sum[c] += x[c] * y[c];
+        }
+        x += 8;
+        y += 8;
+    }
+    float ret = 0.0f;
+    for (size_t c = 0; c < length % 8; c++){
+        ret += x[c] * y[c];
+    }
+    for (size_t c = 0; c < 8; c++){
+        ret += sum[c];
+    }
+    return ret;
+}
+
+
 SpectrogramMatcher::SpectrogramMatcher(
     std::string name,
     AudioTemplate audioTemplate, Mode mode, size_t sample_rate,
@@ -145,6 +168,17 @@ SpectrogramMatcher::SpectrogramMatcher(
 //    cout << "m_numSpectrumsNeeded = " << m_numSpectrumsNeeded << endl;
 
     m_templateNorm = buildTemplateNorm();
+
+    // match_sub_template() matches the first `m_numSpectrumsNeeded` template
+    // windows for every sub-template. The running correlations do the same.
+    for (size_t i = 0; i < m_numSpectrumsNeeded; i++){
+        const float* templateData = m_template.getWindow(i);
+        for (size_t j = m_freqStart; j < m_freqEnd; j++){
+            m_templateSumSqr += (double)templateData[j] * templateData[j];
+        }
+    }
+    m_correlations.resize(m_numSpectrumsNeeded);
+    m_correlationCounts.resize(m_numSpectrumsNeeded);
 }
 
 uint64_t SpectrogramMatcher::latestTimestamp() const{
@@ -194,7 +228,48 @@ std::vector<float> SpectrogramMatcher::buildTemplateNorm() const{
     return ret;
 }
 
-bool SpectrogramMatcher::update_to_new_spectrum(AudioSpectrum spectrum){
+void SpectrogramMatcher::reset_correlations(){
+    std::fill(m_correlations.begin(), m_correlations.end(), 0.0);
+    std::fill(m_correlationCounts.begin(), m_correlationCounts.end(), 0);
+    m_latestCorrelation = 0;
+    m_latestCorrelationValid = false;
+}
+
+void SpectrogramMatcher::update_correlations(const AudioSpectrum& spectrum, bool correlate){
+    const size_t windows = m_numSpectrumsNeeded;
+    if (windows == 0){
+        return;
+    }
+
+    // The ring only makes sense on a continuous stream.
+    if (!m_spectrums.empty() && m_spectrums.front().stamp + 1 != spectrum.stamp){
+        reset_correlations();
+    }
+
+    if (correlate){
+        const size_t freqs = m_freqEnd - m_freqStart;
+        const float* streamData = m_freqStart + spectrum.magnitudes->data();
+        for (size_t i = 0; i < windows; i++){
+            // In the alignment that ends i spectrums from now, this spectrum
+            // is matched against template window (windows - 1 - i).
+            const size_t slot = (spectrum.stamp + i) % windows;
+            m_correlations[slot] += dot_product(
+                streamData, m_freqStart + m_template.getWindow(windows - 1 - i), freqs
+            );
+            m_correlationCounts[slot]++;
+        }
+    }
+
+    // The alignment ending on this spectrum won't get any more contributions.
+    // Take it out and free the slot for the alignment that ends `windows` spectrums later.
+    const size_t slot = spectrum.stamp % windows;
+    m_latestCorrelation = m_correlations[slot];
+    m_latestCorrelationValid = m_correlationCounts[slot] == windows;
+    m_correlations[slot] = 0;
+    m_correlationCounts[slot] = 0;
+}
+
+bool SpectrogramMatcher::update_to_new_spectrum(AudioSpectrum spectrum, bool correlate){
     if (m_numOriginalFrequencies != spectrum.magnitudes->size()){
         std::cout << "Error: number of frequencies don't match in SpectrogramMatcher::match() " << 
             m_numOriginalFrequencies << " " << spectrum.magnitudes->size() << std::endl;
@@ -237,14 +312,16 @@ bool SpectrogramMatcher::update_to_new_spectrum(AudioSpectrum spectrum){
     }
     m_spectrumNormSqrs.push_front(spectrumNormSqr);
 
+    update_correlations(spectrum, correlate);
+
     m_spectrums.emplace_front(std::move(spectrum));
 
     return true;
 }
 
-bool SpectrogramMatcher::update_to_new_spectrums(const std::vector<AudioSpectrum>& new_spectrums){
+bool SpectrogramMatcher::update_to_new_spectrums(const std::vector<AudioSpectrum>& new_spectrums, bool correlate){
     for (auto it = new_spectrums.rbegin(); it != new_spectrums.rend(); it++){
-        if(!update_to_new_spectrum(*it)){
+        if(!update_to_new_spectrum(*it, correlate)){
             return false;
         }
     }
@@ -332,8 +409,29 @@ std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index)
     return std::make_pair(score, scale);
 }
 
+std::pair<float, float> SpectrogramMatcher::match_incremental() const{
+    // Same math as match_sub_template(), but with the sums already known:
+    //   |s A - T|^2 = s^2 |A|^2 - 2 s (A . T) + |T|^2
+    double streamSumSqr = 0;
+    for (float normSqr : m_spectrumNormSqrs){
+        streamSumSqr += normSqr;
+    }
+
+    //  Same guard as the full computation. Digital silence would be 0/0.
+    float scale = (streamSumSqr < 1e-6 ? 1.0f : (float)(m_latestCorrelation / streamSumSqr));
+    scale = std::min<float>(scale, 1000000);
+
+    double sum = (double)scale * scale * streamSumSqr - 2.0 * scale * m_latestCorrelation + m_templateSumSqr;
+    sum = std::max(sum, 0.0);
+
+    float score = (float)std::sqrt(sum) / m_templateNorm[0];
+    score = std::min<float>(score, 1.0);
+
+    return std::make_pair(score, scale);
+}
+
 float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums){
-    if (!update_to_new_spectrums(new_spectrums)){
+    if (!update_to_new_spectrums(new_spectrums, true)){
         return FLT_MAX;
     }
 
@@ -364,7 +462,11 @@ float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums)
     
     // Do the match:
     float score = FLT_MAX; // the lower the score, the better the match
-    if (m_templateRange.size() == 1){
+    if (m_latestCorrelationValid){
+        // All sub-templates are matched against the same windows. (see match_sub_template())
+        // So one match covers all of them.
+        std::tie(score, m_lastScale) = match_incremental();
+    }else if (m_templateRange.size() == 1){
         // Match the full template
         std::tie(score, m_lastScale) = match_sub_template(0);
     }else{
@@ -389,12 +491,15 @@ bool SpectrogramMatcher::skip(const std::vector<AudioSpectrum>& new_spectrums){
     // Since the computation is relatively small and we won't be skipping lots of frames anyway,
     // this should be fine for now.
     // We can improve this later.
-    return update_to_new_spectrums(new_spectrums);
+    // The running correlations are not updated here. So the next few matches
+    // after a skip will use the full computation.
+    return update_to_new_spectrums(new_spectrums, false);
 }
 
 void SpectrogramMatcher::clear(){
     m_spectrums.clear();
     m_spectrumNormSqrs.clear();
+    reset_correlations();
     m_lastStampTested = SIZE_MAX;
 }
 
@@ -86,13 +86,25 @@ private:
     // For a given sub-template, return its match score and scaling factor
     std::pair<float, float> match_sub_template(size_t sub_index) const;
 
+    // Compute the score and scale of the latest windows from the running
+    // correlations instead of going through all the windows again.
+    // Only valid when `m_latestCorrelationValid` is true.
+    std::pair<float, float> match_incremental() const;
+
+    // Add the contributions of a new (already filtered) spectrum to the running
+    // correlations. Called by `update_to_new_spectrum()`.
+    void update_correlations(const AudioSpectrum& spectrum, bool correlate);
+    void reset_correlations();
+
     // Update internal data for the next new spectrum. Called by `update_to_new_spectrums()`.
+    // If `correlate` is false, the running correlations are not updated and the
+    // next few matches will fall back to the full computation.
     // Return true if there is no error.
-    bool update_to_new_spectrum(AudioSpectrum newSpectrum);
+    bool update_to_new_spectrum(AudioSpectrum newSpectrum, bool correlate);
 
     // Update internal data for the new specttrums.
     // Return true if there is no error.
-    bool update_to_new_spectrums(const std::vector<AudioSpectrum>& new_spectrums);
+    bool update_to_new_spectrums(const std::vector<AudioSpectrum>& new_spectrums, bool correlate);
 
 
 
@@ -125,6 +137,24 @@ private:
     // How many spectrums needed to store.
     size_t m_numSpectrumsNeeded = 0;
 
+    // Running correlations between the stream and the template.
+    //
+    // Each new spectrum is dotted with every template window once. The dot
+    // product with template window k is added to the correlation of the
+    // alignment that will end (numMatchedWindows() - 1 - k) spectrums later.
+    // So when a spectrum arrives, the correlation of the alignment ending on
+    // it is complete and the match score can be computed in closed form.
+    //
+    // This is a ring indexed by (ending timestamp % m_numSpectrumsNeeded).
+    std::vector<double> m_correlations;
+    // How many spectrums have contributed to each entry of `m_correlations`.
+    std::vector<size_t> m_correlationCounts;
+    // The complete correlation of the latest `m_numSpectrumsNeeded` spectrums.
+    double m_latestCorrelation = 0;
+    bool m_latestCorrelationValid = false;
+    // Sum squares of the template windows that are matched against.
+    double m_templateSumSqr = 0;
+
     size_t m_lastStampTested = SIZE_MAX;
     float m_lastScale = 0.0f;
 };
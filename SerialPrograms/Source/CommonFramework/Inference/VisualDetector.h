@@ -113,6 +113,17 @@ public:
     //  whether it is consecutively detected , or consecutively not detected.
     bool consistent_result() const { return m_consistent_result; }
 
+    //  Waiting for the detection to last long enough.
+    virtual bool close_to_triggering() const override{
+        return m_finder_type != FinderType::CONSISTENT && m_start_of_detection != WallClock::min();
+    }
+
+    //  A finder that waits a second or more for the detection to hold can
+    //  afford to notice it a little late.
+    virtual bool allow_backoff() const override{
+        return m_duration >= std::chrono::milliseconds(1000);
+    }
+
 private:
     std::chrono::milliseconds m_duration;
     FinderType m_finder_type;
@@ -24,6 +24,9 @@ struct AudioInferencePivot::PeriodicCallback{
 
     uint64_t last_seqnum = ~(uint64_t)0;
 
+    //  Reused every time this callback runs.
+    std::vector<AudioSpectrum> spectrums;
+
     StatAccumulatorI32 stats;
 
     PeriodicCallback(
@@ -87,25 +90,36 @@ StatAccumulatorI32 AudioInferencePivot::remove_callback(AudioInferenceCallback&
 void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
-        std::vector<AudioSpectrum> spectrums;
+        std::vector<AudioSpectrum>& spectrums = callback.spectrums;
 
         if (callback.last_seqnum == ~(uint64_t)0){
 //            cout << "m_last_timestamp == SIZE_MAX" << endl;
-            spectrums = m_feed.spectrums_latest(1);
+            m_feed.load_spectrums_latest(spectrums, 1);
         }else{
 //            cout << "(m_last_timestamp != SIZE_MAX" << endl;
             //  Note: in this file we never consider the case that stamp may overflow.
             //  It requires on the order of 1e10 years to overflow if we have about 25ms per stamp.
-            spectrums = m_feed.spectrums_since(callback.last_seqnum + 1);
+            m_feed.load_spectrums_since(spectrums, callback.last_seqnum + 1);
         }
         if (spectrums.size() > 0){
             //  spectrums[0] has the newest spectrum with the largest stamp:
             callback.last_seqnum = spectrums[0].stamp;
         }
+        const bool still = spectrums.empty();
 
         WallClock time0 = current_time();
         bool stop = callback.callback.process_spectrums(spectrums, m_feed);
         WallClock time1 = current_time();
+
+        //  Keep the capacity, but don't hold onto the spectrums until next time.
+        spectrums.clear();
+
+        //  Back off while the audio isn't coming in.
+        if (callback.callback.close_to_triggering()){
+            report(event, PeriodicActivity::URGENT, callback.callback.allow_backoff());
+        }else{
+            report(event, still ? PeriodicActivity::STILL : PeriodicActivity::ACTIVE, callback.callback.allow_backoff());
+        }
         callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
         if (stop){
             if (callback.set_when_triggered){
@@ -32,6 +32,15 @@ public:
     // Name of the inference object.
     const std::string& label() const{ return m_label; }
 
+    // Return true if this callback has seen something and may be about to
+    // trigger. The inference pivots will then run it more often.
+    virtual bool close_to_triggering() const{ return false; }
+
+    // Return true if this callback can be run less often than its requested
+    // period when nothing is changing or when the inference pivot is falling
+    // behind. This adds latency, so only coarse callbacks should allow it.
+    virtual bool allow_backoff() const{ return false; }
+
 
 protected:
     InferenceCallback(InferenceType type, std::string label)
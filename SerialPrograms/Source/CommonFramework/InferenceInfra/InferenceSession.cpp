@@ -43,6 +43,7 @@ InferenceSession::InferenceSession(
                 VisualInferenceCallback& visual_callback = static_cast<VisualInferenceCallback&>(*callback);
                 console.video_inference_pivot().add_callback(
                     scope, &m_triggered,
+                    console.video(),
                     visual_callback,
                     default_video_period
                 );
@@ -88,6 +89,7 @@ InferenceSession::InferenceSession(
                 VisualInferenceCallback& visual_callback = static_cast<VisualInferenceCallback&>(*callback.callback);
                 console.video_inference_pivot().add_callback(
                     scope, &m_triggered,
+                    console.video(),
                     visual_callback,
                     callback.period > std::chrono::milliseconds(0) ? callback.period : default_video_period
                 );
@@ -17,6 +17,7 @@ namespace PokemonAutomation{
 
 class ImageViewRGB32;
 class ImageRGB32;
+struct ImageFloatBox;
 struct VideoSnapshot;
 class VideoOverlaySet;
 
@@ -39,6 +40,19 @@ public:
     //  You must override at least one of the overloaded `process_frame()`.
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp);
 
+    //  Inference routines skip this callback if the video source has not
+    //  delivered a new frame since the last time it was run. Return true to be
+    //  run on the same frame again. (e.g. if this is timing something with the
+    //  wall clock instead of the frame timestamps)
+    virtual bool process_repeated_frames() const{ return false; }
+
+    //  If this callback computes the stats of many overlapping boxes in each
+    //  frame, set "region" to the part of the frame they are in and return
+    //  true. Inference routines will then give it a summed-area table of that
+    //  region so that "image_stats()" on those boxes is constant time.
+    //  (see ImageIntegral.h)
+    virtual bool integral_image_region(ImageFloatBox& region) const{ return false; }
+
 };
 
 
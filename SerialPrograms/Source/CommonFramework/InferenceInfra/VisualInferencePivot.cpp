@@ -4,7 +4,11 @@
  *
  */
 
+#include <stdlib.h>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/ImageTools/ImageIntegral.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "VisualInferencePivot.h"
 
@@ -16,33 +20,108 @@ namespace PokemonAutomation{
 
 
 
+namespace{
+
+//  How often the share of skipped callbacks is updated.
+const std::chrono::seconds SKIP_STATS_WINDOW(1);
+
+//  A sparse grid of pixels used to tell if the screen is moving.
+const size_t MOTION_GRID_WIDTH = 32;
+const size_t MOTION_GRID_HEIGHT = 18;
+const int MOTION_TOLERANCE = 16;
+
+void sample_motion_grid(std::vector<uint32_t>& grid, const ImageViewRGB32& image){
+    grid.clear();
+    if (!image){
+        return;
+    }
+    for (size_t r = 0; r < MOTION_GRID_HEIGHT; r++){
+        size_t y = (2*r + 1) * image.height() / (2*MOTION_GRID_HEIGHT);
+        for (size_t c = 0; c < MOTION_GRID_WIDTH; c++){
+            size_t x = (2*c + 1) * image.width() / (2*MOTION_GRID_WIDTH);
+            grid.emplace_back(image.pixel(x, y));
+        }
+    }
+}
+bool motion_grid_matches(const std::vector<uint32_t>& x, const std::vector<uint32_t>& y){
+    if (x.size() != y.size()){
+        return false;
+    }
+    for (size_t c = 0; c < x.size(); c++){
+        for (size_t s = 0; s < 32; s += 8){
+            int a = (x[c] >> s) & 0xff;
+            int b = (y[c] >> s) & 0xff;
+            if (std::abs(a - b) > MOTION_TOLERANCE){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}
+
+
+
+struct VisualInferencePivot::FeedState{
+    VideoFeed& feed;
+    size_t references = 0;
+
+    //  The most recent snapshot of this feed and when it was taken.
+    VideoSnapshot last;
+    uint64_t seqnum = 0;
+    uint64_t tick = 0;
+
+    //  Incremented whenever the screen moves away from "motion_reference".
+    //  Slow drifts are caught since this is not the previous snapshot.
+    std::vector<uint32_t> motion_grid;
+    std::vector<uint32_t> motion_reference;
+    uint64_t motion_seqnum = 0;
+
+    FeedState(VideoFeed& p_feed)
+        : feed(p_feed)
+    {}
+};
+
 struct VisualInferencePivot::PeriodicCallback{
     Cancellable& scope;
     std::atomic<InferenceCallback*>* set_when_triggered;
+    FeedState& feed;
     VisualInferenceCallback& callback;
-    std::chrono::milliseconds period;
+    BatchKey batch;
     StatAccumulatorI32 stats;
     uint64_t last_seqnum;
+    uint64_t last_motion_seqnum;
+    uint64_t last_frame_seqnum;
 
     PeriodicCallback(
         Cancellable& p_scope,
         std::atomic<InferenceCallback*>* p_set_when_triggered,
+        FeedState& p_feed,
         VisualInferenceCallback& p_callback,
-        std::chrono::milliseconds p_period
+        BatchKey p_batch
     )
         : scope(p_scope)
         , set_when_triggered(p_set_when_triggered)
+        , feed(p_feed)
         , callback(p_callback)
-        , period(p_period)
+        , batch(p_batch)
         , last_seqnum(0)
+        , last_motion_seqnum(~(uint64_t)0)
+        , last_frame_seqnum(0)
     {}
 };
 
+struct VisualInferencePivot::CallbackBatch{
+    std::vector<PeriodicCallback*> callbacks;
+};
+
 
 
-VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher)
+VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, AsyncDispatcher& dispatcher)
     : PeriodicRunner(dispatcher)
-    , m_feed(feed)
+    , m_window_start(current_time())
+    , m_skipped_percent(-1)
 {
     attach(scope);
 }
@@ -53,23 +132,58 @@ VisualInferencePivot::~VisualInferencePivot(){
 void VisualInferencePivot::add_callback(
     Cancellable& scope,
     std::atomic<InferenceCallback*>* set_when_triggered,
+    VideoFeed& feed,
     VisualInferenceCallback& callback,
     std::chrono::milliseconds period
 ){
     WriteSpinLock lg(m_lock);
-    auto iter = m_map.find(&callback);
-    if (iter != m_map.end()){
+    if (m_map.find(&callback) != m_map.end()){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Attempted to add the same callback twice.");
     }
-    iter = m_map.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(&callback),
-        std::forward_as_tuple(scope, set_when_triggered, callback, period)
-    ).first;
+
+    BatchKey key(std::type_index(typeid(callback)), period.count());
+    CallbackBatch* new_batch = nullptr;
+    {
+        std::lock_guard<std::mutex> lg1(m_batch_lock);
+        auto feed_iter = m_feeds.try_emplace(&feed, feed).first;
+        auto batch_iter = m_batches.find(key);
+        if (batch_iter == m_batches.end()){
+            batch_iter = m_batches.emplace(key, CallbackBatch()).first;
+            new_batch = &batch_iter->second;
+        }
+        try{
+            auto iter = m_map.emplace(
+                std::piecewise_construct,
+                std::forward_as_tuple(&callback),
+                std::forward_as_tuple(scope, set_when_triggered, feed_iter->second, callback, key)
+            ).first;
+            batch_iter->second.callbacks.emplace_back(&iter->second);
+        }catch (...){
+            m_map.erase(&callback);
+            if (new_batch != nullptr){
+                m_batches.erase(batch_iter);
+            }
+            if (feed_iter->second.references == 0){
+                m_feeds.erase(feed_iter);
+            }
+            throw;
+        }
+        feed_iter->second.references++;
+    }
+
+    if (new_batch == nullptr){
+        return;
+    }
     try{
-        PeriodicRunner::add_event(&iter->second, period);
+        PeriodicRunner::add_event(new_batch, period);
     }catch (...){
-        m_map.erase(iter);
+        std::lock_guard<std::mutex> lg1(m_batch_lock);
+        auto feed_iter = m_feeds.find(&feed);
+        if (--feed_iter->second.references == 0){
+            m_feeds.erase(feed_iter);
+        }
+        m_batches.erase(key);
+        m_map.erase(&callback);
         throw;
     }
 }
@@ -79,41 +193,145 @@ StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback
     if (iter == m_map.end()){
         return StatAccumulatorI32();
     }
-    StatAccumulatorI32 stats = iter->second.stats;
-    PeriodicRunner::remove_event(&iter->second);
+    PeriodicCallback& entry = iter->second;
+    auto batch_iter = m_batches.find(entry.batch);
+
+    //  Once it is out of the batch, the runner will no longer touch it.
+    bool batch_empty;
+    {
+        std::lock_guard<std::mutex> lg1(m_batch_lock);
+        std::vector<PeriodicCallback*>& callbacks = batch_iter->second.callbacks;
+        callbacks.erase(std::find(callbacks.begin(), callbacks.end(), &entry));
+        batch_empty = callbacks.empty();
+    }
+    if (batch_empty){
+        PeriodicRunner::remove_event(&batch_iter->second);
+    }
+
+    StatAccumulatorI32 stats = entry.stats;
+
+    std::lock_guard<std::mutex> lg1(m_batch_lock);
+    if (batch_empty){
+        m_batches.erase(batch_iter);
+    }
+    auto feed_iter = m_feeds.find(&entry.feed.feed);
+    if (--feed_iter->second.references == 0){
+        m_feeds.erase(feed_iter);
+    }
     m_map.erase(iter);
     return stats;
 }
 void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
-    PeriodicCallback& callback = *(PeriodicCallback*)event;
-    try{
-        //  Reuse the cached screenshot.
-        if (!is_back_to_back || callback.last_seqnum == m_seqnum){
-//            cout << "back-to-back" << endl;
-            m_last = m_feed.snapshot();
-            m_seqnum++;
-        }
+    CallbackBatch& batch = *(CallbackBatch*)event;
+    if (!is_back_to_back){
+        m_tick++;
+    }
+
+    std::lock_guard<std::mutex> lg(m_batch_lock);
+    PeriodicActivity activity = PeriodicActivity::STILL;
+    bool allow_backoff = true;
+    for (PeriodicCallback* item : batch.callbacks){
+        PeriodicCallback& callback = *item;
+        FeedState& feed = callback.feed;
+        allow_backoff &= callback.callback.allow_backoff();
+        try{
+            //  Reuse the cached screenshot unless we've been idle since it was
+            //  taken or this callback has already seen it.
+            if (feed.tick != m_tick || callback.last_seqnum == feed.seqnum){
+//                cout << "back-to-back" << endl;
+                //  Don't bother with a new snapshot if the source hasn't
+                //  delivered a new frame since the last one.
+                uint64_t frame_seqnum = feed.feed.frame_seqnum();
+                if (frame_seqnum == 0 || frame_seqnum != feed.last.seqnum){
+                    feed.last = feed.feed.snapshot();
+                    sample_motion_grid(feed.motion_grid, feed.last ? ImageViewRGB32(feed.last) : ImageViewRGB32());
+                    if (!motion_grid_matches(feed.motion_grid, feed.motion_reference)){
+                        std::swap(feed.motion_grid, feed.motion_reference);
+                        feed.motion_seqnum++;
+                    }
+                }
+                feed.seqnum++;
+                feed.tick = m_tick;
+            }
+            if (callback.last_motion_seqnum != feed.motion_seqnum){
+                callback.last_motion_seqnum = feed.motion_seqnum;
+                activity = std::max(activity, PeriodicActivity::ACTIVE);
+            }
 
-        WallClock time0 = current_time();
-        bool stop = callback.callback.process_frame(m_last);
-        WallClock time1 = current_time();
-        callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
-        callback.last_seqnum = m_seqnum;
-        if (stop){
-            if (callback.set_when_triggered){
-                InferenceCallback* expected = nullptr;
-                callback.set_when_triggered->compare_exchange_strong(expected, &callback.callback);
+            //  This callback has already seen this frame.
+            if (feed.last.seqnum != 0 &&
+                feed.last.seqnum == callback.last_frame_seqnum &&
+                !callback.callback.process_repeated_frames()
+            ){
+                callback.last_seqnum = feed.seqnum;
+                if (callback.callback.close_to_triggering()){
+                    activity = PeriodicActivity::URGENT;
+                }
+                m_window_skipped++;
+                continue;
+            }
+
+            WallClock time0 = current_time();
+            bool stop;
+            {
+                ImageFloatBox region;
+                std::unique_ptr<ImageIntegral> integral;
+                //  The snapshot is empty if the camera has no frame.
+                if (feed.last && callback.callback.integral_image_region(region)){
+                    integral = std::make_unique<ImageIntegral>(extract_box_reference(*feed.last.frame, region));
+                }
+                ImageIntegralScope scope(integral.get());
+                stop = callback.callback.process_frame(feed.last);
+            }
+            WallClock time1 = current_time();
+            callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+            callback.last_seqnum = feed.seqnum;
+            callback.last_frame_seqnum = feed.last.seqnum;
+            m_window_evaluated++;
+            if (callback.callback.close_to_triggering()){
+                activity = PeriodicActivity::URGENT;
             }
-            callback.scope.cancel(nullptr);
+            if (stop){
+                if (callback.set_when_triggered){
+                    InferenceCallback* expected = nullptr;
+                    callback.set_when_triggered->compare_exchange_strong(expected, &callback.callback);
+                }
+                callback.scope.cancel(nullptr);
+            }
+        }catch (...){
+            callback.scope.cancel(std::current_exception());
         }
-    }catch (...){
-        callback.scope.cancel(std::current_exception());
+    }
+
+    //  Back off if nothing has moved for any callback in the batch and they
+    //  all allow it.
+    report(event, activity, allow_backoff);
+
+    //  Publish the share of skipped callbacks from here so that the overlay
+    //  only needs to read it.
+    WallClock now = current_time();
+    if (now - m_window_start >= SKIP_STATS_WINDOW){
+        uint64_t total = m_window_evaluated + m_window_skipped;
+        m_skipped_percent.store(
+            total == 0 ? -1 : (int)((m_window_skipped * 100 + total / 2) / total),
+            std::memory_order_relaxed
+        );
+        m_window_start = now;
+        m_window_evaluated = 0;
+        m_window_skipped = 0;
     }
 }
 
 
 OverlayStatSnapshot VisualInferencePivot::get_current(){
-    return m_printer.get_snapshot("Video Pivot Utilization:", this->current_utilization());
+    OverlayStatSnapshot ret = m_printer.get_snapshot("Video Pivot Utilization:", this->current_utilization());
+
+    //  Share of the callbacks that were skipped on a repeated frame.
+    int skipped_percent = m_skipped_percent.load(std::memory_order_relaxed);
+    if (!ret.text.empty() && skipped_percent >= 0){
+        ret.text += ", Skipped: " + std::to_string(skipped_percent) + " %";
+    }
+    return ret;
 }
 
 
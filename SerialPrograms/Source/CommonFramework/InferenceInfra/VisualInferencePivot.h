@@ -7,6 +7,9 @@
 #ifndef PokemonAutomation_CommonFramework_VisualInferencePivot_H
 #define PokemonAutomation_CommonFramework_VisualInferencePivot_H
 
+#include <atomic>
+#include <mutex>
+#include <typeindex>
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Cpp/Concurrency/PeriodicScheduler.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
@@ -20,9 +23,28 @@ class VideoFeed;
 
 
 
+//
+//  Runs visual inference callbacks periodically on a single thread.
+//
+//  A pivot may be shared by multiple consoles. Each callback is attached to
+//  the feed it should run on.
+//
+//  Callbacks of the same type and period are batched together. When a batch
+//  is due, each feed is snapshotted at most once and every callback in the
+//  batch is run back-to-back. When the pivot is shared by multiple consoles,
+//  this runs the same detector over all the consoles at once so that its
+//  templates and lookup tables stay in cache.
+//
+//  Batches are run less often while none of their feeds are changing if all
+//  their callbacks allow it. (see InferenceCallback::allow_backoff()) They are
+//  run more often while any of their callbacks are close to triggering.
+//
+//  A callback is skipped if its feed has not delivered a new frame since the
+//  last time it ran. (see VisualInferenceCallback::process_repeated_frames())
+//
 class VisualInferencePivot final : public PeriodicRunner, public OverlayStat{
 public:
-    VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher);
+    VisualInferencePivot(CancellableScope& scope, AsyncDispatcher& dispatcher);
     virtual ~VisualInferencePivot();
 
     //  If this callback returns true:
@@ -32,6 +54,7 @@ public:
     void add_callback(
         Cancellable& scope,
         std::atomic<InferenceCallback*>* set_when_triggered,
+        VideoFeed& feed,
         VisualInferenceCallback& callback,
         std::chrono::milliseconds period
     );
@@ -44,13 +67,34 @@ private:
     virtual OverlayStatSnapshot get_current() override;
 
 private:
+    struct FeedState;
     struct PeriodicCallback;
+    struct CallbackBatch;
+    using BatchKey = std::pair<std::type_index, std::chrono::milliseconds::rep>;
 
-    VideoFeed& m_feed;
+    //  Serializes add/remove.
     SpinLock m_lock;
+
+    //  Protects the batch membership. Held by the runner thread for the
+    //  duration of each batch. Always acquired after the runner lock.
+    std::mutex m_batch_lock;
+
+    std::map<VideoFeed*, FeedState> m_feeds;
     std::map<VisualInferenceCallback*, PeriodicCallback> m_map;
-    VideoSnapshot m_last;
-    uint64_t m_seqnum = 0;
+    std::map<BatchKey, CallbackBatch> m_batches;
+
+    //  Incremented every time the runner wakes up from idle.
+    uint64_t m_tick = 0;
+
+    //  # of callbacks run and skipped on a repeated frame in the current
+    //  window. Only touched by the runner thread.
+    WallClock m_window_start;
+    uint64_t m_window_evaluated = 0;
+    uint64_t m_window_skipped = 0;
+
+    //  % of callbacks skipped in the last full window. Negative if none ran.
+    //  Written by the runner thread at the end of each window.
+    std::atomic<int> m_skipped_percent;
 
     OverlayStatUtilizationPrinter m_printer;
 };
@@ -6,7 +6,9 @@
 
 #include <QDir>
 #include <QFile>
+#include <QBuffer>
 #include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 #include "CommonFramework/Globals.h"
 #include "MessageAttachment.h"
 
@@ -23,11 +25,35 @@ ImageAttachment::ImageAttachment(
     , mode(p_mode)
     , keep_file(p_keep_file)
 {}
+ImageAttachment::ImageAttachment(
+    std::shared_ptr<const ImageRGB32> p_image,
+    ImageAttachmentMode p_mode,
+    bool p_keep_file
+)
+    : mode(p_mode)
+    , keep_file(p_keep_file)
+    , owner(std::move(p_image))
+{
+    if (owner){
+        image = *owner;
+    }
+}
+
+
+
+//  Screenshots are encoded here so the program thread doesn't have to wait.
+static AsyncDispatcher& screenshot_encoder(){
+    static AsyncDispatcher dispatcher(nullptr, 1);
+    return dispatcher;
+}
 
 
 
 PendingFileSend::~PendingFileSend(){
-    if (m_filepath.empty()){
+    //  Wait for the encoding to finish.
+    m_encode.reset();
+
+    if (!m_on_disk){
         return;
     }
     if (m_keep_file){
@@ -45,6 +71,7 @@ PendingFileSend::PendingFileSend(const std::string& file, bool keep_file)
     : m_keep_file(keep_file)
     , m_extend_lifetime(false)
     , m_filepath(file)
+    , m_on_disk(!file.empty())
 {
     QFileInfo info(QString::fromStdString(file));
     m_filename = info.fileName().toStdString();
@@ -72,14 +99,17 @@ PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
     }
 
     std::string format;
+    const char* encoding = nullptr;
     switch (image.mode){
     case ImageAttachmentMode::NO_SCREENSHOT:
         break;
     case ImageAttachmentMode::JPG:
         format = ".jpg";
+        encoding = "JPG";
         break;
     case ImageAttachmentMode::PNG:
         format = ".png";
+        encoding = "PNG";
         break;
     }
 
@@ -87,24 +117,102 @@ PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
 
     if (image.keep_file){
         m_filepath = SCREENSHOTS_PATH() + m_filename;
+        logger.log("Saving image to: " + m_filepath, COLOR_BLUE);
     }else{
-        QDir().mkdir("TempFiles");
 //        m_filename = "temp-" + m_filename;
         m_filepath = "TempFiles/" + m_filename;
     }
 
-    if (image.image.save(m_filepath)){
-        logger.log("Saved image to: " + m_filepath, COLOR_BLUE);
-    }else{
-        logger.log("Unable to save screenshot to: " + m_filepath, COLOR_RED);
-        m_filename.clear();
-        m_filepath.clear();
+    //  The caller's image may not outlive this object. Keep a reference to
+    //  it if we can. Otherwise copy it.
+    std::shared_ptr<const ImageRGB32> owner = image.owner;
+    ImageViewRGB32 view = image.image;
+    if (!owner){
+        owner = std::make_shared<const ImageRGB32>(view.copy());
+        view = *owner;
     }
+
+    m_encode = screenshot_encoder().dispatch([this, owner = std::move(owner), view, encoding]{
+        encode(view, encoding);
+    });
 }
 void PendingFileSend::extend_lifetime(){
     m_extend_lifetime.store(true, std::memory_order_release);
 }
 
+void PendingFileSend::encode(const ImageViewRGB32& image, const char* format){
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.to_QImage_ref().save(&buffer, format)){
+        global_logger_tagged().log("Unable to encode screenshot: " + m_filename, COLOR_RED);
+        return;
+    }
+
+    std::shared_ptr<const std::string> data = std::make_shared<const std::string>(bytes.constData(), bytes.size());
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_data = std::move(data);
+    if (m_keep_file){
+        write_file();
+    }
+}
+void PendingFileSend::wait(){
+    if (m_encode){
+        m_encode->wait_and_rethrow_exceptions();
+    }
+}
+bool PendingFileSend::write_file(){
+    if (m_on_disk){
+        return true;
+    }
+    if (!m_data){
+        return false;
+    }
+
+    if (!m_keep_file){
+        QDir().mkdir("TempFiles");
+    }
+
+    QFile file(QString::fromStdString(m_filepath));
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(m_data->data(), m_data->size()) != (qint64)m_data->size()
+    ){
+        global_logger_tagged().log("Unable to save screenshot to: " + m_filepath, COLOR_RED);
+        return false;
+    }
+
+    m_on_disk = true;
+    global_logger_tagged().log("Saved image to: " + m_filepath, COLOR_BLUE);
+    return true;
+}
+
+std::string PendingFileSend::filepath(){
+    wait();
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (!write_file()){
+        return "";
+    }
+    return m_filepath;
+}
+std::shared_ptr<const std::string> PendingFileSend::data(){
+    wait();
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_data || !m_on_disk){
+        return m_data;
+    }
+
+    //  Constructed from a file. Load it once and keep it for the other senders.
+    QFile file(QString::fromStdString(m_filepath));
+    if (!file.open(QIODevice::ReadOnly)){
+        global_logger_tagged().log("File doesn't exist: " + m_filepath, COLOR_RED);
+        return nullptr;
+    }
+    QByteArray bytes = file.readAll();
+    m_data = std::make_shared<const std::string>(bytes.constData(), bytes.size());
+    return m_data;
+}
+
 
 
 
@@ -9,30 +9,46 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/Options/ScreenshotFormatOption.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 
 namespace PokemonAutomation{
 
+class AsyncTask;
+
 
 struct ImageAttachment{
     ImageViewRGB32 image;
     ImageAttachmentMode mode = ImageAttachmentMode::NO_SCREENSHOT;
     bool keep_file = false;
 
+    //  If set, "image" points into this and it will be encoded without
+    //  making a copy first.
+    std::shared_ptr<const ImageRGB32> owner;
+
     ImageAttachment() = default;
     ImageAttachment(
         const ImageViewRGB32& p_image,
         ImageAttachmentMode p_mode,
         bool p_keep_file = false
     );
+    ImageAttachment(
+        std::shared_ptr<const ImageRGB32> p_image,
+        ImageAttachmentMode p_mode,
+        bool p_keep_file = false
+    );
 };
 
 
 
 //  Represents a file that's in the process of being sent.
 //  If (keep_file = false), the file is automatically deleted after being sent.
+//
+//  Screenshots are encoded on a background thread into memory. The encoded
+//  data is shared by everything that sends this file. It is only written to
+//  disk if (keep_file = true) or if someone asks for "filepath()".
 class PendingFileSend{
 public:
     ~PendingFileSend();
@@ -41,19 +57,42 @@ public:
 //    PendingFileSend(Logger& logger, const std::string& text_attachment);
     PendingFileSend(Logger& logger, const ImageAttachment& image);
 
+    //  True if there is nothing to send. This does not wait for the encoding.
+    bool empty() const{ return m_filename.empty(); }
+
     const std::string& filename() const{ return m_filename; }
-    const std::string& filepath() const{ return m_filepath; }
     bool keep_file() const{ return m_keep_file; }
 
+    //  Return the path to the file on disk. Waits for the encoding and writes
+    //  the file if it isn't already there. Returns empty on failure.
+    std::string filepath();
+
+    //  Return the contents of the file. Waits for the encoding if needed.
+    //  Returns null on failure.
+    std::shared_ptr<const std::string> data();
+
     //  Work around bug in Sleepy that destroys file before it's not needed anymore.
     void extend_lifetime();
 
+private:
+    void encode(const ImageViewRGB32& image, const char* format);
+    void wait();
+
+    //  Must be called with "m_lock" held.
+    bool write_file();
+
 private:
     bool m_keep_file;
     std::atomic<bool> m_extend_lifetime;
 //    QFile m_file;
     std::string m_filename;
     std::string m_filepath;
+
+    std::mutex m_lock;
+    std::shared_ptr<const std::string> m_data;
+    bool m_on_disk = false;
+
+    std::unique_ptr<AsyncTask> m_encode;
 };
 
 
@@ -94,7 +94,7 @@ void send_raw_notification(
     const ImageAttachment& image
 ){
     std::shared_ptr<PendingFileSend> file(new PendingFileSend(logger, image));
-    bool hasFile = !file->filepath().empty();
+    bool hasFile = !file->empty();
 
     JsonObject embed;
     JsonArray embeds;
@@ -152,7 +152,7 @@ void send_raw_notification(
     const std::string& filepath
 ){
     std::shared_ptr<PendingFileSend> file(new PendingFileSend(filepath, true));
-    bool hasFile = !file->filepath().empty();
+    bool hasFile = !file->empty();
 
     JsonObject embed;
     JsonArray embeds;
@@ -5,13 +5,20 @@
  */
 
 #include <memory>
+#include <vector>
 #include <deque>
+#include <set>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <QFile>
 #include <QDir>
 #include "3rdParty/TesseractPA/TesseractPA.h"
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/Inference/StatAccumulator.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "OCR_RawOCR.h"
@@ -37,6 +44,11 @@ bool language_available(Language language){
 
 
 
+//  How long a read waits for an instance before the pool loads another one.
+//  Short bursts are served by the instances that are already loaded.
+const std::chrono::milliseconds OCR_GROW_DELAY(200);
+
+
 class TesseractPool{
 public:
     TesseractPool(Language language)
@@ -44,43 +56,189 @@ public:
         , m_training_data_path(
             QDir::current().relativeFilePath(QString::fromStdString(RESOURCE_PATH() + "Tesseract/")).toStdString()
         )
+        , m_stats_wait("OCR Wait", "ms", 1000, std::chrono::seconds(60))
+        , m_stats_read("OCR Read", "ms", 1000, std::chrono::seconds(60))
     {}
+    ~TesseractPool(){
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_stopping = true;
+        }
+        if (m_loader.joinable()){
+            m_loader.join();
+        }
+#ifdef __APPLE__
+#ifdef UNIX_LINK_TESSERACT
+        // As of Feb 05, 2022, the newest Tesseract (5.0.1) installed by HomeBrew on macOS
+        // has a bug that will crash the program when deleting internal Tesseract API intances,
+        // giving error: 
+        // libc++abi.dylib: terminating with uncaught exception of type std::__1::system_error: mutex lock failed: Invalid argument
+        // A similar issue is posted on Tesseract Github: https://github.com/tesseract-ocr/tesseract/issues/3655
+        // There is no way of using HomeBrew to reinstall the older version.
+        // Fortunately this class TesseractPool will not get built and destroyed repeatedly in
+        // runtime. It will only get initialized once for each supported language. So I am able
+        // to use this ugly workaround by not deleting the Tesseract API intances.
+        std::cout << "Warning: not release Tesseract API istance due to mutex bug similar to https://github.com/tesseract-ocr/tesseract/issues/3655" << std::endl;
+        for(auto& api : m_instances){
+            api.release();
+        }
+#endif
+#endif
+    }
+
+    std::string run(const ImageViewRGB32& image, ReadPriority priority){
+        WallClock time0 = current_time();
 
-    std::string run(const ImageViewRGB32& image){
         TesseractAPI* instance;
-        while (true){
-            {
-                WriteSpinLock lg(m_lock, "TesseractPool::run()");
-                if (!m_idle.empty()){
-                    instance = m_idle.back();
-                    m_idle.pop_back();
-                    break;
+        {
+            std::unique_lock<std::mutex> lg(m_lock);
+
+            //  Lower keys go first.
+            std::pair<int, uint64_t> ticket(-(int)priority, m_next_ticket++);
+            m_waiting.insert(ticket);
+
+            auto ready = [&]{
+                if (m_instances.empty() && m_load_error){
+                    return true;
                 }
+                return !m_idle.empty() && *m_waiting.begin() == ticket;
+            };
+
+            //  Loading happens on the loader thread. If an instance frees up
+            //  before the new one is ready, we take that one instead.
+            if (m_instances.empty()){
+                request_instances(1);
+            }
+
+            //  Only add an instance if reads have been backed up for a while.
+            //  Otherwise every brief overlap would load one.
+            if (!m_cv.wait_for(lg, OCR_GROW_DELAY, ready)){
+                request_instances(m_instances.size() + 1);
+                m_cv.wait(lg, ready);
+            }
+            m_waiting.erase(ticket);
+
+            if (m_idle.empty()){
+                m_cv.notify_all();
+                std::rethrow_exception(m_load_error);
+            }
+
+            instance = m_idle.back();
+            m_idle.pop_back();
+
+            //  There may be another instance for the next one in line.
+            if (!m_idle.empty() && !m_waiting.empty()){
+                m_cv.notify_all();
             }
-            add_instance();
         }
 
-//        auto start = current_time();
+        WallClock time1 = current_time();
         TesseractString str = instance->read32(
             (const unsigned char*)image.data(),
             image.width(),
             image.height(),
             image.bytes_per_row()
         );
-//        auto end = current_time();
-//        cout << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << endl;
+        WallClock time2 = current_time();
 
         {
-            WriteSpinLock lg(m_lock, "TesseractPool::run()");
+            std::lock_guard<std::mutex> lg(m_lock);
             m_idle.emplace_back(instance);
         }
+        m_cv.notify_all();
+
+        //  These log every so often. Don't hold up the next read for that.
+        {
+            std::lock_guard<std::mutex> lg(m_stats_lock);
+            m_stats_wait.report_data(
+                global_logger_tagged(),
+                (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count()
+            );
+            m_stats_read.report_data(
+                global_logger_tagged(),
+                (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time2 - time1).count()
+            );
+        }
 
         return str.c_str() == nullptr
             ? std::string()
             : str.c_str();
     }
 
-    void add_instance(){
+    void ensure_instances(size_t instances){
+        instances = std::min(instances, max_instances());
+        std::unique_lock<std::mutex> lg(m_lock);
+        request_instances(instances);
+        m_cv.wait(lg, [&]{
+            return m_load_error || m_instances.size() >= instances;
+        });
+        if (m_instances.size() < instances){
+            std::rethrow_exception(m_load_error);
+        }
+    }
+    void prewarm_instances(size_t instances){
+        std::lock_guard<std::mutex> lg(m_lock);
+        request_instances(instances);
+    }
+
+
+private:
+    static size_t max_instances(){
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    //  Have the loader thread bring the pool up to "instances".
+    //  Must be called with "m_lock" held.
+    void request_instances(size_t instances){
+        instances = std::min(instances, max_instances());
+        if (instances <= m_target){
+            return;
+        }
+        m_target = instances;
+        if (m_loader_running){
+            return;
+        }
+
+        //  Whatever failed last time gets another try.
+        m_load_error = nullptr;
+
+        //  The previous loader has already given up the lock for good.
+        if (m_loader.joinable()){
+            m_loader.join();
+        }
+        m_loader = std::thread(&TesseractPool::loader_thread, this);
+        m_loader_running = true;
+    }
+
+    void loader_thread(){
+        std::unique_lock<std::mutex> lg(m_lock);
+        while (!m_stopping && m_instances.size() < m_target){
+            lg.unlock();
+
+            std::unique_ptr<TesseractAPI> api;
+            std::exception_ptr error;
+            try{
+                api = make_instance();
+            }catch (...){
+                error = std::current_exception();
+            }
+
+            lg.lock();
+            if (error){
+                //  Don't keep retrying. The next request will try again.
+                m_load_error = error;
+                m_target = m_instances.size();
+                break;
+            }
+            m_instances.emplace_back(std::move(api));
+            m_idle.emplace_back(m_instances.back().get());
+            m_cv.notify_all();
+        }
+        m_loader_running = false;
+        m_cv.notify_all();
+    }
+
+    std::unique_ptr<TesseractAPI> make_instance() const{
         //  Check for non-ascii characters in path.
         for (char ch : m_training_data_path){
             if (ch < 0){
@@ -100,99 +258,66 @@ public:
         if (!api->valid()){
             throw InternalSystemError(nullptr, PA_CURRENT_FUNCTION, "Could not initialize TesseractAPI.");
         }
-
-        WriteSpinLock lg(m_lock, "TesseractPool::run()");
-
-        m_instances.emplace_back(std::move(api));
-        try{
-            m_idle.emplace_back(m_instances.back().get());
-        }catch (...){
-            m_instances.pop_back();
-            throw;
-        }
+        return api;
     }
 
-    void ensure_instances(size_t instances){
-        size_t current_instances;
-        while (true){
-            {
-                ReadSpinLock lg(m_lock, "TesseractPool::run()");
-                current_instances = m_instances.size();
-            }
-            if (current_instances >= instances){
-                break;
-            }
-            add_instance();
-        }
-    }
-
-#ifdef __APPLE__
-#ifdef UNIX_LINK_TESSERACT
-    ~TesseractPool(){
-        // As of Feb 05, 2022, the newest Tesseract (5.0.1) installed by HomeBrew on macOS
-        // has a bug that will crash the program when deleting internal Tesseract API intances,
-        // giving error: 
-        // libc++abi.dylib: terminating with uncaught exception of type std::__1::system_error: mutex lock failed: Invalid argument
-        // A similar issue is posted on Tesseract Github: https://github.com/tesseract-ocr/tesseract/issues/3655
-        // There is no way of using HomeBrew to reinstall the older version.
-        // Fortunately this class TesseractPool will not get built and destroyed repeatedly in
-        // runtime. It will only get initialized once for each supported language. So I am able
-        // to use this ugly workaround by not deleting the Tesseract API intances.
-        std::cout << "Warning: not release Tesseract API istance due to mutex bug similar to https://github.com/tesseract-ocr/tesseract/issues/3655" << std::endl;
-        for(auto& api : m_instances){
-            api.release();
-        }
-    }
-#endif
-#endif
 
 private:
     const std::string& m_language_code;
     const std::string m_training_data_path;
 
-    SpinLock m_lock;
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+
     std::vector<std::unique_ptr<TesseractAPI>> m_instances;
     std::vector<TesseractAPI*> m_idle;
+
+    //  Reads waiting for an instance. (-priority, arrival order)
+    std::set<std::pair<int, uint64_t>> m_waiting;
+    uint64_t m_next_ticket = 0;
+
+    //  The loader thread loads instances until there are "m_target" of them.
+    size_t m_target = 0;
+    bool m_loader_running = false;
+    bool m_stopping = false;
+    std::exception_ptr m_load_error;
+    std::thread m_loader;
+
+    std::mutex m_stats_lock;
+    PeriodicStatsReporterI32 m_stats_wait;
+    PeriodicStatsReporterI32 m_stats_read;
 };
 
 SpinLock ocr_pool_lock;
 std::map<Language, TesseractPool> ocr_pool;
 
 
-std::string ocr_read(Language language, const ImageViewRGB32& image){
-//    static size_t c = 0;
-//    image.save("ocr-" + std::to_string(c++) + ".png");
-
+TesseractPool& get_pool(Language language){
     if (language == Language::None){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Attempted to call OCR without a language.");
     }
 
-    std::map<Language, TesseractPool>::iterator iter;
-    {
-        WriteSpinLock lg(ocr_pool_lock, "ocr_read()");
-        iter = ocr_pool.find(language);
-        if (iter == ocr_pool.end()){
-            iter = ocr_pool.emplace(language, language).first;
-        }
+    WriteSpinLock lg(ocr_pool_lock, "ocr_read()");
+    auto iter = ocr_pool.find(language);
+    if (iter == ocr_pool.end()){
+        iter = ocr_pool.emplace(language, language).first;
     }
-    return iter->second.run(image);
+    return iter->second;
 }
-void ensure_instances(Language language, size_t instances){
-    if (language == Language::None){
-        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Attempted to call OCR without a language.");
-    }
 
-    std::map<Language, TesseractPool>::iterator iter;
-    {
-        WriteSpinLock lg(ocr_pool_lock, "ocr_read()");
-        iter = ocr_pool.find(language);
-        if (iter == ocr_pool.end()){
-            iter = ocr_pool.emplace(language, language).first;
-        }
-    }
-    iter->second.ensure_instances(instances);
-}
 
+std::string ocr_read(Language language, const ImageViewRGB32& image, ReadPriority priority){
+//    static size_t c = 0;
+//    image.save("ocr-" + std::to_string(c++) + ".png");
+
+    return get_pool(language).run(image, priority);
+}
+void ensure_instances(Language language, size_t instances){
+    get_pool(language).ensure_instances(instances);
+}
+void prewarm_instances(Language language, size_t instances){
+    get_pool(language).prewarm_instances(instances);
+}
 
 
 
@@ -18,14 +18,35 @@ namespace OCR{
 bool language_available(Language language);
 
 
+//  When all the OCR instances for a language are busy, waiting reads are
+//  served in order of priority, then in the order they arrived.
+enum class ReadPriority{
+    LOW,
+    NORMAL,
+    HIGH,
+};
+
+
 //  OCR the image in the specified language.
-std::string ocr_read(Language language, const ImageViewRGB32& image);
+//
+//  There is at most one OCR instance per CPU core for each language. If they
+//  are all busy, this waits for one to free up.
+std::string ocr_read(
+    Language language, const ImageViewRGB32& image,
+    ReadPriority priority = ReadPriority::NORMAL
+);
 
 //  Ensure that there are this many parallel instances for this language.
 //  Call this if you expect to need to do many OCR instances in parallel and you
 //  want to preload the OCR instances.
+//  This blocks until the instances are loaded. (capped at one per core)
 void ensure_instances(Language language, size_t instances);
 
+//  Same as "ensure_instances()", but load them in the background and return
+//  immediately. Call this when a program starts so that its first reads don't
+//  have to wait for the OCR data to load.
+void prewarm_instances(Language language, size_t instances);
+
 
 }
 }
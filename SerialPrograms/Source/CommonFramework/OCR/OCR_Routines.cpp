@@ -36,17 +36,18 @@ StringMatchResult multifiltered_OCR(
     StringMatchResult ret;
 //    int c = 0;
     for (const auto& filtered : filtered_images){
-        std::string text = ocr_read(language, filtered.first);
-//        cout << text.toStdString() << endl;
-//        filtered.first.save("test" + QString::number(c++) + ".png");
-
         //  Compute ratio of image that matches text color. Skip if it's out of range.
+        //  Do this first so that we don't spend an OCR on it.
         double ratio = filtered.second * pixels_inv;
 //        cout << "ratio = " << ratio << endl;
         if (ratio < min_text_ratio || ratio > max_text_ratio){
             continue;
         }
 
+        std::string text = ocr_read(language, filtered.first);
+//        cout << text.toStdString() << endl;
+//        filtered.first.save("test" + QString::number(c++) + ".png");
+
         StringMatchResult current = dictionary.match_substring(language, text, log10p_spread);
         ret.exact_match |= current.exact_match;
         ret.results.insert(current.results.begin(), current.results.end());
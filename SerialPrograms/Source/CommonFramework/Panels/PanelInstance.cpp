@@ -29,10 +29,10 @@ JsonValue PanelInstance::to_json() const{
 void PanelInstance::save_settings() const{
     const std::string& identifier = m_descriptor.identifier();
     if (!identifier.empty()){
-        PERSISTENT_SETTINGS().panels[identifier] = to_json();
+        PERSISTENT_SETTINGS().set_panel(identifier, to_json());
     }
     global_logger_tagged().log("Saving panel settings...");
-    PERSISTENT_SETTINGS().write();
+    PERSISTENT_SETTINGS().write_async();
 }
 
 
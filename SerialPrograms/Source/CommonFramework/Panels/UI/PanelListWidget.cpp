@@ -76,7 +76,7 @@ PanelListWidget::PanelListWidget(
 void PanelListWidget::handle_panel_clicked(const std::string& text){
     auto iter = m_panel_map.find(text);
     if (iter == m_panel_map.end()){
-        PERSISTENT_SETTINGS().panels[JSON_PROGRAM_PANEL] = "";
+        PERSISTENT_SETTINGS().set_panel(JSON_PROGRAM_PANEL, "");
         return;
     }
     std::shared_ptr<const PanelDescriptor>& descriptor = iter->second;
@@ -89,7 +89,7 @@ void PanelListWidget::handle_panel_clicked(const std::string& text){
         panel->from_json(PERSISTENT_SETTINGS().panels[descriptor->identifier()]);
         m_panel_holder.load_panel(descriptor, std::move(panel));
 
-        PERSISTENT_SETTINGS().panels[JSON_PROGRAM_PANEL] = iter->first;
+        PERSISTENT_SETTINGS().set_panel(JSON_PROGRAM_PANEL, iter->first);
     }catch (const Exception& error){
         QMessageBox box;
         box.critical(
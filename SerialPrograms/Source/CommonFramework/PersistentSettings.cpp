@@ -9,6 +9,7 @@
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonTools.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "NintendoSwitch/Framework/NintendoSwitch_VirtualControllerMapping.h"
@@ -28,31 +29,156 @@ PersistentSettings& PERSISTENT_SETTINGS(){
 }
 
 
-PersistentSettings::PersistentSettings(){}
+//  How long to wait for more changes before writing.
+const std::chrono::milliseconds SETTINGS_WRITE_DELAY(500);
 
 
+static std::string settings_path(){
+    return SETTINGS_PATH() + QCoreApplication::applicationName().toStdString() + "-Settings.json";
+}
+
+//  Append '"key": text' to an object being built at the specified depth.
+//  "text" must be a value dumped with an indent of 4.
+static void append_member(std::string& json, const std::string& key, const std::string& text, size_t depth, bool last){
+    std::string indent(4 * depth, ' ');
+    json += indent;
+    json += JsonValue(key).dump();
+    json += ": ";
+    for (char ch : text){
+        json += ch;
+        if (ch == '\n'){
+            json += indent;
+        }
+    }
+    json += last ? "\n" : ",\n";
+}
+
+
+
+PersistentSettings::~PersistentSettings(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    m_thread.join();
+}
+PersistentSettings::PersistentSettings()
+    : m_stopping(false)
+    , m_write_requested(false)
+    , m_flush(false)
+    , m_writing(false)
+    , m_thread(&PersistentSettings::thread_loop, this)
+{}
+
+
+void PersistentSettings::set_panel(const std::string& identifier, JsonValue json){
+    panels[identifier] = std::move(json);
+    m_dirty_panels.insert(identifier);
+}
+
+
+void PersistentSettings::write_async(){
+    //  Copy out only the panels that the writer hasn't seen yet.
+    std::map<std::string, JsonValue> changed;
+    for (const auto& item : panels){
+        bool is_new = m_submitted_panels.insert(item.first).second;
+        if (is_new || m_dirty_panels.find(item.first) != m_dirty_panels.end()){
+            changed[item.first] = item.second.clone();
+        }
+    }
+    m_dirty_panels.clear();
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    for (auto& item : changed){
+        m_changed_panels[item.first] = std::move(item.second);
+    }
+    m_write_requested = true;
+    m_last_request = current_time();
+    m_cv.notify_all();
+}
+void PersistentSettings::write(){
+    write_async();
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_flush = true;
+    m_cv.notify_all();
+    m_cv.wait(lg, [this]{ return !m_write_requested && !m_writing; });
+    m_flush = false;
+}
+
+
+void PersistentSettings::thread_loop(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (true){
+        m_cv.wait(lg, [this]{ return m_stopping || m_write_requested; });
+        if (m_stopping){
+            break;
+        }
+
+        //  Wait until there have been no new requests for a while.
+        while (!m_stopping && !m_flush){
+            WallClock deadline = m_last_request + SETTINGS_WRITE_DELAY;
+            if (current_time() >= deadline){
+                break;
+            }
+            m_cv.wait_until(lg, deadline);
+        }
+        if (m_stopping){
+            break;
+        }
 
-void PersistentSettings::write() const{
-    JsonObject root;
+        std::map<std::string, JsonValue> changed = std::move(m_changed_panels);
+        m_changed_panels.clear();
+        m_write_requested = false;
+        m_writing = true;
 
-    root["20-GlobalSettings"] = GlobalSettings::instance().to_json();
-    root["50-SwitchKeyboardMapping"] = NintendoSwitch::read_keyboard_mapping();
+        lg.unlock();
+        write_file(std::move(changed));
+        lg.lock();
 
-    root["99-Panels"] = panels.clone();
+        m_writing = false;
+        m_cv.notify_all();
+    }
+}
+void PersistentSettings::write_file(std::map<std::string, JsonValue> changed_panels){
+    for (auto& item : changed_panels){
+        m_panel_text[item.first] = item.second.dump();
+    }
+
+    //  Assemble the file the same way "JsonObject::dump()" would.
+    std::string json = "{\n";
+    append_member(json, "20-GlobalSettings", GlobalSettings::instance().to_json().dump(), 1, false);
+    append_member(json, "50-SwitchKeyboardMapping", JsonValue(NintendoSwitch::read_keyboard_mapping()).dump(), 1, false);
+    if (m_panel_text.empty()){
+        append_member(json, "99-Panels", "{}", 1, true);
+    }else{
+        std::string text = "{\n";
+        size_t count = 0;
+        for (const auto& item : m_panel_text){
+            append_member(text, item.first, item.second, 1, ++count == m_panel_text.size());
+        }
+        text += "}";
+        append_member(json, "99-Panels", text, 1, true);
+    }
+    json += "}";
+
+    if (json == m_last_written){
+        return;
+    }
 
     try{
-        std::string settings_path = SETTINGS_PATH() + QCoreApplication::applicationName().toStdString() + "-Settings.json";
-        root.dump(settings_path);
+        string_to_file(settings_path(), json);
+        m_last_written = std::move(json);
     }catch (FileException&){}
 }
 
 
 void PersistentSettings::read(){
-    std::string settings_path = SETTINGS_PATH() + QCoreApplication::applicationName().toStdString() + "-Settings.json";
-    JsonValue json = load_json_file(settings_path);
+    std::string path = settings_path();
+    JsonValue json = load_json_file(path);
     JsonObject* obj = json.to_object();
     if (obj == nullptr){
-        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid settings file.", settings_path);
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid settings file.", path);
     }
 
     //  Need to load this subset of settings first because they will affect how
@@ -77,6 +203,8 @@ void PersistentSettings::read(){
         if (value){
 //            panels = to_QJson(*value).toObject();
             panels = std::move(*value);
+            m_dirty_panels.clear();
+            m_submitted_panels.clear();
         }
     }
 }
@@ -8,6 +8,12 @@
 #ifndef PokemonAutomation_PersistentSettings_H
 #define PokemonAutomation_PersistentSettings_H
 
+#include <set>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/Time.h"
 #include "Common/Cpp/Json/JsonObject.h"
 
 namespace PokemonAutomation{
@@ -20,17 +26,54 @@ namespace PokemonAutomation{
 // - "50-SwitchKeyboardMapping": keyboard mapping.
 // - "99-Panels": settings for all the programs listed in the program panels.
 //   Access via PersistentSettings::panels.
+//
+// Writes are done on a background thread. Bursts of writes are combined into
+// one, and only the panels that changed since the last write are serialized
+// again. The rest reuse their text from the previous write.
 class PersistentSettings{
 public:
+    ~PersistentSettings();
     PersistentSettings();
 
-    // Write settings to the json file.
-    void write() const;
+    // Replace the settings of one panel and mark it as changed.
+    // Do not modify "panels" directly, or the change may not be written.
+    void set_panel(const std::string& identifier, JsonValue json);
+
+    // Write settings to the json file in the background.
+    void write_async();
+    // Write settings to the json file and wait for it to finish.
+    void write();
     // Load settings from the json file.
     void read();
 
 public:
     JsonObject panels;
+
+private:
+    void thread_loop();
+
+    //  Called on the writer thread.
+    void write_file(std::map<std::string, JsonValue> changed_panels);
+
+private:
+    //  Only accessed by the caller's thread.
+    std::set<std::string> m_dirty_panels;
+    std::set<std::string> m_submitted_panels;
+
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping;
+    bool m_write_requested;
+    bool m_flush;
+    bool m_writing;
+    WallClock m_last_request;
+    std::map<std::string, JsonValue> m_changed_panels;
+
+    //  Only accessed by the writer thread.
+    std::map<std::string, std::string> m_panel_text;
+    std::string m_last_written;
+
+    std::thread m_thread;
 };
 
 // Return the singleton PersistentSettings.
@@ -13,6 +13,7 @@
     #endif
 #endif
 #include "Globals.h"
+#include "Tools/StatsDatabase.h"
 #include "GlobalSettingsPanel.h"
 #include "SetupSettings.h"
 
@@ -105,6 +106,7 @@ bool migrate_stats(Logger& logger){
 
     if (root_file.exists() && !folder_file.exists()){
         logger.log("Migrating root file to the folder...");
+        StatSet::compact_file(path);
         root_file.copy(folder_file.fileName());
         logger.log("Renaming root file as backup...");
         root_file.rename(root_file.fileName() + ".bak");
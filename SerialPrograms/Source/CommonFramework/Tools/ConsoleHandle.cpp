@@ -32,7 +32,8 @@ ConsoleHandle::ConsoleHandle(
     BotBase* botbase,
     VideoFeed& video,
     VideoOverlay& overlay,
-    AudioFeed& audio
+    AudioFeed& audio,
+    VideoHistory* video_history
 )
     : m_index(index)
     , m_logger(logger)
@@ -40,15 +41,29 @@ ConsoleHandle::ConsoleHandle(
     , m_video(video)
     , m_overlay(overlay)
     , m_audio(audio)
+    , m_video_history(video_history)
     , m_thread_utilization(new ThreadUtilizationStat(current_thread_handle(), "Program Thread:"))
 {
     m_overlay.add_stat(*m_thread_utilization);
 }
 
 void ConsoleHandle::initialize_inference_threads(CancellableScope& scope, AsyncDispatcher& dispatcher){
-    m_video_pivot = std::make_unique<VisualInferencePivot>(scope, m_video, dispatcher);
+    initialize_inference_threads(
+        scope, dispatcher,
+        std::make_shared<VisualInferencePivot>(scope, dispatcher),
+        true
+    );
+}
+void ConsoleHandle::initialize_inference_threads(
+    CancellableScope& scope, AsyncDispatcher& dispatcher,
+    std::shared_ptr<VisualInferencePivot> video_pivot,
+    bool show_video_pivot_stats
+){
+    m_video_pivot = std::move(video_pivot);
     m_audio_pivot = std::make_unique<AudioInferencePivot>(scope, m_audio, dispatcher);
-    m_overlay.add_stat(*m_video_pivot);
+    if (show_video_pivot_stats){
+        m_overlay.add_stat(*m_video_pivot);
+    }
     m_overlay.add_stat(*m_audio_pivot);
 }
 
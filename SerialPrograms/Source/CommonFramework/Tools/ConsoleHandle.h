@@ -18,6 +18,7 @@ class ThreadHandle;
 class BotBase;
 class VideoFeed;
 class VideoOverlay;
+class VideoHistory;
 class AudioFeed;
 class ThreadUtilizationStat;
 class VisualInferencePivot;
@@ -40,7 +41,8 @@ public:
         BotBase* botbase,
         VideoFeed& video,
         VideoOverlay& overlay,
-        AudioFeed& audio
+        AudioFeed& audio,
+        VideoHistory* video_history = nullptr
     );
 
     // log(string-like msg, Color color = Color())
@@ -58,6 +60,9 @@ public:
     VideoOverlay& overlay(){ return m_overlay; }
     AudioFeed& audio(){ return m_audio; }
 
+    //  The recent frames of the video. Null if not being recorded.
+    VideoHistory* video_history(){ return m_video_history; }
+
     operator Logger&(){ return m_logger; }
     operator VideoFeed&(){ return m_video; }
     operator VideoOverlay&(){ return m_overlay; }
@@ -70,6 +75,14 @@ public:
 public:
     void initialize_inference_threads(CancellableScope& scope, AsyncDispatcher& dispatcher);
 
+    //  Use a video pivot that is shared with other consoles.
+    //  Only one of the consoles should show its stats.
+    void initialize_inference_threads(
+        CancellableScope& scope, AsyncDispatcher& dispatcher,
+        std::shared_ptr<VisualInferencePivot> video_pivot,
+        bool show_video_pivot_stats
+    );
+
 private:
     size_t m_index;
     Logger& m_logger;
@@ -77,8 +90,9 @@ private:
     VideoFeed& m_video;
     VideoOverlay& m_overlay;
     AudioFeed& m_audio;
+    VideoHistory* m_video_history;
     std::unique_ptr<ThreadUtilizationStat> m_thread_utilization;
-    std::unique_ptr<VisualInferencePivot> m_video_pivot;
+    std::shared_ptr<VisualInferencePivot> m_video_pivot;
     std::unique_ptr<AudioInferencePivot> m_audio_pivot;
 };
 
@@ -14,6 +14,7 @@
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "CommonFramework/VideoPipeline/VideoHistory.h"
 //#include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "ConsoleHandle.h"
 #include "ErrorDumper.h"
@@ -39,6 +40,26 @@ std::string dump_image_alone(
     image.save(name);
     return name;
 }
+std::string dump_video_history(
+    Logger& logger,
+    const ProgramInfo& program_info, const std::string& label,
+    const VideoHistoryClip& video_history
+){
+    static std::mutex lock;
+    std::lock_guard<std::mutex> lg(lock);
+
+    std::string folder = ERROR_PATH() + now_to_filestring();
+    folder += "-";
+    folder += label;
+    folder += "-Video/";
+    QDir().mkpath(folder.c_str());
+    logger.log(
+        "Saving " + std::to_string(video_history.size()) + " frames of video history to: " + folder,
+        COLOR_RED
+    );
+    video_history.save(folder + "Frame");
+    return folder;
+}
 std::string dump_image(
     Logger& logger,
     const ProgramInfo& program_info, const std::string& label,
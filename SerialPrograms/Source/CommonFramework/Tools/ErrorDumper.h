@@ -17,6 +17,7 @@ class EventNotificationOption;
 class ImageViewRGB32;
 class Logger;
 struct VideoSnapshot;
+class VideoHistoryClip;
 class ProgramEnvironment;
 struct ProgramInfo;
 
@@ -25,6 +26,13 @@ std::string dump_image_alone(
     const ProgramInfo& program_info, const std::string& label,
     const ImageViewRGB32& image
 );
+// Save the frames of a video history to a new folder in ./ErrorDumps/.
+// Return the folder path.
+std::string dump_video_history(
+    Logger& logger,
+    const ProgramInfo& program_info, const std::string& label,
+    const VideoHistoryClip& video_history
+);
 // Dump error image to ./ErrorDumps/ folder. Also send image as telemetry if user allows.
 // Return image path.
 std::string dump_image(
@@ -4,8 +4,22 @@
  *
  */
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <mutex>
+#include <functional>
 #include <QFile>
 #include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
 #include "ClientSource/Libraries/Logging.h"
 #include "StatsDatabase.h"
 
@@ -39,6 +53,157 @@ const std::map<std::string, std::string> STATS_DATABASE_ALIASES{
 
 
 
+//  Stat updates are appended to this file next to the stats file. Each line
+//  is the program identifier, a tab, and the stat line.
+static std::string journal_path(const std::string& filepath){
+    return filepath + ".journal";
+}
+
+//  Cached totals for each program so they can be loaded without reading the
+//  whole stats file.
+static std::string index_path(const std::string& filepath){
+    return filepath + ".index";
+}
+
+//  Once the journal reaches this size, it is folded into the stats file.
+const qint64 STATS_JOURNAL_COMPACT_BYTES = 16 * 1024;
+
+//  Multiple programs can save their stats at the same time.
+static std::mutex stats_file_lock;
+
+
+//  "QFile::flush()" only hands the data to the OS. This writes it to disk.
+static bool sync_file(QFile& file){
+#ifdef _WIN32
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+
+static std::string read_file(const std::string& path){
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::ReadOnly)){
+        return "";
+    }
+    return file.readAll().toStdString();
+}
+
+//  Identifies a version of the stats file. If the file is edited or replaced,
+//  the stamp changes and the cached totals are thrown away.
+static std::string file_stamp(const std::string& path){
+    QFileInfo info(QString::fromStdString(path));
+    if (!info.exists()){
+        return "";
+    }
+    return std::to_string(info.size()) + "-" + std::to_string(info.lastModified().toMSecsSinceEpoch());
+}
+
+//  Call "callback" on each complete line of "journal" starting at "offset".
+//  Return the offset after the last complete line. A line that was cut off
+//  by a crash is not complete and is skipped.
+static size_t for_each_journal_line(
+    const std::string& journal, size_t offset,
+    const std::function<void(const std::string& identifier, const std::string& line)>& callback
+){
+    while (offset < journal.size()){
+        size_t end = journal.find('\n', offset);
+        if (end == std::string::npos){
+            break;
+        }
+        std::string line = journal.substr(offset, end - offset);
+        offset = end + 1;
+
+        if (!line.empty() && line.back() == '\r'){
+            line.pop_back();
+        }
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos){
+            continue;
+        }
+        std::string identifier = line.substr(0, tab);
+        auto iter = STATS_DATABASE_ALIASES.find(identifier);
+        if (iter != STATS_DATABASE_ALIASES.end()){
+            identifier = iter->second;
+        }
+        callback(identifier, line.substr(tab + 1));
+    }
+    return offset;
+}
+
+static std::string journal_prefix_hash(const std::string& journal, size_t bytes){
+    QCryptographicHash hash(QCryptographicHash::Algorithm::Sha256);
+    hash.addData(journal.c_str(), (int)std::min(bytes, journal.size()));
+    return hash.result().toHex().toStdString();
+}
+
+static void drop_journal_prefix(const std::string& filepath, const std::string& journal, size_t bytes){
+    QSaveFile file(QString::fromStdString(journal_path(filepath)));
+    if (!file.open(QIODevice::WriteOnly)){
+        return;
+    }
+    if (bytes < journal.size()){
+        file.write(journal.c_str() + bytes, journal.size() - bytes);
+    }
+    file.commit();
+}
+
+static JsonObject read_index(const std::string& filepath){
+    if (!QFileInfo::exists(QString::fromStdString(index_path(filepath)))){
+        return JsonObject();
+    }
+    try{
+        JsonValue json = load_json_file(index_path(filepath));
+        JsonObject* obj = json.to_object();
+        if (obj != nullptr){
+            return std::move(*obj);
+        }
+    }catch (Exception&){}
+    return JsonObject();
+}
+static bool write_index(const std::string& filepath, const JsonObject& index){
+    try{
+        index.dump(index_path(filepath));
+        return true;
+    }catch (Exception&){
+        return false;
+    }
+}
+
+//  Finish a compaction that was interrupted.
+static void recover_compaction(const std::string& filepath, JsonObject& index){
+    const JsonObject* compacting = index.get_object("Compacting");
+    if (compacting == nullptr){
+        return;
+    }
+    std::string old_stamp;
+    std::string prefix_hash;
+    size_t journal_bytes = 0;
+    compacting->read_string(old_stamp, "StatsFile");
+    compacting->read_string(prefix_hash, "JournalHash");
+    compacting->read_integer(journal_bytes, "JournalSize");
+    if (file_stamp(filepath) != old_stamp){
+        //  The new stats file was saved. Trim the journal unless that was
+        //  also done. Lines may have been appended to a trimmed journal since
+        //  then, so check that it still starts with the lines that were
+        //  folded in.
+        std::string journal = read_file(journal_path(filepath));
+        if (journal.size() >= journal_bytes &&
+            journal_prefix_hash(journal, journal_bytes) == prefix_hash
+        ){
+            drop_journal_prefix(filepath, journal, journal_bytes);
+        }
+    }
+
+    //  Whichever way it went, the cached totals can't be trusted.
+    index = JsonObject();
+    index["StatsFile"] = file_stamp(filepath);
+    write_index(filepath, index);
+}
+
+
+
 StatLine::StatLine(StatsTracker& tracker)
     : m_time(current_time_to_str())
     , m_stats(tracker.to_str(StatsTracker::SAVE_TO_STATS_FILE))
@@ -138,13 +303,18 @@ void StatSet::save_to_file(const std::string& filepath){
     file.write(data.c_str(), data.size());
 }
 void StatSet::open_from_file(const std::string& filepath){
-    QFile file(QString::fromStdString(filepath));
-    if (!file.open(QIODevice::ReadOnly)){
-        return;
-    }
+    std::lock_guard<std::mutex> lg(stats_file_lock);
 
-    std::string str = file.readAll().data();
-    load_from_string(str.c_str());
+    JsonObject index = read_index(filepath);
+    recover_compaction(filepath, index);
+
+    load_from_string(read_file(filepath).c_str());
+    for_each_journal_line(
+        read_file(journal_path(filepath)), 0,
+        [this](const std::string& identifier, const std::string& line){
+            m_data[identifier] += line;
+        }
+    );
 }
 
 bool StatSet::update_file(
@@ -152,21 +322,195 @@ bool StatSet::update_file(
     const std::string& identifier,
     StatsTracker& tracker
 ){
-    QFile file(QString::fromStdString(filepath));
-    while (!file.open(QIODevice::ReadWrite)){
+    std::lock_guard<std::mutex> lg(stats_file_lock);
+
+    //  Don't append to a journal that an interrupted compaction still needs
+    //  to trim.
+    JsonObject index = read_index(filepath);
+    recover_compaction(filepath, index);
+
+    QFile file(QString::fromStdString(journal_path(filepath)));
+    if (!file.open(QIODevice::ReadWrite)){
+        return false;
+    }
+
+    //  If the last append was cut off by a crash, drop the partial line.
+    qint64 size = file.size();
+    if (size > 0){
+        char last = 0;
+        file.seek(size - 1);
+        file.getChar(&last);
+        if (last != '\n'){
+            file.seek(0);
+            QByteArray data = file.readAll();
+            size = data.lastIndexOf('\n') + 1;
+            file.resize(size);
+        }
+    }
+
+    std::string line = identifier + '\t' + StatLine(tracker).to_str() + "\r\n";
+    file.seek(size);
+    if (file.write(line.c_str(), line.size()) != (qint64)line.size() || !file.flush()){
+        return false;
+    }
+    //  Stats are only saved once per run. So every append is synced.
+    if (!sync_file(file)){
         return false;
     }
-    std::string data = file.readAll().data();
+    size += line.size();
+    file.close();
+
+    if (size >= STATS_JOURNAL_COMPACT_BYTES){
+        //  The line is already saved. A failed compaction will retry next time.
+        compact_file_unlocked(filepath);
+    }
+    return true;
+}
+
+void StatSet::load_totals(
+    const std::string& filepath,
+    const std::string& identifier,
+    StatsTracker& tracker
+){
+    std::lock_guard<std::mutex> lg(stats_file_lock);
+
+    JsonObject index = read_index(filepath);
+    recover_compaction(filepath, index);
+
+    const std::string stamp = file_stamp(filepath);
+    const std::string journal = read_file(journal_path(filepath));
+
+    std::string index_stamp;
+    index.read_string(index_stamp, "StatsFile");
+    if (index_stamp != stamp){
+        index = JsonObject();
+        index["StatsFile"] = stamp;
+    }
+    JsonObject* all_totals = index.get_object("Totals");
+    if (all_totals == nullptr){
+        index["Totals"] = JsonObject();
+        all_totals = index.get_object("Totals");
+    }
+
+    //  Use a plain tracker so that the totals are kept exactly as parsed.
+    StatsTracker totals;
+    size_t offset = 0;
+    const JsonObject* entry = all_totals->get_object(identifier);
+    const JsonObject* entry_counts = entry == nullptr ? nullptr : entry->get_object("Counts");
+    size_t entry_offset = 0;
+    if (entry_counts != nullptr &&
+        entry->read_integer(entry_offset, "JournalOffset") &&
+        entry_offset <= journal.size()
+    ){
+        std::map<std::string, uint64_t> counts;
+        for (const auto& item : *entry_counts){
+            counts[item.first] = item.second.to_integer_default();
+        }
+        totals.add_counts(counts);
+        offset = entry_offset;
+    }else{
+        StatSet set;
+        set.load_from_string(read_file(filepath).c_str());
+        set[identifier].aggregate(totals);
+    }
+
+    offset = for_each_journal_line(
+        journal, offset,
+        [&](const std::string& line_identifier, const std::string& line){
+            if (line_identifier == identifier){
+                totals.parse_and_append_line(StatLine(line).stats());
+            }
+        }
+    );
+
+    std::map<std::string, uint64_t> counts = totals.counts();
+    tracker.add_counts(counts);
+
+    JsonObject new_entry;
+    new_entry["JournalOffset"] = offset;
+    JsonObject new_counts;
+    for (const auto& item : counts){
+        new_counts[item.first] = item.second;
+    }
+    new_entry["Counts"] = std::move(new_counts);
+    (*all_totals)[identifier] = std::move(new_entry);
+    write_index(filepath, index);
+}
+
+bool StatSet::compact_file(const std::string& filepath){
+    std::lock_guard<std::mutex> lg(stats_file_lock);
+    return compact_file_unlocked(filepath);
+}
+bool StatSet::compact_file_unlocked(const std::string& filepath){
+    JsonObject index = read_index(filepath);
+    recover_compaction(filepath, index);
+
+    const std::string journal = read_file(journal_path(filepath));
 
     StatSet set;
-    set.load_from_string(data.c_str());
+    set.load_from_string(read_file(filepath).c_str());
+    size_t journal_end = for_each_journal_line(
+        journal, 0,
+        [&](const std::string& identifier, const std::string& line){
+            set[identifier] += line;
+        }
+    );
+    if (journal_end == 0){
+        return true;
+    }
 
-    set[identifier] += tracker;
+    //  Record the compaction before doing it. If we crash after the stats file
+    //  is replaced, but before the journal is trimmed, the next access will
+    //  see this and trim the journal instead of counting its lines twice.
+    const std::string old_stamp = file_stamp(filepath);
+    JsonObject compacting;
+    compacting["StatsFile"] = old_stamp;
+    compacting["JournalSize"] = journal_end;
+    compacting["JournalHash"] = journal_prefix_hash(journal, journal_end);
+    index["Compacting"] = std::move(compacting);
+    if (!write_index(filepath, index)){
+        return false;
+    }
 
-    data = set.to_str();
-    file.seek(0);
+    QSaveFile file(QString::fromStdString(filepath));
+    if (!file.open(QIODevice::WriteOnly)){
+        return false;
+    }
+    std::string data = set.to_str();
     file.write(data.c_str(), data.size());
-    file.resize(data.size());
+    if (!file.commit()){
+        return false;
+    }
+
+    drop_journal_prefix(filepath, journal, journal_end);
+
+    //  Totals that covered the whole journal are still correct. They now
+    //  cover the new stats file and none of the journal.
+    JsonObject new_index;
+    new_index["StatsFile"] = file_stamp(filepath);
+    JsonObject new_totals;
+    std::string index_stamp;
+    index.read_string(index_stamp, "StatsFile");
+    const JsonObject* old_totals = index_stamp == old_stamp
+        ? index.get_object("Totals")
+        : nullptr;
+    if (old_totals != nullptr){
+        for (const auto& item : *old_totals){
+            const JsonObject* entry = item.second.to_object();
+            size_t entry_offset = 0;
+            if (entry == nullptr ||
+                !entry->read_integer(entry_offset, "JournalOffset") ||
+                entry_offset != journal_end
+            ){
+                continue;
+            }
+            JsonObject new_entry = entry->clone();
+            new_entry["JournalOffset"] = 0;
+            new_totals[item.first] = std::move(new_entry);
+        }
+    }
+    new_index["Totals"] = std::move(new_totals);
+    write_index(filepath, new_index);
 
     return true;
 }
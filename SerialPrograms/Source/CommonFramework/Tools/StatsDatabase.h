@@ -54,15 +54,38 @@ public:
     std::string to_str() const;
 
     void save_to_file(const std::string& filepath);
+
+    //  Load the stats file and the updates in its journal.
     void open_from_file(const std::string& filepath);
 
+    //  Record a new stat line for "identifier".
+    //
+    //  The line is appended to a journal next to the stats file instead of
+    //  rewriting the whole file. Once the journal grows large enough, it is
+    //  compacted into the stats file.
     static bool update_file(
         const std::string& filepath,
         const std::string& identifier,
         StatsTracker& tracker
     );
 
+    //  Add the totals of every stat line of "identifier" to "tracker".
+    //
+    //  The totals are cached in an index next to the stats file. So this only
+    //  needs to parse the journal lines that were added since the last call.
+    //  The stats file itself is only read when the index is out of date.
+    static void load_totals(
+        const std::string& filepath,
+        const std::string& identifier,
+        StatsTracker& tracker
+    );
+
+    //  Move everything in the journal into the stats file.
+    static bool compact_file(const std::string& filepath);
+
 private:
+    static bool compact_file_unlocked(const std::string& filepath);
+
     bool get_line(std::string& line, const char*& ptr);
     void load_from_string(const char* ptr);
 
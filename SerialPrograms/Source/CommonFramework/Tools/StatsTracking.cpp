@@ -124,6 +124,20 @@ void StatsTracker::parse_and_append_line(const std::string& line){
 }
 
 
+std::map<std::string, uint64_t> StatsTracker::counts() const{
+    std::map<std::string, uint64_t> ret;
+    for (const auto& item : m_stats){
+        ret[item.first] = item.second.load(std::memory_order_relaxed);
+    }
+    return ret;
+}
+void StatsTracker::add_counts(const std::map<std::string, uint64_t>& counts){
+    for (const auto& item : counts){
+        m_stats[item.first] += item.second;
+    }
+}
+
+
 
 std::string stats_to_bar(
     Logger& logger,
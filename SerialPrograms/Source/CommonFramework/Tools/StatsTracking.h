@@ -31,6 +31,12 @@ public:
 
     void parse_and_append_line(const std::string& line);
 
+    //  The raw count of every stat label that has been added. Unlike
+    //  "to_str()", this has no aliasing or hiding. So it can be saved and
+    //  added back with "add_counts()" without losing anything.
+    std::map<std::string, uint64_t> counts() const;
+    void add_counts(const std::map<std::string, uint64_t>& counts);
+
 
 protected:
 //    static constexpr bool HIDDEN_IF_ZERO = true;
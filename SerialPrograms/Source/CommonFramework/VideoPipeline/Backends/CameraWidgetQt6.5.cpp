@@ -207,7 +207,7 @@ VideoSnapshot CameraSession::snapshot(){
         ReadSpinLock lg0(m_frame_lock);
         frame_seqnum = m_last_frame_seqnum;
         if (!m_last_image.isNull() && m_last_image_seqnum == frame_seqnum){
-            return VideoSnapshot(m_last_image, m_last_image_timestamp);
+            return m_last_snapshot;
         }
         frame = m_last_frame;
         frame_timestamp = m_last_frame_timestamp;
@@ -233,7 +233,14 @@ VideoSnapshot CameraSession::snapshot(){
     WallClock time1 = current_time();
     m_stats_conversion.report_data(m_logger, std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count());
 
-    return VideoSnapshot(m_last_image, m_last_image_timestamp);
+    //  Hand out the same snapshot until the next frame so that callers can
+    //  tell a repeated frame apart by its pointer.
+    m_last_snapshot = VideoSnapshot(m_last_image, m_last_image_timestamp, m_last_image_seqnum);
+    return m_last_snapshot;
+}
+uint64_t CameraSession::frame_seqnum(){
+    ReadSpinLock lg(m_frame_lock);
+    return m_last_frame_seqnum;
 }
 double CameraSession::fps_source(){
     ReadSpinLock lg(m_frame_lock);
@@ -316,6 +323,7 @@ void CameraSession::shutdown(){
     m_last_image = QImage();
     m_last_image_timestamp = m_last_frame_timestamp;
     m_last_image_seqnum = m_last_frame_seqnum;
+    m_last_snapshot.clear();
 
 }
 void CameraSession::startup(){
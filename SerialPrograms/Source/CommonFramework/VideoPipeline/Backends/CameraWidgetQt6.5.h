@@ -82,6 +82,7 @@ public:
     virtual std::vector<Resolution> supported_resolutions() const override;
 
     virtual VideoSnapshot snapshot() override;
+    virtual uint64_t frame_seqnum() override;
     virtual double fps_source() override;
     virtual double fps_display() override;
 
@@ -139,6 +140,7 @@ private:
     QImage m_last_image;
     WallClock m_last_image_timestamp;
     uint64_t m_last_image_seqnum = 0;
+    VideoSnapshot m_last_snapshot;
     PeriodicStatsReporterI32 m_stats_conversion;
 
     std::set<Listener*> m_ui_listeners;
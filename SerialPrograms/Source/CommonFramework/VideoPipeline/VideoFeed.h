@@ -10,6 +10,7 @@
 #include <memory>
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImagePyramid.h"
 
 namespace PokemonAutomation{
 
@@ -22,13 +23,26 @@ struct VideoSnapshot{
     //  This will be as close as possible to when the frame was taken.
     WallClock timestamp = WallClock::min();
 
+    //  Goes up every time the source delivers a new frame. Two snapshots with
+    //  the same non-zero seqnum are the same frame. Zero means the source
+    //  doesn't keep track of this.
+    uint64_t seqnum = 0;
+
+    //  Smaller copies of the frame. Null until make_pyramid() is called.
+    //  Copies of the snapshot made after that share it.
+    std::shared_ptr<const ImagePyramid> pyramid;
+
     VideoSnapshot()
          : frame(std::make_shared<const ImageRGB32>())
          , timestamp(WallClock::min())
     {}
-    VideoSnapshot(ImageRGB32 p_frame, WallClock p_timestamp)
-         : frame(std::make_shared<const ImageRGB32>(std::move(p_frame)))
+    VideoSnapshot(ImageRGB32 p_frame, WallClock p_timestamp, uint64_t p_seqnum = 0)
+         : VideoSnapshot(std::make_shared<const ImageRGB32>(std::move(p_frame)), p_timestamp, p_seqnum)
+    {}
+    VideoSnapshot(std::shared_ptr<const ImageRGB32> p_frame, WallClock p_timestamp, uint64_t p_seqnum = 0)
+         : frame(std::move(p_frame))
          , timestamp(p_timestamp)
+         , seqnum(p_seqnum)
     {}
 
     //  Returns true if the snapshot is valid.
@@ -39,9 +53,45 @@ struct VideoSnapshot{
     operator std::shared_ptr<const ImageRGB32>() const{ return frame; }
     operator ImageViewRGB32() const{ return *frame; }
 
+    //  Attach a pyramid for this frame if there isn't one yet. This doesn't
+    //  scale anything. Each level is built the first time it is asked for.
+    void make_pyramid(){
+        if (frame && !has_pyramid()){
+            pyramid = std::make_shared<const ImagePyramid>(frame);
+        }
+    }
+
+    //  The frame shrunk to 1/2^level of its width and height.
+    //  (see ImagePyramid::level())
+    //  This is the full frame if make_pyramid() hasn't been called.
+    ImageViewRGB32 downscaled(size_t level) const{
+        if (!has_pyramid()){
+            return *frame;
+        }
+        return pyramid->level(level);
+    }
+
+    //  The smallest copy of the frame that is at least this large.
+    //  (see ImagePyramid::smallest_at_least())
+    //  This is the full frame if make_pyramid() hasn't been called.
+    ImageViewRGB32 downscaled_to(size_t min_width, size_t min_height) const{
+        if (!has_pyramid()){
+            return *frame;
+        }
+        return pyramid->smallest_at_least(min_width, min_height);
+    }
+
     void clear(){
         frame.reset();
         timestamp = WallClock::min();
+        seqnum = 0;
+        pyramid.reset();
+    }
+
+private:
+    //  "frame" is a public member, so it can be replaced without the pyramid.
+    bool has_pyramid() const{
+        return pyramid && frame && pyramid->image() == frame;
     }
 };
 
@@ -58,6 +108,10 @@ public:
     //  Do not call this on the main thread or it may deadlock.
     virtual VideoSnapshot snapshot() = 0;
 
+    //  The seqnum of the newest frame from the source. (see VideoSnapshot::seqnum)
+    //  This is much cheaper than snapshot(). Returns zero if not supported.
+    virtual uint64_t frame_seqnum(){ return 0; }
+
     //  Returns the currently measured frames/second for the video source + display.
     //  Use this for diagnostic purposes.
     virtual double fps_source() = 0;
@@ -0,0 +1,265 @@
+/*  Video History
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/AbstractLogger.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "VideoFeed.h"
+#include "VideoHistory.h"
+
+namespace PokemonAutomation{
+
+
+
+namespace{
+
+//  Encode "frame" as the XOR against "previous". If "previous" is null, this
+//  is a keyframe.
+void encode_frame(std::vector<uint32_t>& out, const ImageViewRGB32& frame, const ImageViewRGB32& previous){
+    out.clear();
+    size_t unchanged = 0;
+    size_t header = (size_t)-1;     //  Index of the current changed count.
+    for (size_t r = 0; r < frame.height(); r++){
+        const uint32_t* row = (const uint32_t*)((const char*)frame.data() + r * frame.bytes_per_row());
+        const uint32_t* prev = previous
+            ? (const uint32_t*)((const char*)previous.data() + r * previous.bytes_per_row())
+            : nullptr;
+        for (size_t c = 0; c < frame.width(); c++){
+            uint32_t diff = prev == nullptr ? row[c] : row[c] ^ prev[c];
+            if (diff == 0){
+                unchanged++;
+                continue;
+            }
+            if (unchanged != 0 || header == (size_t)-1){
+                out.emplace_back((uint32_t)unchanged);
+                header = out.size();
+                out.emplace_back(0);
+                unchanged = 0;
+            }
+            out.emplace_back(diff);
+            out[header]++;
+        }
+    }
+    if (unchanged != 0){
+        out.emplace_back((uint32_t)unchanged);
+        out.emplace_back(0);
+    }
+    out.shrink_to_fit();
+}
+
+//  Apply "frame" on top of the previous frame in "image".
+void apply_frame(ImageRGB32& image, const VideoHistoryFrame& frame){
+    if (frame.keyframe){
+        if (image.width() != frame.width || image.height() != frame.height){
+            image = ImageRGB32(frame.width, frame.height);
+        }
+        image.fill(0);
+    }
+    if (image.width() != frame.width || image.height() != frame.height){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Frame dimensions do not match the previous frame.");
+    }
+
+    const size_t width = frame.width;
+    const uint32_t* ptr = frame.data.data();
+    const uint32_t* end = ptr + frame.data.size();
+    size_t x = 0;
+    size_t y = 0;
+    while (ptr < end){
+        size_t unchanged = ptr[0];
+        size_t changed = ptr[1];
+        ptr += 2;
+        x += unchanged;
+        y += x / width;
+        x %= width;
+        for (size_t c = 0; c < changed; c++){
+            image.pixel(x, y) ^= *ptr++;
+            if (++x == width){
+                x = 0;
+                y++;
+            }
+        }
+    }
+}
+
+}
+
+
+
+size_t VideoHistoryClip::bytes() const{
+    size_t ret = 0;
+    for (const auto& frame : m_frames){
+        ret += frame->bytes();
+    }
+    return ret;
+}
+void VideoHistoryClip::decode(const std::function<void(size_t index, WallClock timestamp, const ImageViewRGB32& frame)>& callback) const{
+    ImageRGB32 image;
+    for (size_t c = 0; c < m_frames.size(); c++){
+        const VideoHistoryFrame& frame = *m_frames[c];
+        apply_frame(image, frame);
+        callback(c, frame.timestamp, image);
+    }
+}
+size_t VideoHistoryClip::save(const std::string& prefix) const{
+    size_t saved = 0;
+    decode([&](size_t index, WallClock, const ImageViewRGB32& frame){
+        std::string number = std::to_string(index);
+        if (number.size() < 4){
+            number.insert(0, 4 - number.size(), '0');
+        }
+        if (frame.save(prefix + "-" + number + ".png")){
+            saved++;
+        }
+    });
+    return saved;
+}
+
+
+
+VideoHistory::~VideoHistory(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    m_thread.join();
+}
+VideoHistory::VideoHistory(
+    Logger& logger, VideoFeed& feed,
+    std::chrono::milliseconds window,
+    double fps,
+    size_t max_width,
+    size_t memory_budget
+)
+    : m_logger(logger)
+    , m_feed(feed)
+    , m_window(window)
+    , m_period((int64_t)(1000000 / fps))
+    , m_max_width(max_width)
+    , m_memory_budget(memory_budget)
+    , m_stopping(false)
+    , m_bytes(0)
+    , m_thread(&VideoHistory::thread_loop, this)
+{}
+
+
+VideoHistoryClip VideoHistory::clip() const{
+    VideoHistoryClip ret;
+    std::lock_guard<std::mutex> lg(m_lock);
+    ret.m_frames.assign(m_frames.begin(), m_frames.end());
+    return ret;
+}
+size_t VideoHistory::bytes() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_bytes;
+}
+
+
+void VideoHistory::thread_loop(){
+    GlobalSettings::instance().COMPUTE_PRIORITY0.set_on_this_thread();
+
+    WallClock next = current_time();
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (true){
+        m_cv.wait_until(lg, next, [this]{ return m_stopping; });
+        if (m_stopping){
+            break;
+        }
+
+        //  Don't try to catch up if we fall behind.
+        WallClock now = current_time();
+        next += m_period;
+        if (next < now){
+            next = now + m_period;
+        }
+
+        lg.unlock();
+        try{
+            VideoSnapshot snapshot = m_feed.snapshot();
+
+            //  The feed returns the same frame until a new one arrives.
+            if (snapshot && snapshot.frame != m_last_source){
+                m_last_source = snapshot.frame;
+
+                //  Start from the smallest copy of the frame that is still
+                //  wide enough. It's much cheaper to scale than the original.
+                snapshot.make_pyramid();
+                push_frame(
+                    snapshot.downscaled_to(m_max_width, 0),
+                    snapshot.timestamp == WallClock::min() ? now : snapshot.timestamp
+                );
+            }
+        }catch (Exception& e){
+            m_logger.log("Unable to record video history: " + e.to_str(), COLOR_RED);
+        }
+        lg.lock();
+    }
+}
+void VideoHistory::push_frame(const ImageViewRGB32& source, WallClock timestamp){
+    ImageRGB32 frame;
+    if (source.width() > m_max_width){
+        size_t height = std::max<size_t>(source.height() * m_max_width / source.width(), 1);
+        frame = source.scale_to(m_max_width, height);
+    }else{
+        frame = source.copy();
+    }
+
+    std::shared_ptr<VideoHistoryFrame> encoded = std::make_shared<VideoHistoryFrame>();
+    encoded->timestamp = timestamp;
+    encoded->width = frame.width();
+    encoded->height = frame.height();
+    encoded->keyframe = !m_last_frame
+        || m_last_frame.width() != frame.width()
+        || m_last_frame.height() != frame.height();
+    encode_frame(
+        encoded->data, frame,
+        encoded->keyframe ? ImageViewRGB32() : ImageViewRGB32(m_last_frame)
+    );
+    m_last_frame = std::move(frame);
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_bytes += encoded->bytes();
+    m_frames.emplace_back(std::move(encoded));
+
+    //  Always keep the newest frame even if it alone is over the budget.
+    while (m_frames.size() > 1 && (
+        m_bytes > m_memory_budget ||
+        m_frames.front()->timestamp + m_window < timestamp
+    )){
+        drop_oldest();
+    }
+}
+void VideoHistory::drop_oldest(){
+    std::shared_ptr<const VideoHistoryFrame> oldest = std::move(m_frames.front());
+    m_frames.pop_front();
+    m_bytes -= oldest->bytes();
+
+    if (m_frames.empty() || m_frames.front()->keyframe){
+        return;
+    }
+
+    //  The next frame is stored against the one that was dropped. Make it a
+    //  keyframe. Clips that still hold the old frames are not affected.
+    const VideoHistoryFrame& next = *m_frames.front();
+    ImageRGB32 image;
+    apply_frame(image, *oldest);
+    apply_frame(image, next);
+
+    std::shared_ptr<VideoHistoryFrame> keyframe = std::make_shared<VideoHistoryFrame>();
+    keyframe->timestamp = next.timestamp;
+    keyframe->width = next.width;
+    keyframe->height = next.height;
+    keyframe->keyframe = true;
+    encode_frame(keyframe->data, image, ImageViewRGB32());
+
+    m_bytes -= next.bytes();
+    m_bytes += keyframe->bytes();
+    m_frames.front() = std::move(keyframe);
+}
+
+
+
+}
@@ -0,0 +1,129 @@
+/*  Video History
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Keep the last few seconds of video in memory so they can be saved with an
+ *  error report.
+ *
+ *  A background thread samples the video feed at a low frame rate, shrinks
+ *  each frame, and stores it as the XOR against the previous frame with the
+ *  unchanged runs removed. This only helps on a clean feed where most of the
+ *  screen is bit-identical between frames. Noise from most capture cards
+ *  changes nearly every pixel, so expect close to raw size. The oldest frames
+ *  are dropped when they fall out of the window or the memory budget is
+ *  exceeded.
+ *
+ *  None of this runs on the inference threads.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoHistory_H
+#define PokemonAutomation_VideoPipeline_VideoHistory_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <string>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/Time.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+class VideoFeed;
+
+
+struct VideoHistoryFrame{
+    WallClock timestamp;
+    size_t width = 0;
+    size_t height = 0;
+
+    //  If true, this frame does not depend on the frame before it.
+    bool keyframe = true;
+
+    //  Pairs of (# of unchanged pixels, # of changed pixels), each followed by
+    //  the changed pixels XORed with the previous frame. A keyframe is XORed
+    //  with an all-zero frame.
+    std::vector<uint32_t> data;
+
+    size_t bytes() const{
+        return sizeof(VideoHistoryFrame) + data.size() * sizeof(uint32_t);
+    }
+};
+
+
+
+//  The contents of the history at one point in time. The frames are shared
+//  with the history, so this is cheap to copy.
+class VideoHistoryClip{
+public:
+    size_t size() const{ return m_frames.size(); }
+    bool empty() const{ return m_frames.empty(); }
+    size_t bytes() const;
+
+    //  Decode the frames from oldest to newest.
+    void decode(const std::function<void(size_t index, WallClock timestamp, const ImageViewRGB32& frame)>& callback) const;
+
+    //  Save the frames as "<prefix>-0000.png", "<prefix>-0001.png", etc...
+    //  Returns the number of frames saved.
+    size_t save(const std::string& prefix) const;
+
+private:
+    friend class VideoHistory;
+    std::vector<std::shared_ptr<const VideoHistoryFrame>> m_frames;
+};
+
+
+
+class VideoHistory{
+public:
+    ~VideoHistory();
+    VideoHistory(
+        Logger& logger, VideoFeed& feed,
+        std::chrono::milliseconds window,
+        double fps = 10,
+        size_t max_width = 640,
+        size_t memory_budget = (size_t)64 << 20
+    );
+
+    VideoHistoryClip clip() const;
+
+    //  Memory used by the stored frames.
+    size_t bytes() const;
+
+
+private:
+    void thread_loop();
+    void push_frame(const ImageViewRGB32& frame, WallClock timestamp);
+    void drop_oldest();
+
+private:
+    Logger& m_logger;
+    VideoFeed& m_feed;
+    const std::chrono::milliseconds m_window;
+    const std::chrono::microseconds m_period;
+    const size_t m_max_width;
+    const size_t m_memory_budget;
+
+    //  Only touched by the thread.
+    std::shared_ptr<const ImageRGB32> m_last_source;
+    ImageRGB32 m_last_frame;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping;
+    std::deque<std::shared_ptr<const VideoHistoryFrame>> m_frames;
+    size_t m_bytes;
+
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
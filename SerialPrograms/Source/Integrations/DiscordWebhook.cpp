@@ -6,7 +6,6 @@
 
 #include <deque>
 #include <QString>
-#include <QFile>
 #include <QHttpMultiPart>
 #include <QEventLoop>
 #include <QNetworkAccessManager>
@@ -66,9 +65,9 @@ void DiscordWebhookSender::send_json(
             if (!file && !data.isEmpty()){
                 internal_send_json(url, data);
             }else if (file && !data.isEmpty()){
-                internal_send_image_embed(url, data, file->filepath(), file->filename());
+                internal_send_image_embed(url, data, *file);
             }else{
-                internal_send_file(url, file->filepath());
+                internal_send_file(url, *file);
             }
         }
     );
@@ -86,7 +85,7 @@ void DiscordWebhookSender::send_file(
         delay,
         [this, url, file = std::move(file)]{
             throttle();
-            internal_send_file(url, file->filepath());
+            internal_send_file(url, *file);
         }
     );
     logger.log("Scheduling Webhook Message... (queue = " + tostr_u_commas(m_queue.size()) + ")", COLOR_PURPLE);
@@ -166,27 +165,28 @@ void DiscordWebhookSender::internal_send_json(const QUrl& url, const QByteArray&
     process_reply(reply.get());
 }
 
-void DiscordWebhookSender::internal_send_file(const QUrl& url, const std::string& filename){
+void DiscordWebhookSender::internal_send_file(const QUrl& url, PendingFileSend& file){
+    std::shared_ptr<const std::string> contents = file.data();
+    if (!contents){
+        m_logger.log("Unable to load attachment: " + file.filename(), COLOR_RED);
+        return;
+    }
+
     QEventLoop event_loop;
     connect(
         this, &DiscordWebhookSender::stop_event_loop,
         &event_loop, &QEventLoop::quit
     );
 
-    QFile file(QString::fromStdString(filename));
-    if (!file.open(QIODevice::ReadOnly)){
-        m_logger.log("File doesn't exist: " + filename, COLOR_RED);
-        return;
-    }
-
     QNetworkRequest request(url);
 
+    //  "contents" outlives the request. So there's no need to copy it.
     QHttpPart imagePart;
     imagePart.setHeader(
         QNetworkRequest::ContentDispositionHeader,
-        QVariant("form-data; name=\"file1\"; filename=\"" + file.fileName() + "\"")
+        QVariant("form-data; name=\"file1\"; filename=\"" + QString::fromStdString(file.filename()) + "\"")
     );
-    imagePart.setBodyDevice(&file);
+    imagePart.setBody(QByteArray::fromRawData(contents->data(), (int)contents->size()));
 
     QHttpMultiPart multiPart(QHttpMultiPart::FormDataType);
     multiPart.append(imagePart);
@@ -199,27 +199,29 @@ void DiscordWebhookSender::internal_send_file(const QUrl& url, const std::string
     process_reply(reply.get());
 }
 
-void DiscordWebhookSender::internal_send_image_embed(const QUrl& url, const QByteArray& data, const std::string& filepath, const std::string& filename){
+void DiscordWebhookSender::internal_send_image_embed(const QUrl& url, const QByteArray& data, PendingFileSend& file){
+    std::shared_ptr<const std::string> contents = file.data();
+    if (!contents){
+        m_logger.log("Unable to load attachment: " + file.filename() + ". Sending without it.", COLOR_RED);
+        internal_send_json(url, data);
+        return;
+    }
+
     QEventLoop event_loop;
     connect(
         this, &DiscordWebhookSender::stop_event_loop,
         &event_loop, &QEventLoop::quit
     );
 
-    QFile file(QString::fromStdString(filepath));
-    if (!file.open(QIODevice::ReadOnly)){
-        m_logger.log("File doesn't exist: " + filepath, COLOR_RED);
-        return;
-    }
-
     QNetworkRequest request(url);
 
+    //  "contents" outlives the request. So there's no need to copy it.
     QHttpPart imagePart;
     imagePart.setHeader(
         QNetworkRequest::ContentDispositionHeader,
-        QVariant("application/octet-stream; name=file0; filename=" + QString::fromStdString(filename))
+        QVariant("application/octet-stream; name=file0; filename=" + QString::fromStdString(file.filename()))
     );
-    imagePart.setBodyDevice(&file);
+    imagePart.setBody(QByteArray::fromRawData(contents->data(), (int)contents->size()));
 
     QHttpPart jsonPart;
     jsonPart.setHeader(
@@ -60,8 +60,8 @@ private:
 
     void process_reply(QNetworkReply* reply);
     void internal_send_json(const QUrl& url, const QByteArray& data);
-    void internal_send_file(const QUrl& url, const std::string& filename);
-    void internal_send_image_embed(const QUrl& url, const QByteArray& data, const std::string& filepath, const std::string& filename);
+    void internal_send_file(const QUrl& url, PendingFileSend& file);
+    void internal_send_image_embed(const QUrl& url, const QByteArray& data, PendingFileSend& file);
 
 signals:
     void stop_event_loop();
@@ -236,7 +236,9 @@ public:
         if (m_sleepy_client != nullptr){
             if (file){
 //                cout << "Sending: " << file->filepath().toStdString() << endl;
-                m_active_list.emplace(file->filepath(), file);
+                //  Key by the file name. The path isn't known until the
+                //  encoding is done and that happens on the sender thread.
+                m_active_list.emplace(file->filename(), file);
             }
             SleepyDiscordSender::instance().send(embed, channels, delay, messages, std::move(file));
         }else{
@@ -257,7 +259,9 @@ public:
         case SleepyResponse::Disconnected: m_connected = false; break;
         case SleepyResponse::RemoveFile:{
 #if 1
-            auto iter = m_active_list.find(message);
+            std::string filepath = message;
+            std::string filename = filepath.substr(filepath.find_last_of("/\\") + 1);
+            auto iter = m_active_list.find(filename);
 //            cout << "Removing: " << message << endl;
 //            cout << "m_active_list = " << m_active_list.size() << endl;
             if (iter != m_active_list.end()){
@@ -267,7 +271,6 @@ public:
                 msg = "Unknown sent file. (Callback: " + (std::string)enum_str_callback[response] + ")";
 //                color = COLOR_RED;
             }
-            m_active_list.erase(message);
 #else
             bool success = QFile(message).remove();
             if (success){
@@ -341,8 +344,8 @@ public:
 
 private:
     void send_response(SleepyRequest request, char* channel, std::string message, std::shared_ptr<PendingFileSend> file = nullptr){
-        std::string filename = file == nullptr ? "" : file->filepath();
         if ((int)request <= 11){
+            std::string filename = file == nullptr ? "" : file->filepath();
             program_response(request, channel, &message[0], &filename[0]);
         }else{
             send("", channel, std::chrono::milliseconds(0), &message[0], std::move(file));
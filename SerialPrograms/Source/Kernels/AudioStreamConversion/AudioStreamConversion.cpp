@@ -19,6 +19,7 @@ void convert_audio_sint16_to_float_Default(float* f, const int16_t* i, size_t le
 void convert_audio_float_to_sint16_Default(int16_t* i, const float* f, size_t length);
 void convert_audio_sint32_to_float_Default(float* f, const int32_t* i, size_t length, float output_multiplier);
 void convert_audio_float_to_sint32_Default(int32_t* i, const float* f, size_t length);
+void convert_audio_stereo_to_mono_Default(float* mono, const float* stereo, size_t frames);
 
 void convert_audio_uint8_to_float_x86_SSE41(float* f, const uint8_t* i, size_t length, float output_multiplier);
 void convert_audio_float_to_uint8_x86_SSE41(uint8_t* i, const float* f, size_t length);
@@ -26,64 +27,174 @@ void convert_audio_sint16_to_float_x86_SSE41(float* f, const int16_t* i, size_t
 void convert_audio_float_to_sint16_x86_SSE41(int16_t* i, const float* f, size_t length);
 void convert_audio_sint32_to_float_x86_SSE2(float* f, const int32_t* i, size_t length, float output_multiplier);
 void convert_audio_float_to_sint32_x86_SSE2(int32_t* i, const float* f, size_t length);
+void convert_audio_stereo_to_mono_x86_SSE41(float* mono, const float* stereo, size_t frames);
+
+void convert_audio_uint8_to_float_x86_AVX2(float* f, const uint8_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_uint8_x86_AVX2(uint8_t* i, const float* f, size_t length);
+void convert_audio_sint16_to_float_x86_AVX2(float* f, const int16_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_sint16_x86_AVX2(int16_t* i, const float* f, size_t length);
+void convert_audio_sint32_to_float_x86_AVX2(float* f, const int32_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_sint32_x86_AVX2(int32_t* i, const float* f, size_t length);
+void convert_audio_stereo_to_mono_x86_AVX2(float* mono, const float* stereo, size_t frames);
+
+void convert_audio_uint8_to_float_arm64_NEON(float* f, const uint8_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_uint8_arm64_NEON(uint8_t* i, const float* f, size_t length);
+void convert_audio_sint16_to_float_arm64_NEON(float* f, const int16_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_sint16_arm64_NEON(int16_t* i, const float* f, size_t length);
+void convert_audio_sint32_to_float_arm64_NEON(float* f, const int32_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_sint32_arm64_NEON(int32_t* i, const float* f, size_t length);
+void convert_audio_stereo_to_mono_arm64_NEON(float* mono, const float* stereo, size_t frames);
 
 
 
 
 void convert_audio_uint8_to_float(float* f, const uint8_t* i, size_t length, float output_multiplier){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_uint8_to_float_x86_AVX2(f, i, length, output_multiplier);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
         convert_audio_uint8_to_float_x86_SSE41(f, i, length, output_multiplier);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_uint8_to_float_arm64_NEON(f, i, length, output_multiplier);
+        return;
+    }
 #endif
     convert_audio_uint8_to_float_Default(f, i, length, output_multiplier);
 }
 void convert_audio_float_to_uint8(uint8_t* i, const float* f, size_t length){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_float_to_uint8_x86_AVX2(i, f, length);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
         convert_audio_float_to_uint8_x86_SSE41(i, f, length);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_float_to_uint8_arm64_NEON(i, f, length);
+        return;
+    }
 #endif
     convert_audio_float_to_uint8_Default(i, f, length);
 }
 void convert_audio_sint16_to_float(float* f, const int16_t* i, size_t length, float output_multiplier){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_sint16_to_float_x86_AVX2(f, i, length, output_multiplier);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
         convert_audio_sint16_to_float_x86_SSE41(f, i, length, output_multiplier);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_sint16_to_float_arm64_NEON(f, i, length, output_multiplier);
+        return;
+    }
 #endif
     convert_audio_sint16_to_float_Default(f, i, length, output_multiplier);
 }
 void convert_audio_float_to_sint16(int16_t* i, const float* f, size_t length){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_float_to_sint16_x86_AVX2(i, f, length);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
         convert_audio_float_to_sint16_x86_SSE41(i, f, length);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_float_to_sint16_arm64_NEON(i, f, length);
+        return;
+    }
 #endif
     convert_audio_float_to_sint16_Default(i, f, length);
 }
 void convert_audio_sint32_to_float(float* f, const int32_t* i, size_t length, float output_multiplier){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_sint32_to_float_x86_AVX2(f, i, length, output_multiplier);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
         convert_audio_sint32_to_float_x86_SSE2(f, i, length, output_multiplier);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_sint32_to_float_arm64_NEON(f, i, length, output_multiplier);
+        return;
+    }
 #endif
     convert_audio_sint32_to_float_Default(f, i, length, output_multiplier);
 }
 void convert_audio_float_to_sint32(int32_t* i, const float* f, size_t length){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_float_to_sint32_x86_AVX2(i, f, length);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
         convert_audio_float_to_sint32_x86_SSE2(i, f, length);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_float_to_sint32_arm64_NEON(i, f, length);
+        return;
+    }
 #endif
     convert_audio_float_to_sint32_Default(i, f, length);
 }
+void convert_audio_stereo_to_mono(float* mono, const float* stereo, size_t frames){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_stereo_to_mono_x86_AVX2(mono, stereo, frames);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        convert_audio_stereo_to_mono_x86_SSE41(mono, stereo, frames);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_stereo_to_mono_arm64_NEON(mono, stereo, frames);
+        return;
+    }
+#endif
+    convert_audio_stereo_to_mono_Default(mono, stereo, frames);
+}
 
 
 
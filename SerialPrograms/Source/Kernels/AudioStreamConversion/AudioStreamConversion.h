@@ -24,6 +24,10 @@ void convert_audio_float_to_sint16(int16_t* i, const float* f, size_t length);
 void convert_audio_sint32_to_float(float* f, const int32_t* i, size_t length, float output_multiplier);
 void convert_audio_float_to_sint32(int32_t* i, const float* f, size_t length);
 
+//  Average each pair of samples in "stereo" into "mono".
+//  "stereo" has (2 * frames) samples. "mono" has "frames" samples.
+void convert_audio_stereo_to_mono(float* mono, const float* stereo, size_t frames);
+
 
 
 
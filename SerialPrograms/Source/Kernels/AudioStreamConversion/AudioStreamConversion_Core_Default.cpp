@@ -70,6 +70,12 @@ void convert_audio_float_to_sint32_Default(int32_t* i, const float* f, size_t le
     }
 }
 
+void convert_audio_stereo_to_mono_Default(float* mono, const float* stereo, size_t frames){
+    for (size_t c = 0; c < frames; c++){
+        mono[c] = (stereo[2*c + 0] + stereo[2*c + 1]) * 0.5f;
+    }
+}
+
 
 
 
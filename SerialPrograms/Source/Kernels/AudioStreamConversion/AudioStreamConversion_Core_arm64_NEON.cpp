@@ -0,0 +1,164 @@
+/*  Audio Stream Conversion (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <arm_neon.h>
+#include "AudioStreamConversion.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AudioStreamConversion{
+
+
+//  The last (length % 8) samples are done with the default kernels.
+void convert_audio_uint8_to_float_Default(float* f, const uint8_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_uint8_Default(uint8_t* i, const float* f, size_t length);
+void convert_audio_sint16_to_float_Default(float* f, const int16_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_sint16_Default(int16_t* i, const float* f, size_t length);
+void convert_audio_sint32_to_float_Default(float* f, const int32_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_sint32_Default(int32_t* i, const float* f, size_t length);
+void convert_audio_stereo_to_mono_Default(float* mono, const float* stereo, size_t frames);
+
+
+
+void convert_audio_uint8_to_float_arm64_NEON(float* f, const uint8_t* i, size_t length, float output_multiplier){
+    const float32x4_t SCALE = vdupq_n_f32(output_multiplier / 127.f);
+    const float32x4_t SUB = vdupq_n_f32(output_multiplier);
+    const float32x4_t MIN = vdupq_n_f32(-1.0f);
+    const float32x4_t MAX = vdupq_n_f32(1.0f);
+    size_t lc = length / 8;
+    while (lc--){
+        uint16x8_t i0 = vmovl_u8(vld1_u8(i));
+        float32x4_t f0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(i0)));
+        float32x4_t f1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(i0)));
+        f0 = vsubq_f32(vmulq_f32(f0, SCALE), SUB);
+        f1 = vsubq_f32(vmulq_f32(f1, SCALE), SUB);
+        f0 = vminq_f32(vmaxq_f32(f0, MIN), MAX);
+        f1 = vminq_f32(vmaxq_f32(f1, MIN), MAX);
+        vst1q_f32(f + 0, f0);
+        vst1q_f32(f + 4, f1);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_uint8_to_float_Default(f, i, length % 8, output_multiplier);
+}
+void convert_audio_float_to_uint8_arm64_NEON(uint8_t* i, const float* f, size_t length){
+    const float32x4_t ONE = vdupq_n_f32(1.0f);
+    const float32x4_t SCALE = vdupq_n_f32(127.f);
+    const float32x4_t MIN = vdupq_n_f32(0.f);
+    const float32x4_t MAX = vdupq_n_f32(255.f);
+    size_t lc = length / 8;
+    while (lc--){
+        float32x4_t f0 = vld1q_f32(f + 0);
+        float32x4_t f1 = vld1q_f32(f + 4);
+        f0 = vmulq_f32(vaddq_f32(f0, ONE), SCALE);
+        f1 = vmulq_f32(vaddq_f32(f1, ONE), SCALE);
+        f0 = vmaxq_f32(vminq_f32(f0, MAX), MIN);
+        f1 = vmaxq_f32(vminq_f32(f1, MAX), MIN);
+        uint16x8_t i0 = vcombine_u16(
+            vmovn_u32(vcvtnq_u32_f32(f0)),
+            vmovn_u32(vcvtnq_u32_f32(f1))
+        );
+        vst1_u8(i, vmovn_u16(i0));
+        f += 8;
+        i += 8;
+    }
+    convert_audio_float_to_uint8_Default(i, f, length % 8);
+}
+
+void convert_audio_sint16_to_float_arm64_NEON(float* f, const int16_t* i, size_t length, float output_multiplier){
+    const float32x4_t SCALE = vdupq_n_f32(output_multiplier / 32767.f);
+    const float32x4_t MIN = vdupq_n_f32(-1.0f);
+    const float32x4_t MAX = vdupq_n_f32(1.0f);
+    size_t lc = length / 8;
+    while (lc--){
+        int16x8_t i0 = vld1q_s16(i);
+        float32x4_t f0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(i0)));
+        float32x4_t f1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(i0)));
+        f0 = vminq_f32(vmaxq_f32(vmulq_f32(f0, SCALE), MIN), MAX);
+        f1 = vminq_f32(vmaxq_f32(vmulq_f32(f1, SCALE), MIN), MAX);
+        vst1q_f32(f + 0, f0);
+        vst1q_f32(f + 4, f1);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_sint16_to_float_Default(f, i, length % 8, output_multiplier);
+}
+void convert_audio_float_to_sint16_arm64_NEON(int16_t* i, const float* f, size_t length){
+    const float32x4_t SCALE = vdupq_n_f32(32767.f);
+    const float32x4_t MIN = vdupq_n_f32(-32768.f);
+    const float32x4_t MAX = vdupq_n_f32(32767.f);
+    size_t lc = length / 8;
+    while (lc--){
+        float32x4_t f0 = vld1q_f32(f + 0);
+        float32x4_t f1 = vld1q_f32(f + 4);
+        f0 = vmaxq_f32(vminq_f32(vmulq_f32(f0, SCALE), MAX), MIN);
+        f1 = vmaxq_f32(vminq_f32(vmulq_f32(f1, SCALE), MAX), MIN);
+        int16x8_t i0 = vcombine_s16(
+            vqmovn_s32(vcvtnq_s32_f32(f0)),
+            vqmovn_s32(vcvtnq_s32_f32(f1))
+        );
+        vst1q_s16(i, i0);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_float_to_sint16_Default(i, f, length % 8);
+}
+
+void convert_audio_sint32_to_float_arm64_NEON(float* f, const int32_t* i, size_t length, float output_multiplier){
+    const float32x4_t SCALE = vdupq_n_f32(output_multiplier / 2147483647.f);
+    const float32x4_t MIN = vdupq_n_f32(-1.0f);
+    const float32x4_t MAX = vdupq_n_f32(1.0f);
+    size_t lc = length / 8;
+    while (lc--){
+        float32x4_t f0 = vcvtq_f32_s32(vld1q_s32(i + 0));
+        float32x4_t f1 = vcvtq_f32_s32(vld1q_s32(i + 4));
+        f0 = vminq_f32(vmaxq_f32(vmulq_f32(f0, SCALE), MIN), MAX);
+        f1 = vminq_f32(vmaxq_f32(vmulq_f32(f1, SCALE), MIN), MAX);
+        vst1q_f32(f + 0, f0);
+        vst1q_f32(f + 4, f1);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_sint32_to_float_Default(f, i, length % 8, output_multiplier);
+}
+void convert_audio_float_to_sint32_arm64_NEON(int32_t* i, const float* f, size_t length){
+    const float32x4_t SCALE = vdupq_n_f32(2147483647.f);
+    size_t lc = length / 8;
+    while (lc--){
+        //  vcvtnq saturates so there's no need to clamp.
+        float32x4_t f0 = vmulq_f32(vld1q_f32(f + 0), SCALE);
+        float32x4_t f1 = vmulq_f32(vld1q_f32(f + 4), SCALE);
+        vst1q_s32(i + 0, vcvtnq_s32_f32(f0));
+        vst1q_s32(i + 4, vcvtnq_s32_f32(f1));
+        f += 8;
+        i += 8;
+    }
+    convert_audio_float_to_sint32_Default(i, f, length % 8);
+}
+
+void convert_audio_stereo_to_mono_arm64_NEON(float* mono, const float* stereo, size_t frames){
+    const float32x4_t HALF = vdupq_n_f32(0.5f);
+    size_t lc = frames / 8;
+    while (lc--){
+        float32x4x2_t f0 = vld2q_f32(stereo + 0);
+        float32x4x2_t f1 = vld2q_f32(stereo + 8);
+        vst1q_f32(mono + 0, vmulq_f32(vaddq_f32(f0.val[0], f0.val[1]), HALF));
+        vst1q_f32(mono + 4, vmulq_f32(vaddq_f32(f1.val[0], f1.val[1]), HALF));
+        mono += 8;
+        stereo += 16;
+    }
+    convert_audio_stereo_to_mono_Default(mono, stereo, frames % 8);
+}
+
+
+
+
+}
+}
+}
+#endif
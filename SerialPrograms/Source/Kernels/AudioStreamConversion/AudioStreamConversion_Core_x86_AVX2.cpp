@@ -0,0 +1,147 @@
+/*  Audio Stream Conversion (x86 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "AudioStreamConversion.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AudioStreamConversion{
+
+
+//  The last (length % 8) samples are done with the SSE4.1 kernels.
+void convert_audio_uint8_to_float_x86_SSE41(float* f, const uint8_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_uint8_x86_SSE41(uint8_t* i, const float* f, size_t length);
+void convert_audio_sint16_to_float_x86_SSE41(float* f, const int16_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_sint16_x86_SSE41(int16_t* i, const float* f, size_t length);
+void convert_audio_sint32_to_float_x86_SSE2(float* f, const int32_t* i, size_t length, float output_multiplier);
+void convert_audio_float_to_sint32_x86_SSE2(int32_t* i, const float* f, size_t length);
+void convert_audio_stereo_to_mono_x86_SSE41(float* mono, const float* stereo, size_t frames);
+
+
+
+void convert_audio_uint8_to_float_x86_AVX2(float* f, const uint8_t* i, size_t length, float output_multiplier){
+    const __m256 SCALE = _mm256_set1_ps(output_multiplier / 127.f);
+    const __m256 SUB = _mm256_set1_ps(output_multiplier);
+    size_t lc = length / 8;
+    while (lc--){
+        __m256i i0 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)i));
+        __m256 f0 = _mm256_cvtepi32_ps(i0);
+        f0 = _mm256_mul_ps(f0, SCALE);
+        f0 = _mm256_sub_ps(f0, SUB);
+        f0 = _mm256_max_ps(f0, _mm256_set1_ps(-1.0f));
+        f0 = _mm256_min_ps(f0, _mm256_set1_ps(1.0f));
+        _mm256_storeu_ps(f, f0);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_uint8_to_float_x86_SSE41(f, i, length % 8, output_multiplier);
+}
+void convert_audio_float_to_uint8_x86_AVX2(uint8_t* i, const float* f, size_t length){
+    size_t lc = length / 8;
+    while (lc--){
+        __m256 f0 = _mm256_loadu_ps(f);
+        f0 = _mm256_add_ps(f0, _mm256_set1_ps(1.0f));
+        f0 = _mm256_mul_ps(f0, _mm256_set1_ps(127.f));
+        f0 = _mm256_min_ps(f0, _mm256_set1_ps(255.f));
+        f0 = _mm256_max_ps(f0, _mm256_set1_ps(0.f));
+        __m256i i0 = _mm256_cvtps_epi32(f0);
+        __m128i i1 = _mm_packs_epi32(_mm256_castsi256_si128(i0), _mm256_extracti128_si256(i0, 1));
+        i1 = _mm_packus_epi16(i1, i1);
+        _mm_storel_epi64((__m128i*)i, i1);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_float_to_uint8_x86_SSE41(i, f, length % 8);
+}
+
+void convert_audio_sint16_to_float_x86_AVX2(float* f, const int16_t* i, size_t length, float output_multiplier){
+    const __m256 SCALE = _mm256_set1_ps(output_multiplier / 32767.f);
+    size_t lc = length / 8;
+    while (lc--){
+        __m256i i0 = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)i));
+        __m256 f0 = _mm256_cvtepi32_ps(i0);
+        f0 = _mm256_mul_ps(f0, SCALE);
+        f0 = _mm256_max_ps(f0, _mm256_set1_ps(-1.0f));
+        f0 = _mm256_min_ps(f0, _mm256_set1_ps(1.0f));
+        _mm256_storeu_ps(f, f0);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_sint16_to_float_x86_SSE41(f, i, length % 8, output_multiplier);
+}
+void convert_audio_float_to_sint16_x86_AVX2(int16_t* i, const float* f, size_t length){
+    size_t lc = length / 8;
+    while (lc--){
+        __m256 f0 = _mm256_loadu_ps(f);
+        f0 = _mm256_mul_ps(f0, _mm256_set1_ps(32767.f));
+        f0 = _mm256_min_ps(f0, _mm256_set1_ps(32767.f));
+        f0 = _mm256_max_ps(f0, _mm256_set1_ps(-32768.f));
+        __m256i i0 = _mm256_cvtps_epi32(f0);
+        __m128i i1 = _mm_packs_epi32(_mm256_castsi256_si128(i0), _mm256_extracti128_si256(i0, 1));
+        _mm_storeu_si128((__m128i*)i, i1);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_float_to_sint16_x86_SSE41(i, f, length % 8);
+}
+
+void convert_audio_sint32_to_float_x86_AVX2(float* f, const int32_t* i, size_t length, float output_multiplier){
+    const __m256 SCALE = _mm256_set1_ps(output_multiplier / 2147483647.f);
+    size_t lc = length / 8;
+    while (lc--){
+        __m256i i0 = _mm256_loadu_si256((const __m256i*)i);
+        __m256 f0 = _mm256_cvtepi32_ps(i0);
+        f0 = _mm256_mul_ps(f0, SCALE);
+        f0 = _mm256_max_ps(f0, _mm256_set1_ps(-1.0f));
+        f0 = _mm256_min_ps(f0, _mm256_set1_ps(1.0f));
+        _mm256_storeu_ps(f, f0);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_sint32_to_float_x86_SSE2(f, i, length % 8, output_multiplier);
+}
+void convert_audio_float_to_sint32_x86_AVX2(int32_t* i, const float* f, size_t length){
+    size_t lc = length / 8;
+    while (lc--){
+        __m256 f0 = _mm256_loadu_ps(f);
+        f0 = _mm256_mul_ps(f0, _mm256_set1_ps(2147483647.f));
+        f0 = _mm256_min_ps(f0, _mm256_set1_ps(2147483520.f));  //  2^31 - 2^6
+        f0 = _mm256_max_ps(f0, _mm256_set1_ps(-2147483648.f));
+        __m256i i0 = _mm256_cvtps_epi32(f0);
+        _mm256_storeu_si256((__m256i*)i, i0);
+        f += 8;
+        i += 8;
+    }
+    convert_audio_float_to_sint32_x86_SSE2(i, f, length % 8);
+}
+
+void convert_audio_stereo_to_mono_x86_AVX2(float* mono, const float* stereo, size_t frames){
+    size_t lc = frames / 8;
+    while (lc--){
+        __m256 f0 = _mm256_loadu_ps(stereo + 0);
+        __m256 f1 = _mm256_loadu_ps(stereo + 8);
+
+        //  hadd works within 128-bit lanes. Fix up the order afterwards.
+        __m256 s0 = _mm256_hadd_ps(f0, f1);
+        s0 = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(s0), 0xd8));
+        s0 = _mm256_mul_ps(s0, _mm256_set1_ps(0.5f));
+        _mm256_storeu_ps(mono, s0);
+        mono += 8;
+        stereo += 16;
+    }
+    convert_audio_stereo_to_mono_x86_SSE41(mono, stereo, frames % 8);
+}
+
+
+
+
+}
+}
+}
+#endif
@@ -181,6 +181,26 @@ void convert_audio_float_to_sint32_x86_SSE2(int32_t* i, const float* f, size_t l
     }
 }
 
+void convert_audio_stereo_to_mono_x86_SSE41(float* mono, const float* stereo, size_t frames){
+    size_t lc = frames / 4;
+    while (lc--){
+        __m128 f0 = _mm_loadu_ps(stereo + 0);
+        __m128 f1 = _mm_loadu_ps(stereo + 4);
+        f0 = _mm_hadd_ps(f0, f1);
+        f0 = _mm_mul_ps(f0, _mm_set1_ps(0.5f));
+        _mm_storeu_ps(mono, f0);
+        mono += 4;
+        stereo += 8;
+    }
+
+    frames %= 4;
+    while (frames--){
+        mono[0] = (stereo[0] + stereo[1]) * 0.5f;
+        mono += 1;
+        stereo += 2;
+    }
+}
+
 
 
 
@@ -8,7 +8,9 @@
 #define PokemonAutomation_Kernels_SparseBinaryMatrixCore_H
 
 #include <string>
-#include <map>
+#include <vector>
+#include <algorithm>
+#include "Common/Cpp/Containers/AlignedVector.h"
 #include "Kernels_PackedBinaryMatrixCore.h"
 
 namespace PokemonAutomation{
@@ -34,7 +36,10 @@ public:
     SparseBinaryMatrixCore(size_t width, size_t height);
 
     void clear();
-    void set_data(std::map<TileIndex, TileType> data);
+
+    //  Replace the contents with "tiles". "index[i]" is the position of
+    //  "tiles[i]". The indices must be unique, but need not be sorted.
+    void set_data(std::vector<TileIndex> index, AlignedVector<TileType> tiles);
 
     void operator^=(const SparseBinaryMatrixCore& x);
     void operator|=(const SparseBinaryMatrixCore& x);
@@ -58,6 +63,11 @@ public:
     size_t tile_width() const{ return m_tile_width; }
     size_t tile_height() const{ return m_tile_height; }
 
+    //  # of tiles that are stored. Tiles that are not stored are zero.
+    size_t stored_tiles() const{ return m_index.size(); }
+
+    //  The non-const versions insert a zero tile if it isn't already stored.
+    //  This invalidates references to the other tiles.
     const TileType& tile(TileIndex index) const;
           TileType& tile(TileIndex index);
     const TileType& tile(size_t x, size_t y) const;
@@ -79,8 +89,16 @@ private:
     size_t m_logical_height;
     size_t m_tile_width;
     size_t m_tile_height;
-    std::map<TileIndex, TileType> m_data;
 
+    //  The stored tiles sorted by index. (row-major)
+    //  "m_tiles[i]" is the tile at "m_index[i]".
+    std::vector<TileIndex> m_index;
+    AlignedVector<TileType> m_tiles;
+
+    void insert_tile(size_t pos, TileIndex index);
+    template <typename Operation>
+    void merge_union(const SparseBinaryMatrixCore& x, Operation&& operation);
+    void expand_to(const SparseBinaryMatrixCore& x);
 
     static const TileType& ZERO_TILE();
 };
@@ -98,15 +116,20 @@ private:
 
 template <typename Tile> PA_FORCE_INLINE
 const Tile& SparseBinaryMatrixCore<Tile>::tile(TileIndex index) const{
-    auto iter = m_data.find(index);
-    if (iter == m_data.end()){
+    auto iter = std::lower_bound(m_index.begin(), m_index.end(), index);
+    if (iter == m_index.end() || index < *iter){
         return ZERO_TILE();
     }
-    return iter->second;
+    return m_tiles[iter - m_index.begin()];
 }
 template <typename Tile> PA_FORCE_INLINE
 Tile& SparseBinaryMatrixCore<Tile>::tile(TileIndex index){
-    return m_data[index];
+    auto iter = std::lower_bound(m_index.begin(), m_index.end(), index);
+    size_t pos = iter - m_index.begin();
+    if (iter == m_index.end() || index < *iter){
+        insert_tile(pos, index);
+    }
+    return m_tiles[pos];
 }
 template <typename Tile> PA_FORCE_INLINE
 const Tile& SparseBinaryMatrixCore<Tile>::tile(size_t x, size_t y) const{
@@ -7,6 +7,9 @@
 #ifndef PokemonAutomation_Kernels_SparseBinaryMatrixCore_TPP
 #define PokemonAutomation_Kernels_SparseBinaryMatrixCore_TPP
 
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "Kernels_SparseBinaryMatrixCore.h"
 
 #include <iostream>
@@ -28,7 +31,8 @@ SparseBinaryMatrixCore<Tile>::SparseBinaryMatrixCore(SparseBinaryMatrixCore&& x)
     , m_logical_height(x.m_logical_height)
     , m_tile_width(x.m_tile_width)
     , m_tile_height(x.m_tile_height)
-    , m_data(std::move(x.m_data))
+    , m_index(std::move(x.m_index))
+    , m_tiles(std::move(x.m_tiles))
 {
     x.m_logical_width = 0;
     x.m_logical_height = 0;
@@ -41,7 +45,8 @@ void SparseBinaryMatrixCore<Tile>::operator=(SparseBinaryMatrixCore&& x){
     m_logical_height = x.m_logical_height;
     m_tile_width = x.m_tile_width;
     m_tile_height = x.m_tile_height;
-    m_data = std::move(x.m_data);
+    m_index = std::move(x.m_index);
+    m_tiles = std::move(x.m_tiles);
     x.m_logical_width = 0;
     x.m_logical_height = 0;
     x.m_tile_width = 0;
@@ -53,7 +58,8 @@ SparseBinaryMatrixCore<Tile>::SparseBinaryMatrixCore(const SparseBinaryMatrixCor
     , m_logical_height(x.m_logical_height)
     , m_tile_width(x.m_tile_width)
     , m_tile_height(x.m_tile_height)
-    , m_data(x.m_data)
+    , m_index(x.m_index)
+    , m_tiles(x.m_tiles)
 {}
 template <typename Tile>
 void SparseBinaryMatrixCore<Tile>::operator=(const SparseBinaryMatrixCore& x){
@@ -61,7 +67,8 @@ void SparseBinaryMatrixCore<Tile>::operator=(const SparseBinaryMatrixCore& x){
     m_logical_height = x.m_logical_height;
     m_tile_width = x.m_tile_width;
     m_tile_height = x.m_tile_height;
-    m_data = x.m_data;
+    m_index = x.m_index;
+    m_tiles = x.m_tiles;
 }
 
 
@@ -87,41 +94,134 @@ void SparseBinaryMatrixCore<Tile>::clear(){
     m_logical_height = 0;
     m_tile_width = 0;
     m_tile_height = 0;
-    m_data.clear();
+    m_index.clear();
+    m_tiles.clear();
 }
 template <typename Tile>
-void SparseBinaryMatrixCore<Tile>::set_data(std::map<TileIndex, Tile> data){
-    m_data = std::move(data);
+void SparseBinaryMatrixCore<Tile>::set_data(std::vector<TileIndex> index, AlignedVector<Tile> tiles){
+    if (index.size() != tiles.size()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching index and tile counts.");
+    }
+    if (std::is_sorted(index.begin(), index.end())){
+        m_index = std::move(index);
+        m_tiles = std::move(tiles);
+        return;
+    }
+
+    //  Sort the indices and then move the tiles into the same order.
+    std::vector<size_t> order(index.size());
+    for (size_t c = 0; c < order.size(); c++){
+        order[c] = c;
+    }
+    std::sort(
+        order.begin(), order.end(),
+        [&](size_t a, size_t b){ return index[a] < index[b]; }
+    );
+
+    m_index.clear();
+    m_index.reserve(order.size());
+    m_tiles.clear();
+    m_tiles.reserve(order.size());
+    for (size_t c : order){
+        m_index.emplace_back(index[c]);
+        m_tiles.emplace_back(tiles[c]);
+    }
 }
+template <typename Tile>
+void SparseBinaryMatrixCore<Tile>::insert_tile(size_t pos, TileIndex index){
+    m_index.insert(m_index.begin() + pos, index);
+    m_tiles.emplace_back();
+    std::rotate(m_tiles.begin() + pos, m_tiles.end() - 1, m_tiles.end());
+}
+
 
 template <typename Tile>
-void SparseBinaryMatrixCore<Tile>::operator^=(const SparseBinaryMatrixCore& x){
+void SparseBinaryMatrixCore<Tile>::expand_to(const SparseBinaryMatrixCore& x){
     m_logical_width = std::max(m_logical_width, x.m_logical_width);
     m_logical_height = std::max(m_logical_height, x.m_logical_height);
     m_tile_width = std::max(m_tile_width, x.m_tile_width);
     m_tile_height = std::max(m_tile_height, x.m_tile_height);
-    for (const auto& tile : x.m_data){
-        this->tile(tile.first) ^= tile.second;
+}
+template <typename Tile>
+template <typename Operation>
+void SparseBinaryMatrixCore<Tile>::merge_union(const SparseBinaryMatrixCore& x, Operation&& operation){
+    expand_to(x);
+
+    //  Both sides are sorted. Walk them together and build the result in a
+    //  single pass instead of inserting one tile at a time.
+    std::vector<TileIndex> index;
+    AlignedVector<Tile> tiles;
+    index.reserve(m_index.size() + x.m_index.size());
+    tiles.reserve(m_index.size() + x.m_index.size());
+
+    size_t a = 0;
+    size_t b = 0;
+    while (a < m_index.size() && b < x.m_index.size()){
+        if (m_index[a] < x.m_index[b]){
+            index.emplace_back(m_index[a]);
+            tiles.emplace_back(m_tiles[a]);
+            a++;
+        }else if (x.m_index[b] < m_index[a]){
+            index.emplace_back(x.m_index[b]);
+            tiles.emplace_back();
+            operation(tiles.back(), x.m_tiles[b]);
+            b++;
+        }else{
+            index.emplace_back(m_index[a]);
+            tiles.emplace_back(m_tiles[a]);
+            operation(tiles.back(), x.m_tiles[b]);
+            a++;
+            b++;
+        }
+    }
+    for (; a < m_index.size(); a++){
+        index.emplace_back(m_index[a]);
+        tiles.emplace_back(m_tiles[a]);
     }
+    for (; b < x.m_index.size(); b++){
+        index.emplace_back(x.m_index[b]);
+        tiles.emplace_back();
+        operation(tiles.back(), x.m_tiles[b]);
+    }
+
+    m_index = std::move(index);
+    m_tiles = std::move(tiles);
+}
+
+template <typename Tile>
+void SparseBinaryMatrixCore<Tile>::operator^=(const SparseBinaryMatrixCore& x){
+    merge_union(x, [](Tile& tile, const Tile& other){ tile ^= other; });
 }
 template <typename Tile>
 void SparseBinaryMatrixCore<Tile>::operator|=(const SparseBinaryMatrixCore& x){
-    m_logical_width = std::max(m_logical_width, x.m_logical_width);
-    m_logical_height = std::max(m_logical_height, x.m_logical_height);
-    m_tile_width = std::max(m_tile_width, x.m_tile_width);
-    m_tile_height = std::max(m_tile_height, x.m_tile_height);
-    for (const auto& tile : x.m_data){
-        this->tile(tile.first) |= tile.second;
-    }
+    merge_union(x, [](Tile& tile, const Tile& other){ tile |= other; });
 }
 template <typename Tile>
 void SparseBinaryMatrixCore<Tile>::operator&=(const SparseBinaryMatrixCore& x){
-    m_logical_width = std::max(m_logical_width, x.m_logical_width);
-    m_logical_height = std::max(m_logical_height, x.m_logical_height);
-    m_tile_width = std::max(m_tile_width, x.m_tile_width);
-    m_tile_height = std::max(m_tile_height, x.m_tile_height);
-    for (const auto& tile : x.m_data){
-        this->tile(tile.first) &= tile.second;
+    expand_to(x);
+
+    //  Tiles that are missing from either side are zero. So only the tiles
+    //  that are in both survive. Compact them in place.
+    size_t a = 0;
+    size_t b = 0;
+    size_t out = 0;
+    while (a < m_index.size() && b < x.m_index.size()){
+        if (m_index[a] < x.m_index[b]){
+            a++;
+        }else if (x.m_index[b] < m_index[a]){
+            b++;
+        }else{
+            m_index[out] = m_index[a];
+            m_tiles[out] = m_tiles[a];
+            m_tiles[out] &= x.m_tiles[b];
+            out++;
+            a++;
+            b++;
+        }
+    }
+    m_index.erase(m_index.begin() + out, m_index.end());
+    while (m_tiles.size() > out){
+        m_tiles.pop_back();
     }
 }
 
@@ -188,33 +288,43 @@ PackedBinaryMatrixCore<Tile> SparseBinaryMatrixCore<Tile>::submatrix(
 //    cout << "bit_shift_x = " << bit_shift_x << endl;
 //    cout << "bit_shift_y = " << bit_shift_y << endl;
 
-    for (size_t r = 0; r < tile_height; r++){
-        for (size_t c = 0; c < tile_width; c++){
-            //  For tile in the destination matrix, populate it by extracting
-            //  from the 4 tiles that it overlaps in the source.
-            size_t src_x = tile_shift_x + c;
-            size_t src_y = tile_shift_y + r;
-            Tile& tile = ret.tile(c, r);
-
-            //  Upper-left tile is always there.
-            this->tile(src_x, src_y).copy_to_shift_pp(tile, bit_shift_x, bit_shift_y);
-
-            bool shift_x = src_x + 1 < m_tile_width && bit_shift_x != 0;
-            bool shift_y = src_y + 1 < m_tile_height && bit_shift_y != 0;
-
-            //  Upper-right is there only if horizontally misaligned.
-            if (shift_x){
-                this->tile(src_x + 1, src_y).copy_to_shift_np(tile, TILE_WIDTH - bit_shift_x, bit_shift_y);
+    //  Each destination tile is built from up to 4 source tiles. Most of the
+    //  source is empty. So instead of looking up all 4 for every destination
+    //  tile, walk the stored source tiles that overlap the region and scatter
+    //  each one into the destination tiles that it overlaps.
+    size_t src_end_x = tile_shift_x + tile_width + (bit_shift_x != 0 ? 1 : 0);
+    size_t src_end_y = tile_shift_y + tile_height + (bit_shift_y != 0 ? 1 : 0);
+    src_end_x = std::min(src_end_x, m_tile_width);
+    src_end_y = std::min(src_end_y, m_tile_height);
+
+    auto iter = m_index.begin();
+    for (size_t src_y = tile_shift_y; src_y < src_end_y; src_y++){
+        //  The row is stored contiguously.
+        iter = std::lower_bound(iter, m_index.end(), TileIndex(tile_shift_x, src_y));
+        for (; iter != m_index.end() && iter->y() == src_y && iter->x() < src_end_x; ++iter){
+            const Tile& tile = m_tiles[iter - m_index.begin()];
+            size_t src_x = iter->x();
+
+            //  The destination tiles that this tile is the upper-left,
+            //  upper-right, lower-left, and lower-right of.
+            size_t c = src_x - tile_shift_x;
+            size_t r = src_y - tile_shift_y;
+            bool has_c = c < tile_width;
+            bool has_r = r < tile_height;
+            bool has_c1 = bit_shift_x != 0 && c != 0;
+            bool has_r1 = bit_shift_y != 0 && r != 0;
+
+            if (has_c && has_r){
+                tile.copy_to_shift_pp(ret.tile(c, r), bit_shift_x, bit_shift_y);
             }
-
-            //  Lower-left is there only if vertically misaligned.
-            if (shift_y){
-                this->tile(src_x, src_y + 1).copy_to_shift_pn(tile, bit_shift_x, TILE_HEIGHT - bit_shift_y);
+            if (has_c1 && has_r){
+                tile.copy_to_shift_np(ret.tile(c - 1, r), TILE_WIDTH - bit_shift_x, bit_shift_y);
             }
-
-            //  Lower-right if both horizontally and vertically misaligned.
-            if (shift_x && shift_y){
-                this->tile(src_x + 1, src_y + 1).copy_to_shift_nn(tile, TILE_WIDTH - bit_shift_x, TILE_HEIGHT - bit_shift_y);
+            if (has_c && has_r1){
+                tile.copy_to_shift_pn(ret.tile(c, r - 1), bit_shift_x, TILE_HEIGHT - bit_shift_y);
+            }
+            if (has_c1 && has_r1){
+                tile.copy_to_shift_nn(ret.tile(c - 1, r - 1), TILE_WIDTH - bit_shift_x, TILE_HEIGHT - bit_shift_y);
             }
         }
     }
@@ -0,0 +1,133 @@
+/*  Image Convert (HSV32)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageConvert_HSV32.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void convert_rgb32_to_hsv32_Default(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_rgb32_to_hsv32_x64_SSE41(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_rgb32_to_hsv32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_rgb32_to_hsv32_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_rgb32_to_hsv32_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_rgb32_to_hsv32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_rgb32_to_hsv32_x64_AVX512(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_rgb32_to_hsv32_x64_AVX2(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        convert_rgb32_to_hsv32_x64_SSE41(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_rgb32_to_hsv32_arm64_NEON(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+    convert_rgb32_to_hsv32_Default(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+}
+
+
+
+void convert_hsv32_to_rgb32_Default(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_hsv32_to_rgb32_x64_SSE41(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_hsv32_to_rgb32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_hsv32_to_rgb32_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_hsv32_to_rgb32_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_hsv32_to_rgb32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_hsv32_to_rgb32_x64_AVX512(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_hsv32_to_rgb32_x64_AVX2(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        convert_hsv32_to_rgb32_x64_SSE41(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_hsv32_to_rgb32_arm64_NEON(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+    convert_hsv32_to_rgb32_Default(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+}
+
+
+
+}
+}
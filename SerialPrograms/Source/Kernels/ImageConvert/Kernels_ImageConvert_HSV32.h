@@ -0,0 +1,39 @@
+/*  Image Convert (HSV32)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Convert whole images between RGB32 and HSV32.
+ *
+ *  HSV32 pixels are laid out as: alpha (highest bits), H, S, V (lowest bits).
+ *  All three channels are 8 bits. H spans the full hue circle as [0, 256).
+ *  Alpha is copied through unchanged in both directions.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageConvert_HSV32_H
+#define PokemonAutomation_Kernels_ImageConvert_HSV32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  "in" and "out" are row-major. Advance to the next row by "in_bytes_per_row"
+//  and "out_bytes_per_row" respectively. "in" and "out" may be the same buffer.
+void convert_rgb32_to_hsv32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void convert_hsv32_to_rgb32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+
+
+}
+}
+#endif
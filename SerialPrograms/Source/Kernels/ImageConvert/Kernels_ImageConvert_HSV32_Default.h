@@ -0,0 +1,104 @@
+/*  Image Convert (HSV32) (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Per-pixel conversions. These define the exact results that all the
+ *  vectorized kernels must reproduce. The vectorized kernels also use these
+ *  for the pixels left over at the end of each row.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageConvert_HSV32_Default_H
+#define PokemonAutomation_Kernels_ImageConvert_HSV32_Default_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Hue is in units of 1/256 of the circle. Each of the 6 sectors is 256/6 wide.
+//  Hues in the last half-sector (magenta to red) are clamped to 0.
+//
+//  Both divisions are done in float. The numerators and denominators are small
+//  enough that the truncated quotients are exact.
+PA_FORCE_INLINE uint32_t convert_rgb32_to_hsv32_Default(uint32_t pixel){
+    int r = (pixel >> 16) & 0xff;
+    int g = (pixel >>  8) & 0xff;
+    int b = (pixel >>  0) & 0xff;
+
+    int M = std::max(std::max(r, g), b);
+    int m = std::min(std::min(r, g), b);
+    int delta = M - m;
+
+    //  S = 255 - round(255 * m / M)
+    int S = 0;
+    if (M > 0){
+        S = 255 - (int)((float)(m*255 + (M >> 1)) / (float)M);
+    }
+
+    //  H = round(256 * (sector + fraction) / 6)
+    int N;
+    if (M == r){
+        N = g - b;
+    }else if (M == g){
+        N = b - r + 2*delta;
+    }else{
+        N = r - g + 4*delta;
+    }
+    int P = N*256 + 3*delta;
+    int H = 0;
+    if (P > 0){
+        H = (int)((float)P / (float)(6*delta));
+    }
+
+    return (pixel & 0xff000000) | ((uint32_t)H << 16) | ((uint32_t)S << 8) | (uint32_t)M;
+}
+
+
+//  Integer HSV to RGB using:
+//      C = round(V * S / 255)
+//      channel(n) = V - C * clamp(min(k, 4 - k), 0, 1)
+//      k = (n + 6H/256) mod 6
+//  where n is 5, 3, 1 for R, G, B. k is computed in units of 1/256.
+PA_FORCE_INLINE uint32_t convert_hsv32_to_rgb32_channel_Default(int V, int C, int hh, int n){
+    int k = (n*256 + hh) % 1536;
+    int t = std::min(k, 1024 - k);
+    t = std::min(std::max(t, 0), 256);
+    return (uint32_t)(V - ((C*t + 128) >> 8));
+}
+PA_FORCE_INLINE uint32_t convert_hsv32_to_rgb32_Default(uint32_t pixel){
+    int H = (pixel >> 16) & 0xff;
+    int S = (pixel >>  8) & 0xff;
+    int V = (pixel >>  0) & 0xff;
+
+    int C = (V*S + 127) / 255;
+    int hh = H*6;
+
+    uint32_t r = convert_hsv32_to_rgb32_channel_Default(V, C, hh, 5);
+    uint32_t g = convert_hsv32_to_rgb32_channel_Default(V, C, hh, 3);
+    uint32_t b = convert_hsv32_to_rgb32_channel_Default(V, C, hh, 1);
+
+    return (pixel & 0xff000000) | (r << 16) | (g << 8) | b;
+}
+
+
+
+PA_FORCE_INLINE void convert_rgb32_to_hsv32_Default(const uint32_t* in, uint32_t* out, size_t width){
+    for (size_t c = 0; c < width; c++){
+        out[c] = convert_rgb32_to_hsv32_Default(in[c]);
+    }
+}
+PA_FORCE_INLINE void convert_hsv32_to_rgb32_Default(const uint32_t* in, uint32_t* out, size_t width){
+    for (size_t c = 0; c < width; c++){
+        out[c] = convert_hsv32_to_rgb32_Default(in[c]);
+    }
+}
+
+
+}
+}
+#endif
@@ -0,0 +1,129 @@
+/*  Image Convert (HSV32) (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <arm_neon.h>
+#include "Kernels_ImageConvert_HSV32_Default.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  See Kernels_ImageConvert_HSV32_Default.h for the math.
+PA_FORCE_INLINE uint32x4_t convert_rgb32_to_hsv32_arm64_NEON(uint32x4_t pixel){
+    const uint32x4_t MASK = vdupq_n_u32(0xff);
+    int32x4_t r = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixel, 16), MASK));
+    int32x4_t g = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixel, 8), MASK));
+    int32x4_t b = vreinterpretq_s32_u32(vandq_u32(pixel, MASK));
+
+    int32x4_t M = vmaxq_s32(vmaxq_s32(r, g), b);
+    int32x4_t m = vminq_s32(vminq_s32(r, g), b);
+    int32x4_t delta = vsubq_s32(M, m);
+
+    //  S
+    int32x4_t num = vaddq_s32(vsubq_s32(vshlq_n_s32(m, 8), m), vshrq_n_s32(M, 1));
+    int32x4_t S = vcvtq_s32_f32(vdivq_f32(vcvtq_f32_s32(num), vcvtq_f32_s32(M)));
+    S = vsubq_s32(vdupq_n_s32(255), S);
+    S = vandq_s32(S, vreinterpretq_s32_u32(vtstq_s32(M, M)));
+
+    //  H
+    int32x4_t delta2 = vaddq_s32(delta, delta);
+    int32x4_t N = vaddq_s32(vsubq_s32(r, g), vaddq_s32(delta2, delta2));
+    N = vbslq_s32(vceqq_s32(M, g), vaddq_s32(vsubq_s32(b, r), delta2), N);
+    N = vbslq_s32(vceqq_s32(M, r), vsubq_s32(g, b), N);
+    int32x4_t delta3 = vaddq_s32(delta2, delta);
+    int32x4_t P = vaddq_s32(vshlq_n_s32(N, 8), delta3);
+    int32x4_t H = vcvtq_s32_f32(vdivq_f32(
+        vcvtq_f32_s32(P),
+        vcvtq_f32_s32(vaddq_s32(delta3, delta3))
+    ));
+    H = vandq_s32(H, vreinterpretq_s32_u32(vcgtzq_s32(P)));
+
+    pixel = vandq_u32(pixel, vdupq_n_u32(0xff000000));
+    pixel = vorrq_u32(pixel, vshlq_n_u32(vreinterpretq_u32_s32(H), 16));
+    pixel = vorrq_u32(pixel, vshlq_n_u32(vreinterpretq_u32_s32(S), 8));
+    pixel = vorrq_u32(pixel, vreinterpretq_u32_s32(M));
+    return pixel;
+}
+
+PA_FORCE_INLINE int32x4_t convert_hsv32_to_rgb32_channel_arm64_NEON(int32x4_t V, int32x4_t C, int32x4_t hh, int n){
+    int32x4_t k = vaddq_s32(hh, vdupq_n_s32(n * 256));
+    k = vsubq_s32(k, vandq_s32(
+        vreinterpretq_s32_u32(vcgtq_s32(k, vdupq_n_s32(1535))),
+        vdupq_n_s32(1536)
+    ));
+    int32x4_t t = vminq_s32(k, vsubq_s32(vdupq_n_s32(1024), k));
+    t = vminq_s32(vmaxq_s32(t, vdupq_n_s32(0)), vdupq_n_s32(256));
+    return vsubq_s32(V, vshrq_n_s32(vmlaq_s32(vdupq_n_s32(128), C, t), 8));
+}
+PA_FORCE_INLINE uint32x4_t convert_hsv32_to_rgb32_arm64_NEON(uint32x4_t pixel){
+    const uint32x4_t MASK = vdupq_n_u32(0xff);
+    int32x4_t H = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixel, 16), MASK));
+    int32x4_t S = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixel, 8), MASK));
+    int32x4_t V = vreinterpretq_s32_u32(vandq_u32(pixel, MASK));
+
+    //  x / 255 == (x + 1 + (x >> 8)) >> 8 for all x < 65535.
+    int32x4_t x = vmlaq_s32(vdupq_n_s32(127), V, S);
+    int32x4_t C = vshrq_n_s32(vaddq_s32(vaddq_s32(x, vdupq_n_s32(1)), vshrq_n_s32(x, 8)), 8);
+    int32x4_t hh = vmulq_n_s32(H, 6);
+
+    int32x4_t R = convert_hsv32_to_rgb32_channel_arm64_NEON(V, C, hh, 5);
+    int32x4_t G = convert_hsv32_to_rgb32_channel_arm64_NEON(V, C, hh, 3);
+    int32x4_t B = convert_hsv32_to_rgb32_channel_arm64_NEON(V, C, hh, 1);
+
+    pixel = vandq_u32(pixel, vdupq_n_u32(0xff000000));
+    pixel = vorrq_u32(pixel, vshlq_n_u32(vreinterpretq_u32_s32(R), 16));
+    pixel = vorrq_u32(pixel, vshlq_n_u32(vreinterpretq_u32_s32(G), 8));
+    pixel = vorrq_u32(pixel, vreinterpretq_u32_s32(B));
+    return pixel;
+}
+
+
+
+void convert_rgb32_to_hsv32_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t lc = width / 4;
+        const uint32_t* in_ptr = in;
+        uint32_t* out_ptr = out;
+        while (lc--){
+            vst1q_u32(out_ptr, convert_rgb32_to_hsv32_arm64_NEON(vld1q_u32(in_ptr)));
+            in_ptr += 4;
+            out_ptr += 4;
+        }
+        convert_rgb32_to_hsv32_Default(in_ptr, out_ptr, width % 4);
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+void convert_hsv32_to_rgb32_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t lc = width / 4;
+        const uint32_t* in_ptr = in;
+        uint32_t* out_ptr = out;
+        while (lc--){
+            vst1q_u32(out_ptr, convert_hsv32_to_rgb32_arm64_NEON(vld1q_u32(in_ptr)));
+            in_ptr += 4;
+            out_ptr += 4;
+        }
+        convert_hsv32_to_rgb32_Default(in_ptr, out_ptr, width % 4);
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+}
+}
+#endif
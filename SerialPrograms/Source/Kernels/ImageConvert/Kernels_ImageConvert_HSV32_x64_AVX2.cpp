@@ -0,0 +1,129 @@
+/*  Image Convert (HSV32) (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels_ImageConvert_HSV32_Default.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  See Kernels_ImageConvert_HSV32_Default.h for the math.
+PA_FORCE_INLINE __m256i convert_rgb32_to_hsv32_x64_AVX2(__m256i pixel){
+    const __m256i MASK = _mm256_set1_epi32(0xff);
+    __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), MASK);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), MASK);
+    __m256i b = _mm256_and_si256(pixel, MASK);
+
+    __m256i M = _mm256_max_epi32(_mm256_max_epi32(r, g), b);
+    __m256i m = _mm256_min_epi32(_mm256_min_epi32(r, g), b);
+    __m256i delta = _mm256_sub_epi32(M, m);
+
+    //  S
+    __m256i num = _mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(m, 8), m), _mm256_srli_epi32(M, 1));
+    __m256i S = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(num), _mm256_cvtepi32_ps(M)));
+    S = _mm256_sub_epi32(_mm256_set1_epi32(255), S);
+    S = _mm256_andnot_si256(_mm256_cmpeq_epi32(M, _mm256_setzero_si256()), S);
+
+    //  H
+    __m256i delta2 = _mm256_add_epi32(delta, delta);
+    __m256i N = _mm256_add_epi32(_mm256_sub_epi32(r, g), _mm256_add_epi32(delta2, delta2));
+    N = _mm256_blendv_epi8(N, _mm256_add_epi32(_mm256_sub_epi32(b, r), delta2), _mm256_cmpeq_epi32(M, g));
+    N = _mm256_blendv_epi8(N, _mm256_sub_epi32(g, b), _mm256_cmpeq_epi32(M, r));
+    __m256i delta3 = _mm256_add_epi32(delta2, delta);
+    __m256i P = _mm256_add_epi32(_mm256_slli_epi32(N, 8), delta3);
+    __m256i H = _mm256_cvttps_epi32(_mm256_div_ps(
+        _mm256_cvtepi32_ps(P),
+        _mm256_cvtepi32_ps(_mm256_add_epi32(delta3, delta3))
+    ));
+    H = _mm256_and_si256(_mm256_cmpgt_epi32(P, _mm256_setzero_si256()), H);
+
+    pixel = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(H, 16));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(S, 8));
+    pixel = _mm256_or_si256(pixel, M);
+    return pixel;
+}
+
+PA_FORCE_INLINE __m256i convert_hsv32_to_rgb32_channel_x64_AVX2(__m256i V, __m256i C, __m256i hh, int n){
+    __m256i k = _mm256_add_epi32(hh, _mm256_set1_epi32(n * 256));
+    k = _mm256_sub_epi32(k, _mm256_and_si256(_mm256_cmpgt_epi32(k, _mm256_set1_epi32(1535)), _mm256_set1_epi32(1536)));
+    __m256i t = _mm256_min_epi32(k, _mm256_sub_epi32(_mm256_set1_epi32(1024), k));
+    t = _mm256_min_epi32(_mm256_max_epi32(t, _mm256_setzero_si256()), _mm256_set1_epi32(256));
+
+    //  C * t < 2^16 so a 16-bit multiply is enough.
+    __m256i x = _mm256_add_epi32(_mm256_mullo_epi16(C, t), _mm256_set1_epi32(128));
+    return _mm256_sub_epi32(V, _mm256_srli_epi32(x, 8));
+}
+PA_FORCE_INLINE __m256i convert_hsv32_to_rgb32_x64_AVX2(__m256i pixel){
+    const __m256i MASK = _mm256_set1_epi32(0xff);
+    __m256i H = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), MASK);
+    __m256i S = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), MASK);
+    __m256i V = _mm256_and_si256(pixel, MASK);
+
+    //  x / 255 == (x + 1 + (x >> 8)) >> 8 for all x < 65535.
+    __m256i x = _mm256_add_epi32(_mm256_mullo_epi16(V, S), _mm256_set1_epi32(127));
+    __m256i C = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)), _mm256_srli_epi32(x, 8)), 8);
+    __m256i hh = _mm256_mullo_epi16(H, _mm256_set1_epi32(6));
+
+    __m256i R = convert_hsv32_to_rgb32_channel_x64_AVX2(V, C, hh, 5);
+    __m256i G = convert_hsv32_to_rgb32_channel_x64_AVX2(V, C, hh, 3);
+    __m256i B = convert_hsv32_to_rgb32_channel_x64_AVX2(V, C, hh, 1);
+
+    pixel = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(R, 16));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(G, 8));
+    pixel = _mm256_or_si256(pixel, B);
+    return pixel;
+}
+
+
+
+void convert_rgb32_to_hsv32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t lc = width / 8;
+        const __m256i* in_ptr = (const __m256i*)in;
+        __m256i* out_ptr = (__m256i*)out;
+        while (lc--){
+            _mm256_storeu_si256(out_ptr, convert_rgb32_to_hsv32_x64_AVX2(_mm256_loadu_si256(in_ptr)));
+            in_ptr++;
+            out_ptr++;
+        }
+        convert_rgb32_to_hsv32_Default((const uint32_t*)in_ptr, (uint32_t*)out_ptr, width % 8);
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+void convert_hsv32_to_rgb32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t lc = width / 8;
+        const __m256i* in_ptr = (const __m256i*)in;
+        __m256i* out_ptr = (__m256i*)out;
+        while (lc--){
+            _mm256_storeu_si256(out_ptr, convert_hsv32_to_rgb32_x64_AVX2(_mm256_loadu_si256(in_ptr)));
+            in_ptr++;
+            out_ptr++;
+        }
+        convert_hsv32_to_rgb32_Default((const uint32_t*)in_ptr, (uint32_t*)out_ptr, width % 8);
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+}
+}
+#endif
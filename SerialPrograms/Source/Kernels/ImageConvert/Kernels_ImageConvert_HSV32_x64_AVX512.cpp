@@ -0,0 +1,146 @@
+/*  Image Convert (HSV32) (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <immintrin.h>
+#include "Kernels_ImageConvert_HSV32_Default.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  See Kernels_ImageConvert_HSV32_Default.h for the math.
+PA_FORCE_INLINE __m512i convert_rgb32_to_hsv32_x64_AVX512(__m512i pixel){
+    const __m512i MASK = _mm512_set1_epi32(0xff);
+    __m512i r = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), MASK);
+    __m512i g = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), MASK);
+    __m512i b = _mm512_and_si512(pixel, MASK);
+
+    __m512i M = _mm512_max_epi32(_mm512_max_epi32(r, g), b);
+    __m512i m = _mm512_min_epi32(_mm512_min_epi32(r, g), b);
+    __m512i delta = _mm512_sub_epi32(M, m);
+
+    //  S
+    __m512i num = _mm512_add_epi32(_mm512_sub_epi32(_mm512_slli_epi32(m, 8), m), _mm512_srli_epi32(M, 1));
+    __m512i S = _mm512_cvttps_epi32(_mm512_div_ps(_mm512_cvtepi32_ps(num), _mm512_cvtepi32_ps(M)));
+    S = _mm512_maskz_sub_epi32(
+        _mm512_test_epi32_mask(M, M),
+        _mm512_set1_epi32(255), S
+    );
+
+    //  H
+    __m512i delta2 = _mm512_add_epi32(delta, delta);
+    __m512i N = _mm512_add_epi32(_mm512_sub_epi32(r, g), _mm512_add_epi32(delta2, delta2));
+    N = _mm512_mask_add_epi32(N, _mm512_cmpeq_epi32_mask(M, g), _mm512_sub_epi32(b, r), delta2);
+    N = _mm512_mask_sub_epi32(N, _mm512_cmpeq_epi32_mask(M, r), g, b);
+    __m512i delta3 = _mm512_add_epi32(delta2, delta);
+    __m512i P = _mm512_add_epi32(_mm512_slli_epi32(N, 8), delta3);
+    __m512i H = _mm512_maskz_cvttps_epi32(
+        _mm512_cmpgt_epi32_mask(P, _mm512_setzero_si512()),
+        _mm512_div_ps(
+            _mm512_cvtepi32_ps(P),
+            _mm512_cvtepi32_ps(_mm512_add_epi32(delta3, delta3))
+        )
+    );
+
+    pixel = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+    pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(H, 16));
+    pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(S, 8));
+    pixel = _mm512_or_si512(pixel, M);
+    return pixel;
+}
+
+PA_FORCE_INLINE __m512i convert_hsv32_to_rgb32_channel_x64_AVX512(__m512i V, __m512i C, __m512i hh, int n){
+    __m512i k = _mm512_add_epi32(hh, _mm512_set1_epi32(n * 256));
+    k = _mm512_mask_sub_epi32(
+        k, _mm512_cmpgt_epi32_mask(k, _mm512_set1_epi32(1535)),
+        k, _mm512_set1_epi32(1536)
+    );
+    __m512i t = _mm512_min_epi32(k, _mm512_sub_epi32(_mm512_set1_epi32(1024), k));
+    t = _mm512_min_epi32(_mm512_max_epi32(t, _mm512_setzero_si512()), _mm512_set1_epi32(256));
+
+    //  C * t < 2^16 so a 16-bit multiply is enough.
+    __m512i x = _mm512_add_epi32(_mm512_mullo_epi16(C, t), _mm512_set1_epi32(128));
+    return _mm512_sub_epi32(V, _mm512_srli_epi32(x, 8));
+}
+PA_FORCE_INLINE __m512i convert_hsv32_to_rgb32_x64_AVX512(__m512i pixel){
+    const __m512i MASK = _mm512_set1_epi32(0xff);
+    __m512i H = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), MASK);
+    __m512i S = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), MASK);
+    __m512i V = _mm512_and_si512(pixel, MASK);
+
+    //  x / 255 == (x + 1 + (x >> 8)) >> 8 for all x < 65535.
+    __m512i x = _mm512_add_epi32(_mm512_mullo_epi16(V, S), _mm512_set1_epi32(127));
+    __m512i C = _mm512_srli_epi32(_mm512_add_epi32(_mm512_add_epi32(x, _mm512_set1_epi32(1)), _mm512_srli_epi32(x, 8)), 8);
+    __m512i hh = _mm512_mullo_epi16(H, _mm512_set1_epi32(6));
+
+    __m512i R = convert_hsv32_to_rgb32_channel_x64_AVX512(V, C, hh, 5);
+    __m512i G = convert_hsv32_to_rgb32_channel_x64_AVX512(V, C, hh, 3);
+    __m512i B = convert_hsv32_to_rgb32_channel_x64_AVX512(V, C, hh, 1);
+
+    pixel = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+    pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(R, 16));
+    pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(G, 8));
+    pixel = _mm512_or_si512(pixel, B);
+    return pixel;
+}
+
+
+
+void convert_rgb32_to_hsv32_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t lc = width / 16;
+        const uint32_t* in_ptr = in;
+        uint32_t* out_ptr = out;
+        while (lc--){
+            _mm512_storeu_si512(out_ptr, convert_rgb32_to_hsv32_x64_AVX512(_mm512_loadu_si512(in_ptr)));
+            in_ptr += 16;
+            out_ptr += 16;
+        }
+        size_t left = width % 16;
+        if (left){
+            __mmask16 mask = ((uint32_t)1 << left) - 1;
+            __m512i pixel = _mm512_maskz_loadu_epi32(mask, in_ptr);
+            _mm512_mask_storeu_epi32(out_ptr, mask, convert_rgb32_to_hsv32_x64_AVX512(pixel));
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+void convert_hsv32_to_rgb32_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t lc = width / 16;
+        const uint32_t* in_ptr = in;
+        uint32_t* out_ptr = out;
+        while (lc--){
+            _mm512_storeu_si512(out_ptr, convert_hsv32_to_rgb32_x64_AVX512(_mm512_loadu_si512(in_ptr)));
+            in_ptr += 16;
+            out_ptr += 16;
+        }
+        size_t left = width % 16;
+        if (left){
+            __mmask16 mask = ((uint32_t)1 << left) - 1;
+            __m512i pixel = _mm512_maskz_loadu_epi32(mask, in_ptr);
+            _mm512_mask_storeu_epi32(out_ptr, mask, convert_hsv32_to_rgb32_x64_AVX512(pixel));
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+}
+}
+#endif
@@ -0,0 +1,129 @@
+/*  Image Convert (HSV32) (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Kernels_ImageConvert_HSV32_Default.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  See Kernels_ImageConvert_HSV32_Default.h for the math.
+PA_FORCE_INLINE __m128i convert_rgb32_to_hsv32_x64_SSE41(__m128i pixel){
+    const __m128i MASK = _mm_set1_epi32(0xff);
+    __m128i r = _mm_and_si128(_mm_srli_epi32(pixel, 16), MASK);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(pixel, 8), MASK);
+    __m128i b = _mm_and_si128(pixel, MASK);
+
+    __m128i M = _mm_max_epi32(_mm_max_epi32(r, g), b);
+    __m128i m = _mm_min_epi32(_mm_min_epi32(r, g), b);
+    __m128i delta = _mm_sub_epi32(M, m);
+
+    //  S
+    __m128i num = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(m, 8), m), _mm_srli_epi32(M, 1));
+    __m128i S = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(num), _mm_cvtepi32_ps(M)));
+    S = _mm_sub_epi32(_mm_set1_epi32(255), S);
+    S = _mm_andnot_si128(_mm_cmpeq_epi32(M, _mm_setzero_si128()), S);
+
+    //  H
+    __m128i delta2 = _mm_add_epi32(delta, delta);
+    __m128i N = _mm_add_epi32(_mm_sub_epi32(r, g), _mm_add_epi32(delta2, delta2));
+    N = _mm_blendv_epi8(N, _mm_add_epi32(_mm_sub_epi32(b, r), delta2), _mm_cmpeq_epi32(M, g));
+    N = _mm_blendv_epi8(N, _mm_sub_epi32(g, b), _mm_cmpeq_epi32(M, r));
+    __m128i delta3 = _mm_add_epi32(delta2, delta);
+    __m128i P = _mm_add_epi32(_mm_slli_epi32(N, 8), delta3);
+    __m128i H = _mm_cvttps_epi32(_mm_div_ps(
+        _mm_cvtepi32_ps(P),
+        _mm_cvtepi32_ps(_mm_add_epi32(delta3, delta3))
+    ));
+    H = _mm_and_si128(_mm_cmpgt_epi32(P, _mm_setzero_si128()), H);
+
+    pixel = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(H, 16));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(S, 8));
+    pixel = _mm_or_si128(pixel, M);
+    return pixel;
+}
+
+PA_FORCE_INLINE __m128i convert_hsv32_to_rgb32_channel_x64_SSE41(__m128i V, __m128i C, __m128i hh, int n){
+    __m128i k = _mm_add_epi32(hh, _mm_set1_epi32(n * 256));
+    k = _mm_sub_epi32(k, _mm_and_si128(_mm_cmpgt_epi32(k, _mm_set1_epi32(1535)), _mm_set1_epi32(1536)));
+    __m128i t = _mm_min_epi32(k, _mm_sub_epi32(_mm_set1_epi32(1024), k));
+    t = _mm_min_epi32(_mm_max_epi32(t, _mm_setzero_si128()), _mm_set1_epi32(256));
+
+    //  C * t < 2^16 so a 16-bit multiply is enough.
+    __m128i x = _mm_add_epi32(_mm_mullo_epi16(C, t), _mm_set1_epi32(128));
+    return _mm_sub_epi32(V, _mm_srli_epi32(x, 8));
+}
+PA_FORCE_INLINE __m128i convert_hsv32_to_rgb32_x64_SSE41(__m128i pixel){
+    const __m128i MASK = _mm_set1_epi32(0xff);
+    __m128i H = _mm_and_si128(_mm_srli_epi32(pixel, 16), MASK);
+    __m128i S = _mm_and_si128(_mm_srli_epi32(pixel, 8), MASK);
+    __m128i V = _mm_and_si128(pixel, MASK);
+
+    //  x / 255 == (x + 1 + (x >> 8)) >> 8 for all x < 65535.
+    __m128i x = _mm_add_epi32(_mm_mullo_epi16(V, S), _mm_set1_epi32(127));
+    __m128i C = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(x, _mm_set1_epi32(1)), _mm_srli_epi32(x, 8)), 8);
+    __m128i hh = _mm_mullo_epi16(H, _mm_set1_epi32(6));
+
+    __m128i R = convert_hsv32_to_rgb32_channel_x64_SSE41(V, C, hh, 5);
+    __m128i G = convert_hsv32_to_rgb32_channel_x64_SSE41(V, C, hh, 3);
+    __m128i B = convert_hsv32_to_rgb32_channel_x64_SSE41(V, C, hh, 1);
+
+    pixel = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(R, 16));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(G, 8));
+    pixel = _mm_or_si128(pixel, B);
+    return pixel;
+}
+
+
+
+void convert_rgb32_to_hsv32_x64_SSE41(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t lc = width / 4;
+        const __m128i* in_ptr = (const __m128i*)in;
+        __m128i* out_ptr = (__m128i*)out;
+        while (lc--){
+            _mm_storeu_si128(out_ptr, convert_rgb32_to_hsv32_x64_SSE41(_mm_loadu_si128(in_ptr)));
+            in_ptr++;
+            out_ptr++;
+        }
+        convert_rgb32_to_hsv32_Default((const uint32_t*)in_ptr, (uint32_t*)out_ptr, width % 4);
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+void convert_hsv32_to_rgb32_x64_SSE41(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t lc = width / 4;
+        const __m128i* in_ptr = (const __m128i*)in;
+        __m128i* out_ptr = (__m128i*)out;
+        while (lc--){
+            _mm_storeu_si128(out_ptr, convert_hsv32_to_rgb32_x64_SSE41(_mm_loadu_si128(in_ptr)));
+            in_ptr++;
+            out_ptr++;
+        }
+        convert_hsv32_to_rgb32_Default((const uint32_t*)in_ptr, (uint32_t*)out_ptr, width % 4);
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+}
+}
+#endif
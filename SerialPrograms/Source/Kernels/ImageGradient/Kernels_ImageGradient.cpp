@@ -0,0 +1,183 @@
+/*  Image Gradient
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageGradient.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void smooth_rgb32_Default(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void smooth_rgb32_x64_SSE41(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void smooth_rgb32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void smooth_rgb32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        smooth_rgb32_x64_AVX2(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        smooth_rgb32_x64_SSE41(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+    smooth_rgb32_Default(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+}
+
+
+
+void sobel_gradient_rgb32_Default(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void sobel_gradient_rgb32_x64_SSE41(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void sobel_gradient_rgb32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+void sobel_gradient_rgb32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        sobel_gradient_rgb32_x64_AVX2(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        sobel_gradient_rgb32_x64_SSE41(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+        return;
+    }
+#endif
+    sobel_gradient_rgb32_Default(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+}
+
+
+
+size_t sobel_orientation_histogram_rgb32_Default(
+    const uint32_t* in, size_t bytes_per_row,
+    size_t width, size_t height,
+    uint32_t magnitude_sqr_threshold,
+    size_t bins[SOBEL_ORIENTATION_BINS]
+);
+size_t sobel_orientation_histogram_rgb32_x64_SSE41(
+    const uint32_t* in, size_t bytes_per_row,
+    size_t width, size_t height,
+    uint32_t magnitude_sqr_threshold,
+    size_t bins[SOBEL_ORIENTATION_BINS]
+);
+size_t sobel_orientation_histogram_rgb32_x64_AVX2(
+    const uint32_t* in, size_t bytes_per_row,
+    size_t width, size_t height,
+    uint32_t magnitude_sqr_threshold,
+    size_t bins[SOBEL_ORIENTATION_BINS]
+);
+size_t sobel_orientation_histogram_rgb32(
+    const uint32_t* in, size_t bytes_per_row,
+    size_t width, size_t height,
+    uint32_t magnitude_sqr_threshold,
+    size_t bins[SOBEL_ORIENTATION_BINS]
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return sobel_orientation_histogram_rgb32_x64_AVX2(in, bytes_per_row, width, height, magnitude_sqr_threshold, bins);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return sobel_orientation_histogram_rgb32_x64_SSE41(in, bytes_per_row, width, height, magnitude_sqr_threshold, bins);
+    }
+#endif
+    return sobel_orientation_histogram_rgb32_Default(in, bytes_per_row, width, height, magnitude_sqr_threshold, bins);
+}
+
+
+
+double gradient_block_distance_Default(
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    size_t max_offset, size_t block_radius
+);
+double gradient_block_distance_x64_SSE41(
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    size_t max_offset, size_t block_radius
+);
+double gradient_block_distance_x64_AVX2(
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    size_t max_offset, size_t block_radius
+);
+double gradient_block_distance(
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    size_t max_offset, size_t block_radius
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return gradient_block_distance_x64_AVX2(
+            templ, templ_bytes_per_row, templ_width, templ_height,
+            query, query_bytes_per_row, query_width, query_height,
+            max_offset, block_radius
+        );
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return gradient_block_distance_x64_SSE41(
+            templ, templ_bytes_per_row, templ_width, templ_height,
+            query, query_bytes_per_row, query_width, query_height,
+            max_offset, block_radius
+        );
+    }
+#endif
+    return gradient_block_distance_Default(
+        templ, templ_bytes_per_row, templ_width, templ_height,
+        query, query_bytes_per_row, query_width, query_height,
+        max_offset, block_radius
+    );
+}
+
+
+
+}
+}
@@ -0,0 +1,101 @@
+/*  Image Gradient
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Smoothing, Sobel gradients and gradient matching on RGB32 images.
+ *
+ *  In all of these, a pixel is transparent if its alpha is less than 128.
+ *  Transparent pixels never contribute to anything.
+ *
+ *  All images are row-major. Advance to the next row by "bytes_per_row".
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageGradient_H
+#define PokemonAutomation_Kernels_ImageGradient_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Smooth the image with a separable 5-tap filter, first along x then along y.
+//  The filter is {0.062, 0.244, 0.388, 0.244, 0.062} in fixed point.
+//
+//  For each output pixel, the weights of the taps that are transparent or
+//  outside the image are dropped and the rest are renormalized. If all taps
+//  are dropped, the output pixel is 0. Otherwise it is opaque.
+//
+//  "in" and "out" must not overlap.
+void smooth_rgb32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+
+
+//  Run 3x3 Sobel on the sum of the R, G, B channels.
+//
+//  For every pixel whose 3x3 neighborhood is inside the image and fully
+//  opaque, write an opaque pixel with |gx| / 3 in red and |gy| / 3 in green.
+//  Both are clamped to 255. All other pixels are set to 0.
+//
+//  Positive gx is towards +x. Positive gy is towards -y.
+//  Images no larger than 3 pixels in either dimension have no gradients.
+//
+//  "in" and "out" must not overlap.
+void sobel_gradient_rgb32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+);
+
+
+//  Histogram of Sobel gradient orientations. Uses the same (gx, gy) as
+//  sobel_gradient_rgb32() without the division by 3.
+//
+//  Only gradients with gx^2 + gy^2 > "magnitude_sqr_threshold" are counted.
+//  The circle is split into 8 equal bins, starting from the -x direction and
+//  going counter-clockwise. That is, bin = floor((atan2(gy, gx) + pi) / (pi/4))
+//  with pi itself going into the last bin.
+//
+//  The counts are written to "bins". Returns the total count.
+const size_t SOBEL_ORIENTATION_BINS = 8;
+size_t sobel_orientation_histogram_rgb32(
+    const uint32_t* in, size_t bytes_per_row,
+    size_t width, size_t height,
+    uint32_t magnitude_sqr_threshold,
+    size_t bins[SOBEL_ORIENTATION_BINS]
+);
+
+
+//  Distance between two gradient images from sobel_gradient_rgb32().
+//
+//  The distance between two gradient pixels is:
+//      (max(gx0, gx1) * (gx0 - gx1)^2 + max(gy0, gy1) * (gy0 - gy1)^2) / 255
+//
+//  For each opaque pixel of "query", take the block of radius "block_radius"
+//  around it. Shift the block by up to "max_offset" in each direction over
+//  "templ". For each shift, average the pixel distances over the pixels that
+//  are opaque in both images. Keep the smallest average.
+//
+//  Returns the square root of the mean of these over the query pixels.
+//  Returns NaN if no query pixel has anything to compare against.
+//
+//  Block sums are done in 32 bits. So "block_radius" is limited to
+//  GRADIENT_BLOCK_MAX_RADIUS.
+const size_t GRADIENT_BLOCK_MAX_RADIUS = 5;
+double gradient_block_distance(
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    size_t max_offset, size_t block_radius
+);
+
+
+}
+}
+#endif
@@ -0,0 +1,53 @@
+/*  Image Gradient (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels_ImageGradient_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void smooth_rgb32_Default(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    smooth_rgb32<ImageGradient_Default>(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+}
+void sobel_gradient_rgb32_Default(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    sobel_gradient_rgb32<ImageGradient_Default>(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+}
+size_t sobel_orientation_histogram_rgb32_Default(
+    const uint32_t* in, size_t bytes_per_row,
+    size_t width, size_t height,
+    uint32_t magnitude_sqr_threshold,
+    size_t bins[SOBEL_ORIENTATION_BINS]
+){
+    return sobel_orientation_histogram_rgb32<ImageGradient_Default>(
+        in, bytes_per_row, width, height, magnitude_sqr_threshold, bins
+    );
+}
+double gradient_block_distance_Default(
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    size_t max_offset, size_t block_radius
+){
+    return gradient_block_distance<ImageGradient_Default>(
+        templ, templ_bytes_per_row, templ_width, templ_height,
+        query, query_bytes_per_row, query_width, query_height,
+        max_offset, block_radius
+    );
+}
+
+
+}
+}
@@ -0,0 +1,210 @@
+/*  Image Gradient (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Per-pixel versions of the image gradient kernels. These define the exact
+ *  results of the vectorized kernels, which also use them for the pixels
+ *  left over at the end of each row.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageGradient_Default_H
+#define PokemonAutomation_Kernels_ImageGradient_Default_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <algorithm>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Smoothing filter weights. These sum to 1000.
+const int32_t SMOOTH_5TAP_WEIGHTS[5] = {62, 244, 388, 244, 62};
+
+PA_FORCE_INLINE bool image_gradient_is_opaque(uint32_t pixel){
+    return (pixel >> 24) >= 128;
+}
+PA_FORCE_INLINE int32_t image_gradient_luma(uint32_t pixel){
+    return ((pixel >> 16) & 0xff) + ((pixel >> 8) & 0xff) + (pixel & 0xff);
+}
+
+
+//  "taps[k]" is the row of pixels for tap k, or null if tap k is outside the
+//  image. Returns the smoothed pixel at "index".
+PA_FORCE_INLINE uint32_t smooth_5tap_pixel_Default(const uint32_t* const taps[5], size_t index){
+    int32_t den = 0;
+    int32_t r = 0;
+    int32_t g = 0;
+    int32_t b = 0;
+    for (size_t k = 0; k < 5; k++){
+        if (taps[k] == nullptr){
+            continue;
+        }
+        uint32_t pixel = taps[k][index];
+        if (!image_gradient_is_opaque(pixel)){
+            continue;
+        }
+        int32_t weight = SMOOTH_5TAP_WEIGHTS[k];
+        den += weight;
+        r += weight * (int32_t)((pixel >> 16) & 0xff);
+        g += weight * (int32_t)((pixel >>  8) & 0xff);
+        b += weight * (int32_t)((pixel >>  0) & 0xff);
+    }
+    if (den == 0){
+        return 0;
+    }
+
+    //  Round to nearest.
+    r = (2*r + den) / (2*den);
+    g = (2*g + den) / (2*den);
+    b = (2*b + den) / (2*den);
+    return 0xff000000 | ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+}
+
+
+//  Sobel at the center of the 3x3 block whose left column is at "index" of
+//  each of the 3 rows. Returns false if any pixel of the block is transparent.
+PA_FORCE_INLINE bool sobel_pixel_Default(
+    int32_t& gx, int32_t& gy,
+    const uint32_t* row0, const uint32_t* row1, const uint32_t* row2, size_t index
+){
+    const uint32_t* rows[3] = {row0 + index, row1 + index, row2 + index};
+    int32_t luma[3][3];
+    for (size_t r = 0; r < 3; r++){
+        for (size_t c = 0; c < 3; c++){
+            uint32_t pixel = rows[r][c];
+            if (!image_gradient_is_opaque(pixel)){
+                return false;
+            }
+            luma[r][c] = image_gradient_luma(pixel);
+        }
+    }
+    gx = (luma[0][2] - luma[0][0]) + 2*(luma[1][2] - luma[1][0]) + (luma[2][2] - luma[2][0]);
+    gy = (luma[0][0] + 2*luma[0][1] + luma[0][2]) - (luma[2][0] + 2*luma[2][1] + luma[2][2]);
+    return true;
+}
+PA_FORCE_INLINE uint32_t sobel_gradient_pixel_Default(
+    const uint32_t* row0, const uint32_t* row1, const uint32_t* row2, size_t index
+){
+    int32_t gx, gy;
+    if (!sobel_pixel_Default(gx, gy, row0, row1, row2, index)){
+        return 0;
+    }
+    uint32_t x = (uint32_t)std::min(abs((gx + 1) / 3), 255);
+    uint32_t y = (uint32_t)std::min(abs((gy + 1) / 3), 255);
+    return 0xff000000 | (x << 16) | (y << 8);
+}
+
+//  Orientation bin of a gradient. See sobel_orientation_histogram_rgb32().
+//  This matches the atan2() definition exactly for all non-zero gradients.
+PA_FORCE_INLINE size_t sobel_orientation_bin_Default(int32_t gx, int32_t gy){
+    //  Rotate the lower half-plane by 180 degrees onto the upper half-plane.
+    size_t base = 4;
+    if (gy < 0){
+        gx = -gx;
+        gy = -gy;
+        base = 0;
+    }
+    int32_t ax = abs(gx);
+    if (gx > 0){
+        return base + (gy < ax ? 0 : 1);
+    }else{
+        return base + (gy > ax ? 2 : 3);
+    }
+}
+
+
+//  Distance between two gradient pixels without the division by 255.
+//  "count" is set to 1 if both are opaque. Otherwise both outputs are 0.
+PA_FORCE_INLINE void gradient_distance_pixel_Default(
+    uint32_t& dist, uint32_t& count, uint32_t query, uint32_t templ
+){
+    if (!image_gradient_is_opaque(query) || !image_gradient_is_opaque(templ)){
+        dist = 0;
+        count = 0;
+        return;
+    }
+    uint32_t gx = (query >> 16) & 0xff;
+    uint32_t gy = (query >>  8) & 0xff;
+    uint32_t tgx = (templ >> 16) & 0xff;
+    uint32_t tgy = (templ >>  8) & 0xff;
+    uint32_t dx = gx > tgx ? gx - tgx : tgx - gx;
+    uint32_t dy = gy > tgy ? gy - tgy : tgy - gy;
+    dist = std::max(gx, tgx) * dx * dx + std::max(gy, tgy) * dy * dy;
+    count = 1;
+}
+
+
+
+//  Row operations. Each ISA implements a class with the same interface. The
+//  image-level drivers are in Kernels_ImageGradient_Routines.h.
+class ImageGradient_Default{
+public:
+    //  out[c] = smoothed pixel at "c" of "taps".
+    static void smooth_5tap(uint32_t* out, const uint32_t* const taps[5], size_t length){
+        for (size_t c = 0; c < length; c++){
+            out[c] = smooth_5tap_pixel_Default(taps, c);
+        }
+    }
+
+    //  out[c] = gradient pixel of the block whose left column is at "c".
+    static void sobel_gradient(
+        uint32_t* out,
+        const uint32_t* row0, const uint32_t* row1, const uint32_t* row2,
+        size_t length
+    ){
+        for (size_t c = 0; c < length; c++){
+            out[c] = sobel_gradient_pixel_Default(row0, row1, row2, c);
+        }
+    }
+
+    //  Add the orientations of the blocks whose left columns are in
+    //  [0, length) to "bins".
+    static void sobel_histogram(
+        uint32_t bins[8],
+        const uint32_t* row0, const uint32_t* row1, const uint32_t* row2,
+        size_t length, int32_t magnitude_sqr_threshold
+    ){
+        for (size_t c = 0; c < length; c++){
+            int32_t gx, gy;
+            if (!sobel_pixel_Default(gx, gy, row0, row1, row2, c)){
+                continue;
+            }
+            if (gx*gx + gy*gy <= magnitude_sqr_threshold){
+                continue;
+            }
+            bins[sobel_orientation_bin_Default(gx, gy)]++;
+        }
+    }
+
+    //  dist[c], count[c] = distance between query[c] and templ[c].
+    static void gradient_distance(
+        uint32_t* dist, uint32_t* count,
+        const uint32_t* query, const uint32_t* templ,
+        size_t length
+    ){
+        for (size_t c = 0; c < length; c++){
+            gradient_distance_pixel_Default(dist[c], count[c], query[c], templ[c]);
+        }
+    }
+
+    //  out[c] = sum of rows[r][c] over all rows.
+    static void sum_rows(uint32_t* out, const uint32_t* const* rows, size_t row_count, size_t length){
+        for (size_t c = 0; c < length; c++){
+            uint32_t sum = 0;
+            for (size_t r = 0; r < row_count; r++){
+                sum += rows[r][c];
+            }
+            out[c] = sum;
+        }
+    }
+};
+
+
+
+}
+}
+#endif
@@ -0,0 +1,255 @@
+/*  Image Gradient Routines
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Image-level drivers for the image gradient kernels. These are shared by
+ *  all the ISAs, which only provide the row operations.
+ *
+ *  See ImageGradient_Default in Kernels_ImageGradient_Default.h for the
+ *  interface of the row operations.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageGradient_Routines_H
+#define PokemonAutomation_Kernels_ImageGradient_Routines_H
+
+#include <string.h>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels_ImageGradient.h"
+#include "Kernels_ImageGradient_Default.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+template <typename Runner>
+void smooth_rgb32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    if (width == 0 || height == 0){
+        return;
+    }
+
+    std::vector<uint32_t> temp(width * height);
+
+    //  Along x. The 2 pixels at each end have taps outside the image.
+    const size_t x0 = std::min<size_t>(2, width);
+    const size_t x1 = std::max(x0, width < 2 ? 0 : width - 2);
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* row = (const uint32_t*)((const char*)in + r * in_bytes_per_row);
+        uint32_t* temp_row = temp.data() + r * width;
+        auto smooth_edge = [&](size_t x){
+            const uint32_t* taps[5];
+            for (size_t k = 0; k < 5; k++){
+                taps[k] = x + k >= 2 && x + k - 2 < width ? row + x + k - 2 : nullptr;
+            }
+            temp_row[x] = smooth_5tap_pixel_Default(taps, 0);
+        };
+        for (size_t x = 0; x < x0; x++){
+            smooth_edge(x);
+        }
+        if (x0 < x1){
+            const uint32_t* taps[5] = {
+                row + x0 - 2, row + x0 - 1, row + x0, row + x0 + 1, row + x0 + 2,
+            };
+            Runner::smooth_5tap(temp_row + x0, taps, x1 - x0);
+        }
+        for (size_t x = x1; x < width; x++){
+            smooth_edge(x);
+        }
+    }
+
+    //  Along y.
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* taps[5];
+        for (size_t k = 0; k < 5; k++){
+            taps[k] = r + k >= 2 && r + k - 2 < height ? temp.data() + (r + k - 2) * width : nullptr;
+        }
+        Runner::smooth_5tap((uint32_t*)((char*)out + r * out_bytes_per_row), taps, width);
+    }
+}
+
+
+template <typename Runner>
+void sobel_gradient_rgb32(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        memset((char*)out + r * out_bytes_per_row, 0, width * sizeof(uint32_t));
+    }
+    if (width <= 3 || height <= 3){
+        return;
+    }
+    for (size_t r = 1; r + 1 < height; r++){
+        const uint32_t* row0 = (const uint32_t*)((const char*)in + (r - 1) * in_bytes_per_row);
+        const uint32_t* row1 = (const uint32_t*)((const char*)row0 + in_bytes_per_row);
+        const uint32_t* row2 = (const uint32_t*)((const char*)row1 + in_bytes_per_row);
+        uint32_t* out_row = (uint32_t*)((char*)out + r * out_bytes_per_row);
+        Runner::sobel_gradient(out_row + 1, row0, row1, row2, width - 2);
+    }
+}
+
+
+template <typename Runner>
+size_t sobel_orientation_histogram_rgb32(
+    const uint32_t* in, size_t bytes_per_row,
+    size_t width, size_t height,
+    uint32_t magnitude_sqr_threshold,
+    size_t bins[SOBEL_ORIENTATION_BINS]
+){
+    for (size_t c = 0; c < SOBEL_ORIENTATION_BINS; c++){
+        bins[c] = 0;
+    }
+    if (width <= 3 || height <= 3){
+        return 0;
+    }
+
+    //  No gradient has a magnitude over 2^31.
+    int32_t threshold = (int32_t)std::min<uint32_t>(magnitude_sqr_threshold, 0x7fffffff);
+
+    size_t total = 0;
+    for (size_t r = 1; r + 1 < height; r++){
+        const uint32_t* row0 = (const uint32_t*)((const char*)in + (r - 1) * bytes_per_row);
+        const uint32_t* row1 = (const uint32_t*)((const char*)row0 + bytes_per_row);
+        const uint32_t* row2 = (const uint32_t*)((const char*)row1 + bytes_per_row);
+
+        //  Flush per row so the 32-bit counts never overflow.
+        uint32_t row_bins[SOBEL_ORIENTATION_BINS] = {};
+        Runner::sobel_histogram(row_bins, row0, row1, row2, width - 2, threshold);
+        for (size_t c = 0; c < SOBEL_ORIENTATION_BINS; c++){
+            bins[c] += row_bins[c];
+            total += row_bins[c];
+        }
+    }
+    return total;
+}
+
+
+//  For each offset, build the pixel distances between the query and the
+//  shifted template. Then sum them over every block with two box filters.
+//  This replaces the direct search over every block and offset.
+template <typename Runner>
+double gradient_block_distance(
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    size_t max_offset, size_t block_radius
+){
+    const size_t width = query_width;
+    const size_t height = query_height;
+    const size_t block = 2 * block_radius + 1;
+    if (block_radius > GRADIENT_BLOCK_MAX_RADIUS){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Block radius is too large.");
+    }
+
+    //  Per-pixel distances and counts, padded by "block_radius" with zeros.
+    const size_t padded_width = width + 2 * block_radius;
+    const size_t padded_height = height + 2 * block_radius;
+    std::vector<uint32_t> dist(padded_width * padded_height);
+    std::vector<uint32_t> count(padded_width * padded_height);
+
+    //  Block sums along x only. Also padded along y.
+    std::vector<uint32_t> dist_x(width * padded_height);
+    std::vector<uint32_t> count_x(width * padded_height);
+
+    //  Full block sums of one row.
+    std::vector<uint32_t> dist_block(width);
+    std::vector<uint32_t> count_block(width);
+
+    //  Best block score of each query pixel.
+    std::vector<double> best(width * height, DBL_MAX);
+
+    std::vector<const uint32_t*> taps(block);
+
+    const ptrdiff_t offset_range = (ptrdiff_t)max_offset;
+    for (ptrdiff_t oy = -offset_range; oy <= offset_range; oy++){
+        for (ptrdiff_t ox = -offset_range; ox <= offset_range; ox++){
+            //  The query pixels whose shifted position is inside the template.
+            ptrdiff_t x0 = std::max<ptrdiff_t>(0, -ox);
+            ptrdiff_t x1 = std::min<ptrdiff_t>((ptrdiff_t)width, (ptrdiff_t)templ_width - ox);
+            for (size_t r = 0; r < height; r++){
+                uint32_t* dist_row = dist.data() + (r + block_radius) * padded_width + block_radius;
+                uint32_t* count_row = count.data() + (r + block_radius) * padded_width + block_radius;
+                ptrdiff_t ty = (ptrdiff_t)r + oy;
+                if (ty < 0 || ty >= (ptrdiff_t)templ_height || x0 >= x1){
+                    memset(dist_row, 0, width * sizeof(uint32_t));
+                    memset(count_row, 0, width * sizeof(uint32_t));
+                    continue;
+                }
+                memset(dist_row, 0, x0 * sizeof(uint32_t));
+                memset(count_row, 0, x0 * sizeof(uint32_t));
+                memset(dist_row + x1, 0, (width - x1) * sizeof(uint32_t));
+                memset(count_row + x1, 0, (width - x1) * sizeof(uint32_t));
+                const uint32_t* query_row = (const uint32_t*)((const char*)query + r * query_bytes_per_row);
+                const uint32_t* templ_row = (const uint32_t*)((const char*)templ + ty * templ_bytes_per_row);
+                Runner::gradient_distance(
+                    dist_row + x0, count_row + x0,
+                    query_row + x0, templ_row + x0 + ox,
+                    x1 - x0
+                );
+            }
+
+            //  Sum along x.
+            for (size_t r = 0; r < padded_height; r++){
+                for (size_t k = 0; k < block; k++){
+                    taps[k] = dist.data() + r * padded_width + k;
+                }
+                Runner::sum_rows(dist_x.data() + r * width, taps.data(), block, width);
+                for (size_t k = 0; k < block; k++){
+                    taps[k] = count.data() + r * padded_width + k;
+                }
+                Runner::sum_rows(count_x.data() + r * width, taps.data(), block, width);
+            }
+
+            //  Sum along y and keep the best block of each pixel.
+            for (size_t r = 0; r < height; r++){
+                for (size_t k = 0; k < block; k++){
+                    taps[k] = dist_x.data() + (r + k) * width;
+                }
+                Runner::sum_rows(dist_block.data(), taps.data(), block, width);
+                for (size_t k = 0; k < block; k++){
+                    taps[k] = count_x.data() + (r + k) * width;
+                }
+                Runner::sum_rows(count_block.data(), taps.data(), block, width);
+
+                double* best_row = best.data() + r * width;
+                for (size_t c = 0; c < width; c++){
+                    if (count_block[c] == 0){
+                        continue;
+                    }
+                    double score = dist_block[c] / 255. / count_block[c];
+                    best_row[c] = std::min(best_row[c], score);
+                }
+            }
+        }
+    }
+
+    double score = 0;
+    size_t num_gradients = 0;
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* query_row = (const uint32_t*)((const char*)query + r * query_bytes_per_row);
+        const double* best_row = best.data() + r * width;
+        for (size_t c = 0; c < width; c++){
+            if (!image_gradient_is_opaque(query_row[c]) || best_row[c] == DBL_MAX){
+                continue;
+            }
+            score += best_row[c];
+            num_gradients++;
+        }
+    }
+    return std::sqrt(score / num_gradients);
+}
+
+
+
+}
+}
+#endif
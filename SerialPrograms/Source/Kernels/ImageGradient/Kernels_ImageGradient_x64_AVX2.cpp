@@ -0,0 +1,290 @@
+/*  Image Gradient (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels_ImageGradient_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  The sum of the R, G, B channels of each pixel.
+PA_FORCE_INLINE __m256i image_gradient_luma_x64_AVX2(__m256i pixel){
+    pixel = _mm256_and_si256(pixel, _mm256_set1_epi32(0x00ffffff));
+    pixel = _mm256_maddubs_epi16(pixel, _mm256_set1_epi8(1));
+    return _mm256_madd_epi16(pixel, _mm256_set1_epi16(1));
+}
+
+//  Sobel of the blocks whose left columns start at the given pointers.
+//  "valid" is all ones for the blocks that are fully opaque.
+PA_FORCE_INLINE void sobel_x64_AVX2(
+    __m256i& gx, __m256i& gy, __m256i& valid,
+    const uint32_t* row0, const uint32_t* row1, const uint32_t* row2
+){
+    __m256i p00 = _mm256_loadu_si256((const __m256i*)(row0 + 0));
+    __m256i p01 = _mm256_loadu_si256((const __m256i*)(row0 + 1));
+    __m256i p02 = _mm256_loadu_si256((const __m256i*)(row0 + 2));
+    __m256i p10 = _mm256_loadu_si256((const __m256i*)(row1 + 0));
+    __m256i p12 = _mm256_loadu_si256((const __m256i*)(row1 + 2));
+    __m256i p20 = _mm256_loadu_si256((const __m256i*)(row2 + 0));
+    __m256i p21 = _mm256_loadu_si256((const __m256i*)(row2 + 1));
+    __m256i p22 = _mm256_loadu_si256((const __m256i*)(row2 + 2));
+
+    //  Opaque means the top bit of alpha is set.
+    __m256i all = _mm256_and_si256(p00, p01);
+    all = _mm256_and_si256(all, p02);
+    all = _mm256_and_si256(all, p10);
+    all = _mm256_and_si256(all, _mm256_loadu_si256((const __m256i*)(row1 + 1)));
+    all = _mm256_and_si256(all, p12);
+    all = _mm256_and_si256(all, p20);
+    all = _mm256_and_si256(all, p21);
+    all = _mm256_and_si256(all, p22);
+    valid = _mm256_srai_epi32(all, 31);
+
+    __m256i l00 = image_gradient_luma_x64_AVX2(p00);
+    __m256i l01 = image_gradient_luma_x64_AVX2(p01);
+    __m256i l02 = image_gradient_luma_x64_AVX2(p02);
+    __m256i l10 = image_gradient_luma_x64_AVX2(p10);
+    __m256i l12 = image_gradient_luma_x64_AVX2(p12);
+    __m256i l20 = image_gradient_luma_x64_AVX2(p20);
+    __m256i l21 = image_gradient_luma_x64_AVX2(p21);
+    __m256i l22 = image_gradient_luma_x64_AVX2(p22);
+
+    __m256i d1 = _mm256_sub_epi32(l12, l10);
+    gx = _mm256_add_epi32(_mm256_sub_epi32(l02, l00), _mm256_sub_epi32(l22, l20));
+    gx = _mm256_add_epi32(gx, _mm256_add_epi32(d1, d1));
+
+    __m256i top = _mm256_add_epi32(_mm256_add_epi32(l00, l02), _mm256_add_epi32(l01, l01));
+    __m256i bot = _mm256_add_epi32(_mm256_add_epi32(l20, l22), _mm256_add_epi32(l21, l21));
+    gy = _mm256_sub_epi32(top, bot);
+}
+
+//  min(|x + 1| / 3, 255). For |x + 1| < 2^16, n / 3 == (n * 0xaaab) >> 17.
+PA_FORCE_INLINE __m256i sobel_scale_x64_AVX2(__m256i x){
+    x = _mm256_abs_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)));
+    x = _mm256_srli_epi32(_mm256_mulhi_epu16(x, _mm256_set1_epi32(0xaaab)), 1);
+    return _mm256_min_epi32(x, _mm256_set1_epi32(255));
+}
+
+
+
+class ImageGradient_x64_AVX2{
+public:
+    static const size_t VECTOR_SIZE = 8;
+
+public:
+    static void smooth_5tap(uint32_t* out, const uint32_t* const taps[5], size_t length){
+        const __m256i MASK = _mm256_set1_epi32(0xff);
+        size_t c = 0;
+        for (; c + VECTOR_SIZE <= length; c += VECTOR_SIZE){
+            __m256i den = _mm256_setzero_si256();
+            __m256i r = _mm256_setzero_si256();
+            __m256i g = _mm256_setzero_si256();
+            __m256i b = _mm256_setzero_si256();
+            for (size_t k = 0; k < 5; k++){
+                if (taps[k] == nullptr){
+                    continue;
+                }
+                __m256i pixel = _mm256_loadu_si256((const __m256i*)(taps[k] + c));
+                __m256i weight = _mm256_and_si256(
+                    _mm256_srai_epi32(pixel, 31),
+                    _mm256_set1_epi32(SMOOTH_5TAP_WEIGHTS[k])
+                );
+                den = _mm256_add_epi32(den, weight);
+
+                //  Both the channel and the weight fit in the low 16 bits.
+                r = _mm256_add_epi32(r, _mm256_madd_epi16(_mm256_and_si256(_mm256_srli_epi32(pixel, 16), MASK), weight));
+                g = _mm256_add_epi32(g, _mm256_madd_epi16(_mm256_and_si256(_mm256_srli_epi32(pixel, 8), MASK), weight));
+                b = _mm256_add_epi32(b, _mm256_madd_epi16(_mm256_and_si256(pixel, MASK), weight));
+            }
+
+            //  (2*x + den) / (2*den) in float. The operands are small enough
+            //  that the truncated quotient is exact.
+            __m256 den2 = _mm256_cvtepi32_ps(_mm256_add_epi32(den, den));
+            r = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_add_epi32(r, r), den)), den2));
+            g = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_add_epi32(g, g), den)), den2));
+            b = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_add_epi32(b, b), den)), den2));
+
+            __m256i pixel = _mm256_or_si256(_mm256_slli_epi32(r, 16), _mm256_slli_epi32(g, 8));
+            pixel = _mm256_or_si256(pixel, b);
+            pixel = _mm256_or_si256(pixel, _mm256_set1_epi32(0xff000000));
+            pixel = _mm256_andnot_si256(_mm256_cmpeq_epi32(den, _mm256_setzero_si256()), pixel);
+            _mm256_storeu_si256((__m256i*)(out + c), pixel);
+        }
+        for (; c < length; c++){
+            out[c] = smooth_5tap_pixel_Default(taps, c);
+        }
+    }
+
+    static void sobel_gradient(
+        uint32_t* out,
+        const uint32_t* row0, const uint32_t* row1, const uint32_t* row2,
+        size_t length
+    ){
+        size_t c = 0;
+        for (; c + VECTOR_SIZE <= length; c += VECTOR_SIZE){
+            __m256i gx, gy, valid;
+            sobel_x64_AVX2(gx, gy, valid, row0 + c, row1 + c, row2 + c);
+            __m256i pixel = _mm256_or_si256(
+                _mm256_slli_epi32(sobel_scale_x64_AVX2(gx), 16),
+                _mm256_slli_epi32(sobel_scale_x64_AVX2(gy), 8)
+            );
+            pixel = _mm256_or_si256(pixel, _mm256_set1_epi32(0xff000000));
+            _mm256_storeu_si256((__m256i*)(out + c), _mm256_and_si256(pixel, valid));
+        }
+        for (; c < length; c++){
+            out[c] = sobel_gradient_pixel_Default(row0, row1, row2, c);
+        }
+    }
+
+    static void sobel_histogram(
+        uint32_t bins[8],
+        const uint32_t* row0, const uint32_t* row1, const uint32_t* row2,
+        size_t length, int32_t magnitude_sqr_threshold
+    ){
+        const __m256i threshold = _mm256_set1_epi32(magnitude_sqr_threshold);
+        __m256i counts[8];
+        for (size_t b = 0; b < 8; b++){
+            counts[b] = _mm256_setzero_si256();
+        }
+
+        size_t c = 0;
+        for (; c + VECTOR_SIZE <= length; c += VECTOR_SIZE){
+            __m256i gx, gy, valid;
+            sobel_x64_AVX2(gx, gy, valid, row0 + c, row1 + c, row2 + c);
+
+            __m256i mag = _mm256_add_epi32(_mm256_mullo_epi32(gx, gx), _mm256_mullo_epi32(gy, gy));
+            valid = _mm256_and_si256(valid, _mm256_cmpgt_epi32(mag, threshold));
+
+            //  Same as sobel_orientation_bin_Default().
+            __m256i lower = _mm256_cmpgt_epi32(_mm256_setzero_si256(), gy);
+            __m256i x = _mm256_sub_epi32(_mm256_xor_si256(gx, lower), lower);
+            __m256i ax = _mm256_abs_epi32(gx);
+            __m256i ay = _mm256_abs_epi32(gy);
+            __m256i right = _mm256_blendv_epi8(
+                _mm256_add_epi32(_mm256_set1_epi32(3), _mm256_cmpgt_epi32(ay, ax)),
+                _mm256_add_epi32(_mm256_set1_epi32(1), _mm256_cmpgt_epi32(ax, ay)),
+                _mm256_cmpgt_epi32(x, _mm256_setzero_si256())
+            );
+            __m256i bin = _mm256_add_epi32(right, _mm256_andnot_si256(lower, _mm256_set1_epi32(4)));
+
+            for (size_t b = 0; b < 8; b++){
+                __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi32(bin, _mm256_set1_epi32((int)b)), valid);
+                counts[b] = _mm256_sub_epi32(counts[b], hit);
+            }
+        }
+
+        for (size_t b = 0; b < 8; b++){
+            uint32_t lanes[VECTOR_SIZE];
+            _mm256_storeu_si256((__m256i*)lanes, counts[b]);
+            for (size_t i = 0; i < VECTOR_SIZE; i++){
+                bins[b] += lanes[i];
+            }
+        }
+
+        ImageGradient_Default::sobel_histogram(
+            bins, row0 + c, row1 + c, row2 + c,
+            length - c, magnitude_sqr_threshold
+        );
+    }
+
+    static void gradient_distance(
+        uint32_t* dist, uint32_t* count,
+        const uint32_t* query, const uint32_t* templ,
+        size_t length
+    ){
+        const __m256i MASK = _mm256_set1_epi32(0xff);
+        size_t c = 0;
+        for (; c + VECTOR_SIZE <= length; c += VECTOR_SIZE){
+            __m256i q = _mm256_loadu_si256((const __m256i*)(query + c));
+            __m256i t = _mm256_loadu_si256((const __m256i*)(templ + c));
+            __m256i valid = _mm256_srai_epi32(_mm256_and_si256(q, t), 31);
+
+            __m256i gx = _mm256_and_si256(_mm256_srli_epi32(q, 16), MASK);
+            __m256i gy = _mm256_and_si256(_mm256_srli_epi32(q, 8), MASK);
+            __m256i tgx = _mm256_and_si256(_mm256_srli_epi32(t, 16), MASK);
+            __m256i tgy = _mm256_and_si256(_mm256_srli_epi32(t, 8), MASK);
+
+            //  |d| < 2^8 so the squares can use a 16-bit multiply-add.
+            __m256i dx = _mm256_abs_epi32(_mm256_sub_epi32(gx, tgx));
+            __m256i dy = _mm256_abs_epi32(_mm256_sub_epi32(gy, tgy));
+            dx = _mm256_mullo_epi32(_mm256_madd_epi16(dx, dx), _mm256_max_epi32(gx, tgx));
+            dy = _mm256_mullo_epi32(_mm256_madd_epi16(dy, dy), _mm256_max_epi32(gy, tgy));
+
+            _mm256_storeu_si256((__m256i*)(dist + c), _mm256_and_si256(_mm256_add_epi32(dx, dy), valid));
+            _mm256_storeu_si256((__m256i*)(count + c), _mm256_srli_epi32(valid, 31));
+        }
+        for (; c < length; c++){
+            gradient_distance_pixel_Default(dist[c], count[c], query[c], templ[c]);
+        }
+    }
+
+    static void sum_rows(uint32_t* out, const uint32_t* const* rows, size_t row_count, size_t length){
+        size_t c = 0;
+        for (; c + VECTOR_SIZE <= length; c += VECTOR_SIZE){
+            __m256i sum = _mm256_setzero_si256();
+            for (size_t r = 0; r < row_count; r++){
+                sum = _mm256_add_epi32(sum, _mm256_loadu_si256((const __m256i*)(rows[r] + c)));
+            }
+            _mm256_storeu_si256((__m256i*)(out + c), sum);
+        }
+        for (; c < length; c++){
+            uint32_t sum = 0;
+            for (size_t r = 0; r < row_count; r++){
+                sum += rows[r][c];
+            }
+            out[c] = sum;
+        }
+    }
+};
+
+
+
+void smooth_rgb32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    smooth_rgb32<ImageGradient_x64_AVX2>(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+}
+void sobel_gradient_rgb32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    size_t width, size_t height
+){
+    sobel_gradient_rgb32<ImageGradient_x64_AVX2>(in, in_bytes_per_row, out, out_bytes_per_row, width, height);
+}
+size_t sobel_orientation_histogram_rgb32_x64_AVX2(
+    const uint32_t* in, size_t bytes_per_row,
+    size_t width, size_t height,
+    uint32_t magnitude_sqr_threshold,
+    size_t bins[SOBEL_ORIENTATION_BINS]
+){
+    return sobel_orientation_histogram_rgb32<ImageGradient_x64_AVX2>(
+        in, bytes_per_row, width, height, magnitude_sqr_threshold, bins
+    );
+}
+double gradient_block_distance_x64_AVX2(
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    size_t max_offset, size_t block_radius
+){
+    return gradient_block_distance<ImageGradient_x64_AVX2>(
+        templ, templ_bytes_per_row, templ_width, templ_height,
+        query, query_bytes_per_row, query_width, query_height,
+        max_offset, block_radius
+    );
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,56 @@
+/*  Halve Image
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageScale_Halve.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void halve_image_Default(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+);
+void halve_image_x64_SSE41(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+);
+void halve_image_x64_AVX2(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+);
+
+
+
+void halve_image(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        halve_image_x64_AVX2(width, height, in, in_bytes_per_row, out, out_bytes_per_row);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        halve_image_x64_SSE41(width, height, in, in_bytes_per_row, out, out_bytes_per_row);
+        return;
+    }
+#endif
+    halve_image_Default(width, height, in, in_bytes_per_row, out, out_bytes_per_row);
+}
+
+
+
+
+}
+}
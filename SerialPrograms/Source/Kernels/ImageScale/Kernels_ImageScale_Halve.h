@@ -0,0 +1,30 @@
+/*  Halve Image
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageScale_Halve_H
+#define PokemonAutomation_Kernels_ImageScale_Halve_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+// Shrink an image to half the width and height. Each output pixel is the rounded average of a 2x2 block
+// of input pixels, done independently for all 4 channels.
+// "width" and "height" are the dimensions of the input. The output is (width / 2) x (height / 2). If the
+// input has an odd number of rows or columns, the last one is dropped.
+// Both images are row-major; advance to the next row by a step size of `in_bytes_per_row` and `out_bytes_per_row`.
+void halve_image(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+);
+
+
+}
+}
+#endif
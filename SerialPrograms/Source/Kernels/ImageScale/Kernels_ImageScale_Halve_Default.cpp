@@ -0,0 +1,33 @@
+/*  Halve Image (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Kernels_ImageScale_Halve_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void halve_image_Default(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    size_t out_width = width / 2;
+    size_t out_height = height / 2;
+    for (size_t r = 0; r < out_height; r++){
+        const uint32_t* row0 = (const uint32_t*)((const char*)in + 2*r * in_bytes_per_row);
+        const uint32_t* row1 = (const uint32_t*)((const char*)row0 + in_bytes_per_row);
+        halve_row_tail(0, out_width, row0, row1, out);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
@@ -0,0 +1,40 @@
+/*  Halve Image Routines
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageScale_Halve_Routines_H
+#define PokemonAutomation_Kernels_ImageScale_Halve_Routines_H
+
+#include <stdint.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Average a 2x2 block of pixels. Odd and even channels are summed
+//  separately so that each channel has 16 bits of room.
+PA_FORCE_INLINE uint32_t halve_pixel(uint32_t a, uint32_t b, uint32_t c, uint32_t d){
+    const uint32_t MASK = 0x00ff00ff;
+    uint32_t even = (a & MASK) + (b & MASK) + (c & MASK) + (d & MASK) + 0x00020002;
+    uint32_t odd = ((a >> 8) & MASK) + ((b >> 8) & MASK) + ((c >> 8) & MASK) + ((d >> 8) & MASK) + 0x00020002;
+    return ((even >> 2) & MASK) | (((odd >> 2) & MASK) << 8);
+}
+
+//  Halve the tail of a row starting from output pixel "c".
+PA_FORCE_INLINE void halve_row_tail(
+    size_t c, size_t out_width,
+    const uint32_t* row0, const uint32_t* row1,
+    uint32_t* out
+){
+    for (; c < out_width; c++){
+        out[c] = halve_pixel(row0[2*c], row0[2*c + 1], row1[2*c], row1[2*c + 1]);
+    }
+}
+
+
+}
+}
+#endif
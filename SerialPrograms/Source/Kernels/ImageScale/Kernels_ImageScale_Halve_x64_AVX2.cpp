@@ -0,0 +1,62 @@
+/*  Halve Image (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <stdint.h>
+#include <stddef.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImageScale_Halve_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Halve 8 pixels from each of two rows into 4 output pixels.
+PA_FORCE_INLINE __m128i halve_x8_x64_AVX2(const uint32_t* row0, const uint32_t* row1){
+    __m256i a = _mm256_loadu_si256((const __m256i*)row0);
+    __m256i b = _mm256_loadu_si256((const __m256i*)row1);
+
+    //  Vertical sums as 16-bit.
+    __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+    __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+
+    //  Horizontal sums. Each 128-bit lane does 2 output pixels.
+    __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+    sum = _mm256_add_epi16(sum, _mm256_set1_epi16(2));
+    sum = _mm256_srli_epi16(sum, 2);
+
+    sum = _mm256_packus_epi16(sum, sum);
+    sum = _mm256_permute4x64_epi64(sum, 0x08);
+    return _mm256_castsi256_si128(sum);
+}
+
+void halve_image_x64_AVX2(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    size_t out_width = width / 2;
+    size_t out_height = height / 2;
+    for (size_t r = 0; r < out_height; r++){
+        const uint32_t* row0 = (const uint32_t*)((const char*)in + 2*r * in_bytes_per_row);
+        const uint32_t* row1 = (const uint32_t*)((const char*)row0 + in_bytes_per_row);
+        size_t c = 0;
+        for (; c + 4 <= out_width; c += 4){
+            _mm_storeu_si128((__m128i*)(out + c), halve_x8_x64_AVX2(row0 + 2*c, row1 + 2*c));
+        }
+        halve_row_tail(c, out_width, row0, row1, out);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
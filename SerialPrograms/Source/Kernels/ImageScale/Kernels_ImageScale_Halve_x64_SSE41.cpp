@@ -0,0 +1,62 @@
+/*  Halve Image (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <stdint.h>
+#include <stddef.h>
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImageScale_Halve_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Halve 4 pixels from each of two rows. The 2 output pixels are in the lower half.
+PA_FORCE_INLINE __m128i halve_x4_x64_SSE41(const uint32_t* row0, const uint32_t* row1){
+    __m128i a = _mm_loadu_si128((const __m128i*)row0);
+    __m128i b = _mm_loadu_si128((const __m128i*)row1);
+
+    //  Vertical sums as 16-bit.
+    __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+    __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+    //  Horizontal sums.
+    __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+    sum = _mm_add_epi16(sum, _mm_set1_epi16(2));
+    sum = _mm_srli_epi16(sum, 2);
+
+    return _mm_packus_epi16(sum, sum);
+}
+
+void halve_image_x64_SSE41(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    size_t out_width = width / 2;
+    size_t out_height = height / 2;
+    for (size_t r = 0; r < out_height; r++){
+        const uint32_t* row0 = (const uint32_t*)((const char*)in + 2*r * in_bytes_per_row);
+        const uint32_t* row1 = (const uint32_t*)((const char*)row0 + in_bytes_per_row);
+        size_t c = 0;
+        for (; c + 4 <= out_width; c += 4){
+            __m128i x0 = halve_x4_x64_SSE41(row0 + 2*c, row1 + 2*c);
+            __m128i x1 = halve_x4_x64_SSE41(row0 + 2*c + 4, row1 + 2*c + 4);
+            _mm_storeu_si128((__m128i*)(out + c), _mm_unpacklo_epi64(x0, x1));
+        }
+        halve_row_tail(c, out_width, row0, row1, out);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,56 @@
+/*  Pixel Integral Image
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImagePixelIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void pixel_integral_Default(
+    PixelIntegralEntry* table, size_t table_entries_per_row,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+void pixel_integral_x64_SSE41(
+    PixelIntegralEntry* table, size_t table_entries_per_row,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+void pixel_integral_x64_AVX2(
+    PixelIntegralEntry* table, size_t table_entries_per_row,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+
+
+
+void pixel_integral(
+    PixelIntegralEntry* table, size_t table_entries_per_row,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        pixel_integral_x64_AVX2(table, table_entries_per_row, width, height, image, image_bytes_per_row);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        pixel_integral_x64_SSE41(table, table_entries_per_row, width, height, image, image_bytes_per_row);
+        return;
+    }
+#endif
+    pixel_integral_Default(table, table_entries_per_row, width, height, image, image_bytes_per_row);
+}
+
+
+
+
+}
+}
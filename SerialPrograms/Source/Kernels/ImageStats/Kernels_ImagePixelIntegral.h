@@ -0,0 +1,50 @@
+/*  Pixel Integral Image
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  A summed-area table of the pixel sums and sums of squares. Once it's
+ *  built, the sums over any box of the image take 4 lookups.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImagePixelIntegral_H
+#define PokemonAutomation_Kernels_ImagePixelIntegral_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct PixelIntegralEntry{
+    uint32_t sumB;
+    uint32_t sumG;
+    uint32_t sumR;
+    uint32_t count;
+    uint32_t sqrB;
+    uint32_t sqrG;
+    uint32_t sqrR;
+    uint32_t unused;
+};
+
+
+//  Entry (x, y) of "table" holds the sums of all the pixels in the box from
+//  (0, 0) to (x, y) exclusive. So the table is (width + 1) x (height + 1) and
+//  its first row and column are zero.
+//
+//  Pixels with alpha < 128 are ignored.
+//
+//  The entries wrap around when they overflow. The sums over a box are still
+//  correct as long as they fit in 32 bits. For the squares, this holds for
+//  boxes of up to 65536 pixels.
+void pixel_integral(
+    PixelIntegralEntry* table, size_t table_entries_per_row,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+
+
+}
+}
+#endif
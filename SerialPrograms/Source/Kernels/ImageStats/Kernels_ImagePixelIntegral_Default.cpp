@@ -0,0 +1,62 @@
+/*  Pixel Integral Image (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include "Kernels_ImagePixelIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void pixel_integral_Default(
+    PixelIntegralEntry* table, size_t table_entries_per_row,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+    memset(table, 0, (width + 1) * sizeof(PixelIntegralEntry));
+
+    for (size_t r = 0; r < height; r++){
+        const PixelIntegralEntry* above = table;
+        table += table_entries_per_row;
+
+        PixelIntegralEntry row{};
+        table[0] = row;
+        for (size_t c = 0; c < width; c++){
+            uint32_t p = image[c];
+            uint32_t m = (uint32_t)((int32_t)p >> 31);
+            p &= m;
+
+            uint32_t r0 = p & 0x000000ff;
+            uint32_t r1 = (p >>  8) & 0x000000ff;
+            uint32_t r2 = (p >> 16) & 0x000000ff;
+
+            row.sumB += r0;
+            row.sumG += r1;
+            row.sumR += r2;
+            row.count -= m;
+            row.sqrB += r0 * r0;
+            row.sqrG += r1 * r1;
+            row.sqrR += r2 * r2;
+
+            const PixelIntegralEntry& in = above[c + 1];
+            PixelIntegralEntry& out = table[c + 1];
+            out.sumB = in.sumB + row.sumB;
+            out.sumG = in.sumG + row.sumG;
+            out.sumR = in.sumR + row.sumR;
+            out.count = in.count + row.count;
+            out.sqrB = in.sqrB + row.sqrB;
+            out.sqrG = in.sqrG + row.sqrG;
+            out.sqrR = in.sqrR + row.sqrR;
+            out.unused = 0;
+        }
+
+        image = (const uint32_t*)((const char*)image + image_bytes_per_row);
+    }
+}
+
+
+}
+}
@@ -0,0 +1,62 @@
+/*  Pixel Integral Image (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <string.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Returns an entry for just this pixel.
+PA_FORCE_INLINE __m256i pixel_integral_load_x64_AVX2(uint32_t p){
+    uint32_t m = (uint32_t)((int32_t)p >> 31);
+    __m128i sum = _mm_cvtepu8_epi32(_mm_cvtsi32_si128((int)(p & m)));
+    sum = _mm_insert_epi32(sum, (int)(m & 1), 3);
+    __m128i sqr = _mm_mullo_epi16(sum, sum);
+    sqr = _mm_blend_epi16(sqr, _mm_setzero_si128(), 0xc0);
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(sum), sqr, 1);
+}
+
+
+void pixel_integral_x64_AVX2(
+    PixelIntegralEntry* table, size_t table_entries_per_row,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+    static_assert(sizeof(PixelIntegralEntry) == sizeof(__m256i));
+
+    memset(table, 0, (width + 1) * sizeof(PixelIntegralEntry));
+
+    for (size_t r = 0; r < height; r++){
+        const __m256i* above = (const __m256i*)table + 1;
+        table += table_entries_per_row;
+        __m256i* out = (__m256i*)table;
+
+        _mm256_storeu_si256(out, _mm256_setzero_si256());
+        out++;
+
+        __m256i row = _mm256_setzero_si256();
+        for (size_t c = 0; c < width; c++){
+            row = _mm256_add_epi32(row, pixel_integral_load_x64_AVX2(image[c]));
+            _mm256_storeu_si256(out, _mm256_add_epi32(_mm256_loadu_si256(above), row));
+            above++;
+            out++;
+        }
+
+        image = (const uint32_t*)((const char*)image + image_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,65 @@
+/*  Pixel Integral Image (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <string.h>
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Returns [B, G, R, active] and [B^2, G^2, R^2, 0].
+PA_FORCE_INLINE void pixel_integral_load_x64_SSE41(__m128i& sum, __m128i& sqr, uint32_t p){
+    uint32_t m = (uint32_t)((int32_t)p >> 31);
+    sum = _mm_cvtepu8_epi32(_mm_cvtsi32_si128((int)(p & m)));
+    sum = _mm_insert_epi32(sum, (int)(m & 1), 3);
+    sqr = _mm_mullo_epi16(sum, sum);
+    sqr = _mm_blend_epi16(sqr, _mm_setzero_si128(), 0xc0);
+}
+
+
+void pixel_integral_x64_SSE41(
+    PixelIntegralEntry* table, size_t table_entries_per_row,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+    memset(table, 0, (width + 1) * sizeof(PixelIntegralEntry));
+
+    for (size_t r = 0; r < height; r++){
+        const __m128i* above = (const __m128i*)table + 2;
+        table += table_entries_per_row;
+        __m128i* out = (__m128i*)table;
+
+        _mm_storeu_si128(out + 0, _mm_setzero_si128());
+        _mm_storeu_si128(out + 1, _mm_setzero_si128());
+        out += 2;
+
+        __m128i row_sum = _mm_setzero_si128();
+        __m128i row_sqr = _mm_setzero_si128();
+        for (size_t c = 0; c < width; c++){
+            __m128i sum, sqr;
+            pixel_integral_load_x64_SSE41(sum, sqr, image[c]);
+            row_sum = _mm_add_epi32(row_sum, sum);
+            row_sqr = _mm_add_epi32(row_sqr, sqr);
+            _mm_storeu_si128(out + 0, _mm_add_epi32(_mm_loadu_si128(above + 0), row_sum));
+            _mm_storeu_si128(out + 1, _mm_add_epi32(_mm_loadu_si128(above + 1), row_sqr));
+            above += 2;
+            out += 2;
+        }
+
+        image = (const uint32_t*)((const char*)image + image_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
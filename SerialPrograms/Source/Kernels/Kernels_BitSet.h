@@ -132,6 +132,11 @@ public:
             return false;
         }
     }
+
+    //  Upper bound on the # of times "pop()" will succeed.
+    PA_FORCE_INLINE size_t pending() const{
+        return m_sparse.size();
+    }
     PA_FORCE_INLINE bool pop(size_t& x, size_t& y){
         while (!m_sparse.empty()){
             size_t current = m_sparse.back();
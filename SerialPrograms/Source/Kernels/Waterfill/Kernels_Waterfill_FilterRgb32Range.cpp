@@ -0,0 +1,210 @@
+/*  Waterfill Filter RGB32 Range
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "Kernels_Waterfill_Session.h"
+#include "Kernels_Waterfill_FilterRgb32Range.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace Waterfill{
+
+
+//  Rows per band. This is a multiple of every tile height. At 1920 pixels
+//  wide, the bits of one band are 15 KB per filter.
+const size_t FILTER_RGB32_RANGE_BAND_HEIGHT = 64;
+
+
+namespace{
+
+//  A row word on the top or bottom edge of a band, and the part it belongs to.
+struct EdgeWord{
+    uint32_t word_x;
+    uint64_t bits;
+    size_t part;
+};
+
+//  The pieces of the objects of one filter. Pieces that touch across a band
+//  edge are joined by a union-find over "parent".
+struct FilterParts{
+    std::vector<WaterfillObject> parts;
+    std::vector<size_t> parent;
+
+    //  The bottom row of the previous band.
+    std::vector<EdgeWord> bottom;
+
+    size_t find(size_t index){
+        while (parent[index] != index){
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    }
+    void join(size_t x, size_t y){
+        x = find(x);
+        y = find(y);
+        //  The earlier part is the root. So the merged object keeps its place.
+        if (x < y){
+            parent[y] = x;
+        }else if (y < x){
+            parent[x] = y;
+        }
+    }
+};
+
+bool edge_word_less(const EdgeWord& x, const EdgeWord& y){
+    return x.word_x < y.word_x;
+}
+
+//  Join the parts whose bits touch vertically across the band edge.
+void join_edges(FilterParts& filter, std::vector<EdgeWord>& top){
+    std::vector<EdgeWord>& bottom = filter.bottom;
+    std::sort(top.begin(), top.end(), edge_word_less);
+    std::sort(bottom.begin(), bottom.end(), edge_word_less);
+
+    //  A word can hold bits of several parts. So compare every pair with the
+    //  same word index.
+    size_t t = 0;
+    size_t b = 0;
+    while (t < top.size() && b < bottom.size()){
+        uint32_t word_x = top[t].word_x;
+        if (bottom[b].word_x < word_x){
+            b++;
+            continue;
+        }
+        if (word_x < bottom[b].word_x){
+            t++;
+            continue;
+        }
+        size_t t_end = t;
+        while (t_end < top.size() && top[t_end].word_x == word_x){
+            t_end++;
+        }
+        size_t b_end = b;
+        while (b_end < bottom.size() && bottom[b_end].word_x == word_x){
+            b_end++;
+        }
+        for (size_t i = t; i < t_end; i++){
+            for (size_t j = b; j < b_end; j++){
+                if (top[i].bits & bottom[j].bits){
+                    filter.join(top[i].part, bottom[j].part);
+                }
+            }
+        }
+        t = t_end;
+        b = b_end;
+    }
+}
+
+}
+
+
+
+std::vector<std::vector<WaterfillObject>> find_objects_rgb32_range(
+    const uint32_t* image, size_t bytes_per_row,
+    size_t width, size_t height,
+    const std::vector<std::pair<uint32_t, uint32_t>>& filters,
+    size_t min_area
+){
+    const BinaryMatrixType type = get_BinaryMatrixType();
+    std::unique_ptr<WaterfillSession> session = make_WaterfillSession();
+
+    std::vector<FilterParts> objects(filters.size());
+    std::vector<std::unique_ptr<PackedBinaryMatrix_IB>> matrices(filters.size());
+    std::vector<EdgeWord> top;
+    std::vector<WaterfillRowSpan> spans;
+
+    size_t band_height = 0;
+    for (size_t band_y = 0; band_y < height; band_y += FILTER_RGB32_RANGE_BAND_HEIGHT){
+        const size_t rows = std::min(FILTER_RGB32_RANGE_BAND_HEIGHT, height - band_y);
+
+        //  Only the last band can be shorter.
+        if (rows != band_height){
+            band_height = rows;
+            for (std::unique_ptr<PackedBinaryMatrix_IB>& matrix : matrices){
+                matrix = make_PackedBinaryMatrix(type, width, rows);
+            }
+        }
+
+        std::vector<CompressRgb32ToBinaryRangeFilter> band_filters;
+        band_filters.reserve(filters.size());
+        for (size_t c = 0; c < filters.size(); c++){
+            band_filters.emplace_back(*matrices[c], filters[c].first, filters[c].second);
+        }
+        compress_rgb32_to_binary_range(
+            (const uint32_t*)((const char*)image + band_y * bytes_per_row), bytes_per_row,
+            band_filters.data(), band_filters.size()
+        );
+
+        for (size_t c = 0; c < filters.size(); c++){
+            FilterParts& filter = objects[c];
+            top.clear();
+            std::vector<EdgeWord> bottom;
+
+            session->set_source(*matrices[c]);
+            std::unique_ptr<WaterfillIterator> iter = session->make_iterator(0);
+            WaterfillObject object;
+            while (true){
+                spans.clear();
+                if (!iter->find_next_edges(object, spans)){
+                    break;
+                }
+
+                //  A piece that touches the band edges can be part of a larger
+                //  object. Any other piece is already a whole object.
+                if (spans.empty() && object.area < min_area){
+                    continue;
+                }
+
+                size_t part = filter.parts.size();
+                for (const WaterfillRowSpan& span : spans){
+                    if (span.y == 0){
+                        top.emplace_back(EdgeWord{span.word_x, span.bits, part});
+                    }
+                    if (span.y == rows - 1){
+                        bottom.emplace_back(EdgeWord{span.word_x, span.bits, part});
+                    }
+                }
+
+                object.body_y += band_y;
+                object.min_y += band_y;
+                object.max_y += band_y;
+                object.sum_y += (uint64_t)band_y * object.area;
+                filter.parts.emplace_back(std::move(object));
+                filter.parent.emplace_back(part);
+            }
+
+            join_edges(filter, top);
+            filter.bottom = std::move(bottom);
+        }
+    }
+
+    std::vector<std::vector<WaterfillObject>> ret(filters.size());
+    for (size_t c = 0; c < filters.size(); c++){
+        FilterParts& filter = objects[c];
+
+        //  Merge each part into the first part of its object.
+        for (size_t part = 0; part < filter.parts.size(); part++){
+            size_t root = filter.find(part);
+            if (root != part){
+                filter.parts[root].merge_assume_no_overlap(filter.parts[part]);
+            }
+        }
+        for (size_t part = 0; part < filter.parts.size(); part++){
+            if (filter.parent[part] == part && filter.parts[part].area >= min_area){
+                ret[c].emplace_back(std::move(filter.parts[part]));
+            }
+        }
+    }
+    return ret;
+}
+
+
+
+}
+}
+}
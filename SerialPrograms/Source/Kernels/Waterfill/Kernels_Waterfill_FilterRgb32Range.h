@@ -0,0 +1,44 @@
+/*  Waterfill Filter RGB32 Range
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Filter an image by several color ranges and find the objects of each one
+ *  without building a binary matrix of the whole image.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_Waterfill_FilterRgb32Range_H
+#define PokemonAutomation_Kernels_Waterfill_FilterRgb32Range_H
+
+#include <vector>
+#include "Kernels_Waterfill_Types.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace Waterfill{
+
+
+
+//  Return the objects of each filter that have at least "min_area" bits.
+//
+//  This gives the same objects as running the multi-filter
+//  "compress_rgb32_to_binary_range()" on the whole image and then
+//  "find_objects_inplace()" on each matrix. But the image is done in bands of
+//  rows. Each band is filtered and then waterfilled while its bits are still
+//  in cache. Objects that cross the edge between two bands are then merged.
+//
+//  The objects of each filter are ordered by the first band they appear in.
+//  "object.object" is left null.
+std::vector<std::vector<WaterfillObject>> find_objects_rgb32_range(
+    const uint32_t* image, size_t bytes_per_row,
+    size_t width, size_t height,
+    const std::vector<std::pair<uint32_t, uint32_t>>& filters,
+    size_t min_area
+);
+
+
+
+}
+}
+}
+#endif
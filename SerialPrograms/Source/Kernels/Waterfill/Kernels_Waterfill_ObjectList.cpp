@@ -0,0 +1,135 @@
+/*  Waterfill Object List
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels_Waterfill_Session.h"
+#include "Kernels_Waterfill_ObjectList.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace Waterfill{
+
+
+
+WaterfillObjectList::WaterfillObjectList() = default;
+WaterfillObjectList::~WaterfillObjectList() = default;
+WaterfillObjectList::WaterfillObjectList(WaterfillObjectList&& x) = default;
+WaterfillObjectList& WaterfillObjectList::operator=(WaterfillObjectList&& x) = default;
+
+
+void WaterfillObjectList::find_objects_inplace(PackedBinaryMatrix_IB& matrix, size_t min_area){
+    clear();
+    m_width = matrix.width();
+    m_height = matrix.height();
+
+    if (m_session){
+        m_session->set_source(matrix);
+    }else{
+        m_session = make_WaterfillSession(matrix);
+    }
+
+    auto finder = m_session->make_iterator(min_area);
+    WaterfillObject object;
+    while (true){
+        size_t begin = m_spans.size();
+        if (!finder->find_next(object, m_spans)){
+            break;
+        }
+        push_back(object);
+        m_span_begin.back() = begin;
+        m_span_end.back() = m_spans.size();
+    }
+}
+void WaterfillObjectList::clear(){
+    resize(0);
+    m_spans.clear();
+    m_width = 0;
+    m_height = 0;
+}
+
+
+void WaterfillObjectList::filter_by_area(size_t min_area, size_t max_area){
+    filter([=](const WaterfillObjectList& list, size_t index){
+        size_t area = list.area(index);
+        return min_area <= area && area <= max_area;
+    });
+}
+void WaterfillObjectList::filter_by_size(size_t min_width, size_t min_height){
+    filter([=](const WaterfillObjectList& list, size_t index){
+        return list.width(index) >= min_width && list.height(index) >= min_height;
+    });
+}
+
+
+WaterfillObject WaterfillObjectList::operator[](size_t index) const{
+    WaterfillObject object;
+    object.body_x = m_body_x[index];
+    object.body_y = m_body_y[index];
+    object.min_x = m_min_x[index];
+    object.min_y = m_min_y[index];
+    object.max_x = m_max_x[index];
+    object.max_y = m_max_y[index];
+    object.area = m_area[index];
+    object.sum_x = m_sum_x[index];
+    object.sum_y = m_sum_y[index];
+    return object;
+}
+WaterfillObject WaterfillObjectList::materialize(size_t index) const{
+    WaterfillObject ret = (*this)[index];
+    size_t begin = m_span_begin[index];
+    ret.object = m_session->build_object(
+        m_width, m_height,
+        m_spans.data() + begin, m_span_end[index] - begin
+    );
+    return ret;
+}
+
+
+void WaterfillObjectList::push_back(const WaterfillObject& object){
+    m_body_x.emplace_back(object.body_x);
+    m_body_y.emplace_back(object.body_y);
+    m_min_x.emplace_back(object.min_x);
+    m_min_y.emplace_back(object.min_y);
+    m_max_x.emplace_back(object.max_x);
+    m_max_y.emplace_back(object.max_y);
+    m_area.emplace_back(object.area);
+    m_sum_x.emplace_back(object.sum_x);
+    m_sum_y.emplace_back(object.sum_y);
+    m_span_begin.emplace_back();
+    m_span_end.emplace_back();
+}
+void WaterfillObjectList::move_object(size_t to, size_t from){
+    m_body_x[to] = m_body_x[from];
+    m_body_y[to] = m_body_y[from];
+    m_min_x[to] = m_min_x[from];
+    m_min_y[to] = m_min_y[from];
+    m_max_x[to] = m_max_x[from];
+    m_max_y[to] = m_max_y[from];
+    m_area[to] = m_area[from];
+    m_sum_x[to] = m_sum_x[from];
+    m_sum_y[to] = m_sum_y[from];
+    m_span_begin[to] = m_span_begin[from];
+    m_span_end[to] = m_span_end[from];
+}
+void WaterfillObjectList::resize(size_t size){
+    m_body_x.resize(size);
+    m_body_y.resize(size);
+    m_min_x.resize(size);
+    m_min_y.resize(size);
+    m_max_x.resize(size);
+    m_max_y.resize(size);
+    m_area.resize(size);
+    m_sum_x.resize(size);
+    m_sum_y.resize(size);
+    m_span_begin.resize(size);
+    m_span_end.resize(size);
+}
+
+
+
+
+}
+}
+}
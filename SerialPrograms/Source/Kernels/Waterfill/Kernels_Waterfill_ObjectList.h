@@ -0,0 +1,145 @@
+/*  Waterfill Object List
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  A structure-of-arrays collection of waterfill objects.
+ *
+ *  The stats of each object (bounds, area, coordinate sums) are stored in
+ *  parallel arrays. The bits of all the objects are recorded as row spans in
+ *  one shared buffer while waterfill labels them. An object's sparse bitmap
+ *  is built from its spans only when it is asked for.
+ *
+ *  Detectors typically find all the objects in an image and then throw most
+ *  of them away based on their size or shape. With this class, that does not
+ *  need any per-object heap allocation. If the list is reused across frames,
+ *  it does not allocate at all once its buffers are large enough.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_Waterfill_ObjectList_H
+#define PokemonAutomation_Kernels_Waterfill_ObjectList_H
+
+#include <vector>
+#include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
+#include "Kernels_Waterfill_Types.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace Waterfill{
+
+
+class WaterfillSession;
+
+
+class WaterfillObjectList{
+public:
+    WaterfillObjectList();
+    ~WaterfillObjectList();
+    WaterfillObjectList(WaterfillObjectList&& x);
+    WaterfillObjectList& operator=(WaterfillObjectList&& x);
+    WaterfillObjectList(const WaterfillObjectList& x) = delete;
+    void operator=(const WaterfillObjectList& x) = delete;
+
+public:
+    //  Replace the contents of this list with all the objects in "matrix"
+    //  that have at least "min_area" bits. This will destroy "matrix".
+    void find_objects_inplace(PackedBinaryMatrix_IB& matrix, size_t min_area);
+
+    //  Remove all objects. Buffers are kept for reuse.
+    void clear();
+
+    size_t size() const{ return m_area.size(); }
+    bool empty() const{ return m_area.empty(); }
+
+    //  Per-object stats. See WaterfillObject for what these mean.
+    size_t body_x(size_t index) const{ return m_body_x[index]; }
+    size_t body_y(size_t index) const{ return m_body_y[index]; }
+    size_t min_x(size_t index) const{ return m_min_x[index]; }
+    size_t min_y(size_t index) const{ return m_min_y[index]; }
+    size_t max_x(size_t index) const{ return m_max_x[index]; }
+    size_t max_y(size_t index) const{ return m_max_y[index]; }
+    size_t area(size_t index) const{ return m_area[index]; }
+    uint64_t sum_x(size_t index) const{ return m_sum_x[index]; }
+    uint64_t sum_y(size_t index) const{ return m_sum_y[index]; }
+
+    size_t width(size_t index) const{ return m_max_x[index] - m_min_x[index]; }
+    size_t height(size_t index) const{ return m_max_y[index] - m_min_y[index]; }
+
+    double center_of_gravity_x(size_t index) const{ return (double)m_sum_x[index] / m_area[index]; }
+    double center_of_gravity_y(size_t index) const{ return (double)m_sum_y[index] / m_area[index]; }
+
+    double aspect_ratio(size_t index) const{ return (double)width(index) / height(index); }
+    double area_ratio(size_t index) const{ return (double)m_area[index] / (width(index) * height(index)); }
+
+    //  Keep only the objects for which "keep(list, index)" returns true.
+    //  The order of the remaining objects is preserved.
+    template <typename Predicate>
+    void filter(Predicate&& keep);
+
+    //  Keep only the objects whose area is in [min_area, max_area].
+    void filter_by_area(size_t min_area, size_t max_area);
+
+    //  Keep only the objects whose enclosing box is at least this large.
+    void filter_by_size(size_t min_width, size_t min_height);
+
+    //  Return the stats of an object. "object" is left null.
+    WaterfillObject operator[](size_t index) const;
+
+    //  Return the object with its bitmap.
+    WaterfillObject materialize(size_t index) const;
+
+
+private:
+    void push_back(const WaterfillObject& object);
+    void move_object(size_t to, size_t from);
+    void resize(size_t size);
+
+private:
+    std::vector<size_t> m_body_x;
+    std::vector<size_t> m_body_y;
+    std::vector<size_t> m_min_x;
+    std::vector<size_t> m_min_y;
+    std::vector<size_t> m_max_x;
+    std::vector<size_t> m_max_y;
+    std::vector<size_t> m_area;
+    std::vector<uint64_t> m_sum_x;
+    std::vector<uint64_t> m_sum_y;
+
+    //  The spans of object "i" are "m_spans[m_span_begin[i] : m_span_end[i]]".
+    //  Filtering does not touch "m_spans".
+    std::vector<size_t> m_span_begin;
+    std::vector<size_t> m_span_end;
+    std::vector<WaterfillRowSpan> m_spans;
+
+    //  Dimensions of the matrix the objects were found in.
+    size_t m_width = 0;
+    size_t m_height = 0;
+
+    std::unique_ptr<WaterfillSession> m_session;
+};
+
+
+
+template <typename Predicate>
+void WaterfillObjectList::filter(Predicate&& keep){
+    size_t count = size();
+    size_t out = 0;
+    for (size_t c = 0; c < count; c++){
+        if (!keep(*this, c)){
+            continue;
+        }
+        if (out != c){
+            move_object(out, c);
+        }
+        out++;
+    }
+    resize(out);
+}
+
+
+
+
+}
+}
+}
+#endif
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_Kernels_Waterfill_Session_H
 #define PokemonAutomation_Kernels_Waterfill_Session_H
 
+#include <vector>
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
 #include "Kernels_Waterfill_Types.h"
 
@@ -37,6 +38,13 @@ public:
         size_t x, size_t y
     ) = 0;
 
+    //  Build the bitmap of an object from the row spans that were recorded
+    //  for it by "WaterfillIterator::find_next()".
+    virtual std::unique_ptr<SparseBinaryMatrix_IB> build_object(
+        size_t width, size_t height,
+        const WaterfillRowSpan* spans, size_t count
+    ) const = 0;
+
 };
 std::unique_ptr<WaterfillSession> make_WaterfillSession();
 std::unique_ptr<WaterfillSession> make_WaterfillSession(PackedBinaryMatrix_IB& matrix);
@@ -49,6 +57,16 @@ public:
 
     //  Returns false is nothing is left.
     virtual bool find_next(WaterfillObject& object, bool keep_object) = 0;
+
+    //  Same as above, but instead of building "object.object", append the
+    //  nonzero row words of the object to "spans". This does not allocate
+    //  anything per object once "spans" is large enough.
+    virtual bool find_next(WaterfillObject& object, std::vector<WaterfillRowSpan>& spans) = 0;
+
+    //  Same as above, but only the words on the first and last rows of the
+    //  matrix are appended. This is enough to tell which objects touch the
+    //  top or bottom edge, and how.
+    virtual bool find_next_edges(WaterfillObject& object, std::vector<WaterfillRowSpan>& spans) = 0;
 };
 
 
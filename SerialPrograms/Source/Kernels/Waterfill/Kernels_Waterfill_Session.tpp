@@ -7,9 +7,9 @@
 #ifndef PokemonAutomation_Kernels_Waterfill_Session_TPP
 #define PokemonAutomation_Kernels_Waterfill_Session_TPP
 
-#include <set>
-#include <map>
+#include <vector>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "Kernels/Kernels_BitSet.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrix_t.h"
 #include "Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixCore.h"
@@ -92,11 +92,20 @@ public:
     //  The object will be removed from the input matrix.
     //  Return true if there is an object at the tile; false otherwise.
     //  If keep_object is true, object.object is constructed.
+    //  If "spans" is not null, the rows of the object are appended to it.
+    //  If "edge_rows_only" is true, only the first and last rows of the matrix.
     bool find_object_in_tile(
         WaterfillObject& object, bool keep_object,
-        size_t tile_x, size_t tile_y
+        size_t tile_x, size_t tile_y,
+        std::vector<WaterfillRowSpan>* spans = nullptr,
+        bool edge_rows_only = false
     );
 
+    virtual std::unique_ptr<SparseBinaryMatrix_IB> build_object(
+        size_t width, size_t height,
+        const WaterfillRowSpan* spans, size_t count
+    ) const override;
+
 
 private:
     // Called by both find_object_on_bit() and find_object_in_tile()
@@ -104,7 +113,9 @@ private:
     bool find_object(
         WaterfillObject& object, bool keep_object,
         size_t tile_x, size_t tile_y,
-        size_t bit_x, size_t bit_y
+        size_t bit_x, size_t bit_y,
+        std::vector<WaterfillRowSpan>* spans = nullptr,
+        bool edge_rows_only = false
     );
 #if 0
     void clear_dirty_tiles(){
@@ -140,6 +151,14 @@ public:
         , m_min_area(min_area)
     {}
     virtual bool find_next(WaterfillObject& object, bool keep_object) override;
+    virtual bool find_next(WaterfillObject& object, std::vector<WaterfillRowSpan>& spans) override;
+    virtual bool find_next_edges(WaterfillObject& object, std::vector<WaterfillRowSpan>& spans) override;
+
+private:
+    bool find_next_impl(
+        WaterfillObject& object, bool keep_object,
+        std::vector<WaterfillRowSpan>* spans, bool edge_rows_only
+    );
 
 private:
     WaterfillSession_t<Tile, TileRoutines>& m_session;
@@ -168,9 +187,6 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object_on_bit(
         return false;
     }
 
-    std::set<TileIndex> busy;
-    std::map<TileIndex, Tile> obj;
-
     size_t tile_x = x / PackedBinaryMatrixCore<Tile>::Tile::WIDTH;
     size_t tile_y = y / PackedBinaryMatrixCore<Tile>::Tile::HEIGHT;
     size_t bit_x = x % PackedBinaryMatrixCore<Tile>::Tile::WIDTH;
@@ -182,7 +198,9 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object_on_bit(
 template <typename Tile, typename TileRoutines>
 bool WaterfillSession_t<Tile, TileRoutines>::find_object_in_tile(
     WaterfillObject& object, bool keep_object,
-    size_t tile_x, size_t tile_y
+    size_t tile_x, size_t tile_y,
+    std::vector<WaterfillRowSpan>* spans,
+    bool edge_rows_only
 ){
     Tile& start = m_source->tile(tile_x, tile_y);
 
@@ -191,7 +209,37 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object_in_tile(
         return false;
     }
 
-    return find_object(object, keep_object, tile_x, tile_y, bit_x, bit_y);
+    return find_object(object, keep_object, tile_x, tile_y, bit_x, bit_y, spans, edge_rows_only);
+}
+
+template <typename Tile, typename TileRoutines>
+std::unique_ptr<SparseBinaryMatrix_IB> WaterfillSession_t<Tile, TileRoutines>::build_object(
+    size_t width, size_t height,
+    const WaterfillRowSpan* spans, size_t count
+) const{
+    //  The rows of each tile were recorded together. So a new tile starts
+    //  whenever the tile position changes.
+    std::vector<TileIndex> object_index;
+    AlignedVector<Tile> object_tiles;
+    size_t last_x = SIZE_MAX;
+    size_t last_y = SIZE_MAX;
+    for (size_t c = 0; c < count; c++){
+        const WaterfillRowSpan& span = spans[c];
+        size_t x = span.word_x;
+        size_t y = span.y / Tile::HEIGHT;
+        if (x != last_x || y != last_y){
+            object_index.emplace_back(x, y);
+            object_tiles.emplace_back();
+            object_tiles.back().set_zero();
+            last_x = x;
+            last_y = y;
+        }
+        object_tiles.back().row(span.y % Tile::HEIGHT) = span.bits;
+    }
+
+    auto ptr = std::make_unique<SparseBinaryMatrix_t<Tile>>(width, height);
+    ptr->get().set_data(std::move(object_index), std::move(object_tiles));
+    return ptr;
 }
 
 
@@ -199,7 +247,9 @@ template <typename Tile, typename TileRoutines>
 bool WaterfillSession_t<Tile, TileRoutines>::find_object(
     WaterfillObject& object, bool keep_object,
     size_t tile_x, size_t tile_y,
-    size_t bit_x, size_t bit_y
+    size_t bit_x, size_t bit_y,
+    std::vector<WaterfillRowSpan>* spans,
+    bool edge_rows_only
 ){
 //    clear_dirty_tiles();
 
@@ -313,17 +363,22 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
     stats.body_x = tile_x * Tile::WIDTH + bit_x;
     stats.body_y = tile_y * Tile::HEIGHT + bit_y;
 
-    std::unique_ptr<std::map<TileIndex, Tile>> sparse_set;
+    //  Collect the tiles of the object. They come out in no particular order
+    //  and are sorted once at the end.
+    std::vector<TileIndex> object_index;
+    AlignedVector<Tile> object_tiles;
     if (keep_object){
-        sparse_set = std::make_unique<std::map<TileIndex, Tile>>();
+        object_index.reserve(m_object_tiles.pending());
+        object_tiles.reserve(m_object_tiles.pending());
     }
 
     while (m_object_tiles.pop(x, y)){
 //        m_dirty_tiles.emplace_back(x, y);
         Tile& recorded_tile = m_object.tile(x, y);
 
-        if (sparse_set){
-            (*sparse_set)[TileIndex{x, y}] = recorded_tile;
+        if (keep_object){
+            object_index.emplace_back(x, y);
+            object_tiles.emplace_back(recorded_tile);
         }
 
         // Get sum of (x,y) location of the 1-bits in the tile into (sum_x, sum_y)
@@ -338,6 +393,8 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
             x * Tile::WIDTH, y * Tile::HEIGHT,
             popcount, sum_x, sum_y
         );
+        size_t row_begin = 0;
+        size_t row_end = Tile::HEIGHT;
         if (!(tile_min_x < x && x < tile_max_x && tile_min_y < y && y < tile_max_y)){
             // Get the min max of the 1-bits locaitons in the tile
             size_t cmin_x, cmax_x, cmin_y, cmax_y;
@@ -346,6 +403,26 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
                 x * Tile::WIDTH, y * Tile::HEIGHT,
                 cmin_x, cmax_x, cmin_y, cmax_y
             );
+            row_begin = cmin_y;
+            row_end = cmax_y;
+        }
+        if (spans != nullptr && edge_rows_only){
+            size_t top = y * Tile::HEIGHT;
+            size_t last = m_source->height() - 1;
+            if (top == 0 && recorded_tile.row(0) != 0){
+                spans->emplace_back(WaterfillRowSpan{(uint32_t)x, 0, recorded_tile.row(0)});
+            }
+            if (last != 0 && top <= last && last < top + Tile::HEIGHT && recorded_tile.row(last - top) != 0){
+                spans->emplace_back(WaterfillRowSpan{(uint32_t)x, (uint32_t)last, recorded_tile.row(last - top)});
+            }
+        }else if (spans != nullptr){
+            //  Only the rows within the boundaries can be nonzero.
+            for (size_t r = row_begin; r < row_end; r++){
+                uint64_t bits = recorded_tile.row(r);
+                if (bits != 0){
+                    spans->emplace_back(WaterfillRowSpan{(uint32_t)x, (uint32_t)(y * Tile::HEIGHT + r), bits});
+                }
+            }
         }
         tile_min_x = std::min(tile_min_x, x);
         tile_max_x = std::max(tile_max_x, x);
@@ -365,9 +442,9 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
 
     object = stats;
 
-    if (sparse_set){
+    if (keep_object){
         auto ptr = std::make_unique<SparseBinaryMatrix_t<Tile>>(m_source->width(), m_source->height());
-        ptr->get().set_data(std::move(*sparse_set));
+        ptr->get().set_data(std::move(object_index), std::move(object_tiles));
         object.object = std::move(ptr);
     }
 
@@ -379,15 +456,34 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
 
 template <typename Tile, typename TileRoutines>
 bool WaterfillIterator_t<Tile, TileRoutines>::find_next(WaterfillObject& object, bool keep_object){
+    return find_next_impl(object, keep_object, nullptr, false);
+}
+template <typename Tile, typename TileRoutines>
+bool WaterfillIterator_t<Tile, TileRoutines>::find_next(WaterfillObject& object, std::vector<WaterfillRowSpan>& spans){
+    return find_next_impl(object, false, &spans, false);
+}
+template <typename Tile, typename TileRoutines>
+bool WaterfillIterator_t<Tile, TileRoutines>::find_next_edges(WaterfillObject& object, std::vector<WaterfillRowSpan>& spans){
+    return find_next_impl(object, false, &spans, true);
+}
+template <typename Tile, typename TileRoutines>
+bool WaterfillIterator_t<Tile, TileRoutines>::find_next_impl(
+    WaterfillObject& object, bool keep_object,
+    std::vector<WaterfillRowSpan>* spans, bool edge_rows_only
+){
+    size_t spans_before = spans == nullptr ? 0 : spans->size();
     while (m_tile_row < m_session.tile_height()){
         while (m_tile_col < m_session.tile_width()){
             while (true){
                 //  Not object found. Move to next tile.
-                if (!m_session.find_object_in_tile(object, keep_object, m_tile_col, m_tile_row)){
+                if (!m_session.find_object_in_tile(object, keep_object, m_tile_col, m_tile_row, spans, edge_rows_only)){
                     break;
                 }
                 //  Object too small. Skip it.
                 if (object.area < m_min_area){
+                    if (spans != nullptr){
+                        spans->resize(spans_before);
+                    }
                     continue;
                 }
                 return true;
@@ -127,6 +127,16 @@ public:
 
 
 
+//  One 64-bit row word of an object's bitmap. This is the same regardless of
+//  the tile shape, so it can be stored without knowing the matrix type.
+struct WaterfillRowSpan{
+    uint32_t word_x;    //  Column in units of 64 bits.
+    uint32_t y;         //  Row in bits.
+    uint64_t bits;
+};
+
+
+
 
 }
 }
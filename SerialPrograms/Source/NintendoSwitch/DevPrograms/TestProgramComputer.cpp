@@ -37,6 +37,7 @@
 #include "PokemonSwSh/MaxLair/Inference/PokemonSwSh_MaxLair_Detect_PathSelect.h"
 #include "PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_State.h"
 #include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_RentalBossMatchup.h"
 #include "CommonFramework/ImageMatch/ExactImageMatcher.h"
 #include "TestProgramComputer.h"
 #include "ClientSource/Libraries/Logging.h"
@@ -244,6 +245,12 @@ void TestProgramComputer::program(ProgramEnvironment& env, CancellableScope& sco
 
 
 
+#if 0
+    //  Regenerate "PokemonSwSh/MaxLair/boss_matchup_LUT.json" after the
+    //  PkmnLib Pokemon or move data changes.
+    RentalBossMatchupTable::compute().save_json("boss_matchup_LUT.json");
+#endif
+
 
 #if 0
     PokemonSV::DateSeed data = PokemonSV::ItemPrinter::calculate_seed_prizes(2346161588);
@@ -988,10 +995,9 @@ void TestProgramComputer::program(ProgramEnvironment& env, CancellableScope& sco
     set.insert({12, 18, 13, 27});
     cout << set.dump() << endl;
 
-    auto iter = set.lower_bound_min_y(11);
-    for (; iter != set.end_min_y(); ++iter){
-        cout << iter->first << endl;
-    }
+    set.for_each_containing(12, 20, [](size_t index, const Rectangle<size_t>& box){
+        cout << index << endl;
+    });
 #endif
 
 //    ImageRGB32 image("SV-Buttons2.png");
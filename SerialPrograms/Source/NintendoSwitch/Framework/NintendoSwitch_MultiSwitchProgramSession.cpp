@@ -13,6 +13,7 @@
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/Tools/BlackBorderCheck.h"
+#include "CommonFramework/VideoPipeline/VideoHistory.h"
 #include "NintendoSwitch_MultiSwitchProgramOption.h"
 #include "NintendoSwitch_MultiSwitchProgramSession.h"
 
@@ -132,6 +133,19 @@ void MultiSwitchProgramSession::internal_run_program(){
     );
 
     size_t consoles = m_system.count();
+
+    //  Record the video for error reports.
+    std::vector<std::unique_ptr<VideoHistory>> video_history(consoles);
+    uint8_t video_history_seconds = GlobalSettings::instance().ERROR_REPORT_VIDEO_SECONDS;
+    if (video_history_seconds != 0){
+        for (size_t c = 0; c < consoles; c++){
+            video_history[c] = std::make_unique<VideoHistory>(
+                m_system[c].logger(), m_system[c].video(),
+                std::chrono::seconds(video_history_seconds)
+            );
+        }
+    }
+
     FixedLimitVector<ConsoleHandle> handles(consoles);
     for (size_t c = 0; c < consoles; c++){
         SwitchSystemSession& session = m_system[c];
@@ -141,7 +155,8 @@ void MultiSwitchProgramSession::internal_run_program(){
             session.sender().botbase(),
             session.video(),
             session.overlay(),
-            session.audio()
+            session.audio(),
+            video_history[c].get()
         );
     }
 
@@ -12,6 +12,7 @@
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/Tools/BlackBorderCheck.h"
+#include "CommonFramework/VideoPipeline/VideoHistory.h"
 #include "NintendoSwitch_SingleSwitchProgramOption.h"
 #include "NintendoSwitch_SingleSwitchProgramSession.h"
 
@@ -100,6 +101,17 @@ void SingleSwitchProgramSession::internal_run_program(){
         m_option.descriptor().display_name(),
         timestamp()
     );
+
+    //  Record the video for error reports.
+    std::unique_ptr<VideoHistory> video_history;
+    uint8_t video_history_seconds = GlobalSettings::instance().ERROR_REPORT_VIDEO_SECONDS;
+    if (video_history_seconds != 0){
+        video_history = std::make_unique<VideoHistory>(
+            m_system.logger(), m_system.video(),
+            std::chrono::seconds(video_history_seconds)
+        );
+    }
+
     CancellableHolder<CancellableScope> scope;
     SingleSwitchProgramEnvironment env(
         program_info,
@@ -110,7 +122,8 @@ void SingleSwitchProgramSession::internal_run_program(){
         m_system.sender().botbase(),
         m_system.video(),
         m_system.overlay(),
-        m_system.audio()
+        m_system.audio(),
+        video_history.get()
     );
 
     try{
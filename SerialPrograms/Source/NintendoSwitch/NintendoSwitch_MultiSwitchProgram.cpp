@@ -10,6 +10,8 @@
 #include "ClientSource/Connection/BotBase.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/InferenceInfra/VisualInferencePivot.h"
 #include "NintendoSwitch_MultiSwitchProgram.h"
 #include "Framework/NintendoSwitch_MultiSwitchProgramOption.h"
 
@@ -29,8 +31,19 @@ MultiSwitchProgramEnvironment::MultiSwitchProgramEnvironment(
     : ProgramEnvironment(program_info, session, current_stats, historical_stats)
     , consoles(std::move(p_switches))
 {
-    for (ConsoleHandle& console : consoles){
-        console.initialize_inference_threads(scope, inference_dispatcher());
+    if (consoles.size() <= 1 || !GlobalSettings::instance().BATCH_MULTI_CONSOLE_INFERENCE){
+        for (ConsoleHandle& console : consoles){
+            console.initialize_inference_threads(scope, inference_dispatcher());
+        }
+        return;
+    }
+
+    //  Share one video pivot so that detectors are batched across consoles.
+    std::shared_ptr<VisualInferencePivot> video_pivot = std::make_shared<VisualInferencePivot>(
+        scope, inference_dispatcher()
+    );
+    for (size_t c = 0; c < consoles.size(); c++){
+        consoles[c].initialize_inference_threads(scope, inference_dispatcher(), video_pivot, c == 0);
     }
 }
 
@@ -110,7 +110,7 @@ void ProgramSelect::change_list(int index){
     }
     m_dropdown->setCurrentIndex(index);
     m_active_index = index;
-    PERSISTENT_SETTINGS().panels["ProgramCategory"] = m_lists[index]->name();
+    PERSISTENT_SETTINGS().set_panel("ProgramCategory", m_lists[index]->name());
     delete m_active_list;
     m_active_list = m_lists[index]->make_QWidget(*this, m_holder);
     layout()->addWidget(m_active_list);
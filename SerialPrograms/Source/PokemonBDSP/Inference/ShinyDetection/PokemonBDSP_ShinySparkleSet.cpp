@@ -6,7 +6,7 @@
 
 #include "Common/Cpp/PrettyPrint.h"
 //#include "Kernels/Waterfill/Kernels_Waterfill.h"
-#include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_ObjectList.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 //#include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_SparkleDetectorRadial.h"
@@ -86,12 +86,18 @@ void ShinySparkleSetBDSP::update_alphas(){
 
 
 
-ShinySparkleSetBDSP find_sparkles(WaterfillSession& session){
+ShinySparkleSetBDSP find_sparkles(WaterfillObjectList& objects){
+    using PokemonSwSh::RadialSparkleDetector;
+
     ShinySparkleSetBDSP sparkles;
-    auto finder = session.make_iterator(20);
-    WaterfillObject object;
-    while (finder->find_next(object, true)){
-        PokemonSwSh::RadialSparkleDetector radial_sparkle(object);
+
+    //  Only balls and stars are checked. Skip anything too large to be either
+    //  before building any object bitmaps.
+    objects.filter_by_area(RadialSparkleDetector::MIN_AREA, RadialSparkleDetector::MAX_AREA);
+
+    for (size_t c = 0; c < objects.size(); c++){
+        WaterfillObject object = objects.materialize(c);
+        RadialSparkleDetector radial_sparkle(object);
         if (radial_sparkle.is_ball()){
             sparkles.balls.emplace_back(object.min_x, object.min_y, object.max_x, object.max_y);
             continue;
@@ -118,12 +124,12 @@ void ShinySparkleSetBDSP::read_from_image(const ImageViewRGB32& image){
             {0xff909000, 0xffffffff},
         }
     );
-    auto session = make_WaterfillSession();
+    WaterfillObjectList objects;
 
     double best_alpha = 0;
     for (PackedBinaryMatrix& matrix : matrices){
-        session->set_source(matrix);
-        ShinySparkleSetBDSP sparkles = find_sparkles(*session);
+        objects.find_objects_inplace(matrix, PokemonSwSh::RadialSparkleDetector::MIN_AREA);
+        ShinySparkleSetBDSP sparkles = find_sparkles(objects);
         sparkles.update_alphas();
         double alpha = sparkles.alpha_overall();
         if (best_alpha < alpha){
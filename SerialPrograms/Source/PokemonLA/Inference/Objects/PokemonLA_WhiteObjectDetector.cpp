@@ -4,8 +4,9 @@
  *
  */
 
-#include <map>
+#include <algorithm>
 #include "Common/Cpp/Containers/FixedLimitVector.tpp"
+#include "Common/Cpp/Containers/BoxSet.h"
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
@@ -75,35 +76,56 @@ void find_overworld_white_objects(
 
 
 void WhiteObjectDetector::merge_heavily_overlapping(double tolerance){
-    std::multimap<size_t, ImagePixelBox> boxes;
-    for (const ImagePixelBox& box : m_detections){
-        boxes.emplace(box.area(), box);
-    }
+    //  Go from the smallest box to the largest. Each box absorbs the larger
+    //  boxes (up to "tolerance" larger) that mostly overlap with it.
+    std::vector<ImagePixelBox> boxes = std::move(m_detections);
+    std::stable_sort(
+        boxes.begin(), boxes.end(),
+        [](const ImagePixelBox& a, const ImagePixelBox& b){ return a.area() < b.area(); }
+    );
     m_detections.clear();
 //    cout << "boxes.size() = " << boxes.size() << endl;
 
+    BoxSet<size_t> index(boxes);
+    std::vector<bool> merged(boxes.size(), false);
+
     double ratio = 1.0 + tolerance;
 
-    while (!boxes.empty()){
-        auto current = boxes.begin();
-        size_t limit = (size_t)(current->first * ratio);
-        auto candidate = current;
-        ++candidate;
-        while (candidate != boxes.end()){
-            if (candidate->first > limit){
-                ++candidate;
-                continue;
-            }
-            size_t overlap = current->second.overlapping_area(candidate->second);
-            if ((double)overlap * ratio > current->first){
-                current->second.merge_with(candidate->second);
-                candidate = boxes.erase(candidate);
-            }else{
-                ++candidate;
+    for (size_t c = 0; c < boxes.size(); c++){
+        if (merged[c]){
+            continue;
+        }
+        ImagePixelBox current = boxes[c];
+        size_t area = current.area();
+        size_t limit = (size_t)(area * ratio);
+
+        //  Candidates are checked in order against the box as it grows. When
+        //  it grows, it may overlap candidates it didn't before. So look them
+        //  up again and continue from where we left off.
+        size_t next = c + 1;
+        bool grew = true;
+        while (grew){
+            grew = false;
+            std::vector<size_t> candidates = index.overlapping(current);
+            std::sort(candidates.begin(), candidates.end());
+            for (size_t i : candidates){
+                if (i < next || merged[i]){
+                    continue;
+                }
+                next = i + 1;
+                if (boxes[i].area() > limit){
+                    continue;
+                }
+                size_t overlap = current.overlapping_area(boxes[i]);
+                if ((double)overlap * ratio > area){
+                    current.merge_with(boxes[i]);
+                    merged[i] = true;
+                    grew = true;
+                    break;
+                }
             }
         }
-        m_detections.emplace_back(current->second);
-        current = boxes.erase(current);
+        m_detections.emplace_back(current);
     }
 //    cout << "m_detections.size() = " << m_detections.size() << endl;
 }
@@ -11,8 +11,8 @@
 //#include "Common/Compiler.h"
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/Containers/BoxSet.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
-#include "Kernels/Algorithm/Kernels_Algorithm_DisjointSet.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
@@ -30,63 +30,11 @@ using std::endl;
 namespace PokemonAutomation{
 
 using Kernels::Waterfill::WaterfillObject;
-using Kernels::DisjointSet;
 
 namespace NintendoSwitch{
 namespace PokemonLA{
 
 
-// Merge boxes that overlap with each other, meaning ImagePixelBox::overlap_with() return true.
-// return a vector of boxes that are merged versions of the input boxes.
-// Note this function will order the input vector.
-// Note the returned boxes may still overlap with each other. This is because the algorithm
-// essentially find the connected components of the input boxes and return the bounding box of each
-// connected component. Although any two connected components don't overlap with each other, their
-// bounding boxes may still overlap.
-std::vector<ImagePixelBox> merge_overlapping_boxes(std::vector<ImagePixelBox>& boxes){
-    // sort boxes according to min_x. If two boxes have same min_x, compare min_y
-    std::sort(boxes.begin(), boxes.end(), [](const ImagePixelBox& a, const ImagePixelBox& b){
-        return a.min_x < b.min_x ? true : (a.min_x == b.min_x ? a.min_y < b.min_y : false);
-    });
-
-    DisjointSet disjoint_set(boxes.size());
-
-    for (size_t i = 0; i < boxes.size(); i++){
-        for(size_t j = i + 1; j < boxes.size(); j++){
-            // box_j and the ones behind it won't overlap with cur_box.
-            if (boxes[j].min_x >= boxes[i].max_x){
-                // break;
-            }
-
-            if (boxes[i].overlaps_with(boxes[j])){
-                disjoint_set.merge(i, j);
-            }
-        }
-    }
-
-    std::map<size_t, ImagePixelBox> merged_boxes;
-    for(size_t i = 0; i < boxes.size(); i++){
-        size_t rep_box = disjoint_set.find(i);
-        auto it = merged_boxes.find(rep_box);
-        if (it == merged_boxes.end()){
-            it = merged_boxes.emplace(rep_box, boxes[rep_box]).first;
-        }
-        
-        if(rep_box != i){
-            // merge the child box i with the rep_box
-            it->second.merge_with(boxes[i]);
-        }
-    }
-
-    std::vector<ImagePixelBox> output_boxes;
-    for(const auto& p : merged_boxes){
-        output_boxes.push_back(p.second);
-    }
-
-    return output_boxes;
-}
-
-
 bool detect_sphere(const Kernels::Waterfill::WaterfillObject& object, ImageRGB32* image, size_t offset_x, size_t offset_y){
     PackedBinaryMatrix matrix = object.packed_matrix();
 
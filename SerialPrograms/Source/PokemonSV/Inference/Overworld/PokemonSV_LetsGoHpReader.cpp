@@ -30,6 +30,10 @@ LetsGoHpWatcher::LetsGoHpWatcher(Color color)
 void LetsGoHpWatcher::make_overlays(VideoOverlaySet& items) const{
     items.add(m_color, m_box);
 }
+bool LetsGoHpWatcher::integral_image_region(ImageFloatBox& region) const{
+    region = m_box;
+    return true;
+}
 
 
 void LetsGoHpWatcher::clear(){
@@ -68,9 +72,7 @@ double LetsGoHpWatcher::last_known_value() const{
 
 
 bool LetsGoHpWatcher::process_frame(const ImageViewRGB32& frame, WallClock timestamp){
-    double hp = read_hp_bar(
-        extract_box_reference(frame, ImageFloatBox(0.055, 0.928, 0.067, 0.012))
-    );
+    double hp = read_hp_bar(extract_box_reference(frame, m_box));
     if (hp <= 0){
         return false;
     }
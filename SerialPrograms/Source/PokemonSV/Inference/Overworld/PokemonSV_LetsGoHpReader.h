@@ -29,6 +29,9 @@ public:
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override;
 
+    //  Reading the bar looks at the same pixels many times. (see read_hp_bar())
+    virtual bool integral_image_region(ImageFloatBox& region) const override;
+
 private:
     Color m_color;
     ImageFloatBox m_box;
@@ -124,23 +124,53 @@ std::pair<double, double> SandwichHandLocator::locate_sandwich_hand(const ImageV
 }
 
 
+// Size of the sandwich hand on screen.
+const double SANDWICH_HAND_WIDTH = 0.071;
+const double SANDWICH_HAND_HEIGHT = 0.106;
+
 SandwichHandWatcher::SandwichHandWatcher(
     HandType hand_type,
     const ImageFloatBox& box,
     Color color
-): VisualInferenceCallback("SandwichHandWatcher"), m_locator(hand_type, box, color), m_location(-1.0, -1.0) {}
+)
+    : VisualInferenceCallback("SandwichHandWatcher")
+    , m_locator(hand_type, box, color)
+    , m_tracker(box, SANDWICH_HAND_WIDTH, SANDWICH_HAND_HEIGHT)
+    , m_location(-1.0, -1.0)
+{}
 
 void SandwichHandWatcher::make_overlays(VideoOverlaySet& items) const{
     m_locator.make_overlays(items);
 }
 
+void SandwichHandWatcher::change_box(const ImageFloatBox& new_box){
+    m_locator.change_box(new_box);
+    m_tracker.set_full_box(new_box);
+}
+
 bool SandwichHandWatcher::process_frame(const VideoSnapshot& frame){
     m_last_snapshot = frame;
-    m_location = m_locator.detect(frame);
+
+    // - first search a window around where the hand is predicted to be,
+    // - then the box,
+    // - then the entire screen.
+    m_location = m_tracker.locate(
+        frame, frame.timestamp,
+        [this](const ImageViewRGB32& image, const ImageFloatBox& area){
+            return m_locator.locate_sandwich_hand(image, area);
+        }
+    );
+    if (m_location.first < 0.0){
+        ImageFloatBox entire_screen(0.0, 0.0, 1.0, 1.0);
+        m_location = m_locator.locate_sandwich_hand(frame, entire_screen);
+    }
     return m_location.first >= 0.0;
 }
 
 bool SandwichHandWatcher::recover_sandwich_hand_position(const ImageViewRGB32& frame){
+    // The hand was moved without being watched. Its velocity is no longer valid.
+    m_tracker.reset();
+
     ImageFloatBox entire_screen(0.0, 0.0, 1.0, 1.0);
     m_location = m_locator.locate_sandwich_hand(frame, entire_screen);
     return m_location.first >= 0.0;
@@ -12,6 +12,7 @@
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/InferenceInfra/VisualInferenceCallback.h"
 #include "CommonFramework/Inference/VisualDetector.h"
+#include "CommonFramework/Inference/LocationTracker.h"
 #include "PokemonSV/Inference/PokemonSV_WhiteButtonDetector.h"
 
 namespace PokemonAutomation{
@@ -66,16 +67,21 @@ public:
 
     const std::pair<double, double>& location() const { return m_location; }
 
-    void change_box(const ImageFloatBox& new_box) { m_locator.change_box(new_box); }
+    void change_box(const ImageFloatBox& new_box);
 
     // - searches the whole screen for the sandwich hand,
     // - then updates its location
     // - return true if hand successfully found
     bool recover_sandwich_hand_position(const ImageViewRGB32& frame);
 
+    const LocationTracker& tracker() const{ return m_tracker; }
+
 
 private:
     SandwichHandLocator m_locator;
+    // Searches a small window around where the hand is expected to be
+    // before falling back to the whole box.
+    LocationTracker m_tracker;
     std::pair<double, double> m_location;
     VideoSnapshot m_last_snapshot;
 };
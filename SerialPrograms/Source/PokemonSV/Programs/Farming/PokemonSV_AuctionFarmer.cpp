@@ -12,6 +12,7 @@
 #include "CommonFramework/InferenceInfra/InferenceRoutines.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/OCR/OCR_NumberReader.h"
+#include "CommonFramework/OCR/OCR_RawOCR.h"
 #include "CommonFramework/Tools/StatsTracking.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
@@ -426,6 +427,10 @@ void AuctionFarmer::program(SingleSwitchProgramEnvironment& env, BotBaseContext&
 
     AuctionFarmer_Descriptor::Stats& stats = env.current_stats<AuctionFarmer_Descriptor::Stats>();
 
+    //  Load the OCR data in the background so the first offer isn't slow.
+    OCR::prewarm_instances(LANGUAGE, 1);
+    OCR::prewarm_instances(Language::English, 1);
+
     //  Connect the controller.
     pbf_press_button(context, BUTTON_LCLICK, 10, 0);
     pbf_wait(context, TICKS_PER_SECOND);
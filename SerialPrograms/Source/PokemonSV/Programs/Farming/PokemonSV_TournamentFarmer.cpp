@@ -11,6 +11,7 @@
 #include "CommonFramework/InferenceInfra/InferenceRoutines.h"
 #include "CommonFramework/ImageTools/ImageFilter.h"
 #include "CommonFramework/Inference/BlackScreenDetector.h"
+#include "CommonFramework/OCR/OCR_RawOCR.h"
 //#include "CommonFramework/Tools/ErrorDumper.h"
 #include "CommonFramework/Tools/StatsTracking.h"
 #include "CommonFramework/Tools/VideoResolutionCheck.h"
@@ -651,6 +652,10 @@ void TournamentFarmer::program(SingleSwitchProgramEnvironment& env, BotBaseConte
     assert_16_9_720p_min(env.logger(), env.console);
     TournamentFarmer_Descriptor::Stats& stats = env.current_stats<TournamentFarmer_Descriptor::Stats>();
 
+    //  Load the OCR data in the background so the first prize isn't slow.
+    OCR::prewarm_instances(LANGUAGE, 1);
+    OCR::prewarm_instances(Language::English, 1);
+
     m_stop_after_current.store(false, std::memory_order_relaxed);
     STOP_AFTER_CURRENT.set_ready();
     ResetOnExit reset_button_on_exit(STOP_AFTER_CURRENT);
@@ -88,18 +88,18 @@ void wait_for_video_code_and_join(
         std::string code;
         switch (join_method.OCR_METHOD){
         case VideoFceOcrMethod::RAW_OCR:
-            code = OCR::ocr_read(Language::English, snapshot);
+            code = OCR::ocr_read(Language::English, snapshot, OCR::ReadPriority::HIGH);
             env.log("OCR: " + code);
             break;
         case VideoFceOcrMethod::BLACK_TEXT:{
             ImageRGB32 filtered = to_blackwhite_rgb32_range(snapshot, 0xff000000, 0xff7f7f7f, true);
-            code = OCR::ocr_read(Language::English, filtered);
+            code = OCR::ocr_read(Language::English, filtered, OCR::ReadPriority::HIGH);
             env.log("OCR: " + code);
             break;
         }
         case VideoFceOcrMethod::WHITE_TEXT:{
             ImageRGB32 filtered = to_blackwhite_rgb32_range(snapshot, 0xffc0c0c0, 0xffffffff, true);
-            code = OCR::ocr_read(Language::English, filtered);
+            code = OCR::ocr_read(Language::English, filtered, OCR::ReadPriority::HIGH);
             env.log("OCR: " + code);
             break;
         }
@@ -161,8 +161,9 @@ VideoFastCodeEntry::VideoFastCodeEntry()
     PA_ADD_OPTION(FCE_SETTINGS);
     PA_ADD_OPTION(NOTIFICATIONS);
 
-    //  Preload the OCR data.
-    OCR::ensure_instances(Language::English, 6);
+    //  Preload the OCR data. This happens in the background so it doesn't
+    //  hold up the UI.
+    OCR::prewarm_instances(Language::English, 6);
     preload_code_templates();
 }
 
@@ -339,26 +339,34 @@ std::vector<const ItemPrinterItemData*> make_item_prize_table(const std::vector<
 }
 
 
-std::vector<const ItemPrinterItemData*> make_item_prize_table(){
-    static const std::vector<ItemPrinterItemData>& PRIZE_LIST = make_item_prize_list();
-    return make_item_prize_table(PRIZE_LIST);
+const std::vector<ItemPrinterItemData>& item_prize_list(){
+    static const std::vector<ItemPrinterItemData> PRIZE_LIST = make_item_prize_list();
+    return PRIZE_LIST;
 }
-std::vector<const ItemPrinterItemData*> make_ball_prize_table(){
-    static const std::vector<ItemPrinterItemData>& PRIZE_LIST = make_ball_prize_list();
-    return make_item_prize_table(PRIZE_LIST);
+const std::vector<ItemPrinterItemData>& ball_prize_list(){
+    static const std::vector<ItemPrinterItemData> PRIZE_LIST = make_ball_prize_list();
+    return PRIZE_LIST;
 }
 
 
-enum class PrintMode{
-    Regular = 0,
-    ItemBonus = 1,
-    BallBonus = 2,
-};
+const char* item_printer_prize_slug(const std::string& slug){
+    for (const ItemPrinterItemData& item : item_prize_list()){
+        if (slug == item.slug){
+            return item.slug;
+        }
+    }
+    for (const ItemPrinterItemData& item : ball_prize_list()){
+        if (slug == item.slug){
+            return item.slug;
+        }
+    }
+    return nullptr;
+}
 
 
-std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
-    static const std::vector<const ItemPrinterItemData*> ITEM_TABLE = make_item_prize_table();
-    static const std::vector<const ItemPrinterItemData*> BALL_TABLE = make_ball_prize_table();
+void calculate_prizes(std::array<ItemPrinterPrize, 10>& prizes, int64_t seed, PrintMode mode){
+    static const std::vector<const ItemPrinterItemData*> ITEM_TABLE = make_item_prize_table(item_prize_list());
+    static const std::vector<const ItemPrinterItemData*> BALL_TABLE = make_item_prize_table(ball_prize_list());
 
     const std::vector<const ItemPrinterItemData*>& table = mode == PrintMode::BallBonus
         ? BALL_TABLE
@@ -367,7 +375,6 @@ std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
     Pokemon::Xoroshiro128Plus rand(seed, 0x82A2B175229D6A5B);
 
     PrintMode return_mode = PrintMode::Regular;
-    std::array<std::string, 10> ret;
     for (size_t c = 0; c < 10; c++){
         //  Always check for next bonus mode, even if not possible.
         uint64_t roll = rand.nextInt(1000);
@@ -376,13 +383,20 @@ std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
         //  Determine the item to print.
         uint64_t item_roll = rand.nextInt(table.size());
         const ItemPrinterItemData& item = *table[item_roll];
-        ret[c] = item.slug;
+        prizes[c].slug = item.slug;
 
         //  Determine quantity.
+        uint8_t quantity = item.min_quantity;
         if (item.min_quantity != item.max_quantity){
-            rand.nextInt(item.max_quantity - item.min_quantity + 1);
+            quantity += (uint8_t)rand.nextInt(item.max_quantity - item.min_quantity + 1);
         }
 
+        //  The item bonus doubles the quantity.
+        if (mode == PrintMode::ItemBonus){
+            quantity *= 2;
+        }
+        prizes[c].quantity = quantity;
+
         //  If we're lucky enough to get a bonus mode, pick one.
         //  Assume the player has both modes unlocked.
         //  If a bonus mode was previously set, don't recalculate.
@@ -391,7 +405,16 @@ std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
         }
 
     }
+}
+
+std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
+    std::array<ItemPrinterPrize, 10> prizes;
+    calculate_prizes(prizes, seed, mode);
 
+    std::array<std::string, 10> ret;
+    for (size_t c = 0; c < 10; c++){
+        ret[c] = prizes[c].slug;
+    }
     return ret;
 }
 
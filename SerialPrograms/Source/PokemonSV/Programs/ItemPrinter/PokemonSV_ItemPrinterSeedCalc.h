@@ -20,6 +20,27 @@ namespace PokemonSV{
 namespace ItemPrinter{
 
 
+enum class PrintMode{
+    Regular = 0,
+    ItemBonus = 1,
+    BallBonus = 2,
+};
+
+struct ItemPrinterPrize{
+    //  Points into a static table. Equal slugs have equal pointers.
+    const char* slug;
+    uint8_t quantity;
+};
+
+//  Return the pointer that "ItemPrinterPrize::slug" uses for this item.
+//  Returns null if the item can't be printed.
+const char* item_printer_prize_slug(const std::string& slug);
+
+//  Calculate the prizes and quantities for one print mode. Unlike
+//  "calculate_seed_prizes()", this doesn't allocate.
+void calculate_prizes(std::array<ItemPrinterPrize, 10>& prizes, int64_t seed, PrintMode mode);
+
+
 DateSeed calculate_seed_prizes(int64_t seed);
 
 
@@ -0,0 +1,165 @@
+/*  Item Printer Seed Search
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CancellableScope.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "PokemonSV_ItemPrinterSeedSearch.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+//  Seeds per unit of work. Each finished block reports progress.
+const uint64_t SEED_SEARCH_BLOCK_SIZE = (uint64_t)1 << 20;
+
+
+namespace{
+
+struct ResolvedTarget{
+    const char* slug;
+    uint16_t min_quantity;
+    double weight;
+};
+
+bool better_result(const SeedSearchResult& x, const SeedSearchResult& y){
+    if (x.score != y.score){
+        return x.score > y.score;
+    }
+    return x.seed < y.seed;
+}
+
+//  Keep the best "max_results" entries of "results", sorted.
+void trim_results(std::vector<SeedSearchResult>& results, size_t max_results){
+    if (results.size() > max_results){
+        std::nth_element(results.begin(), results.begin() + max_results, results.end(), better_result);
+        results.resize(max_results);
+    }
+    std::sort(results.begin(), results.end(), better_result);
+}
+
+}
+
+
+
+std::vector<SeedSearchResult> search_seeds(
+    const SeedSearchRequest& request,
+    const SeedSearchProgress& progress,
+    const Cancellable* cancellable
+){
+    if (request.jobs == 0 || request.jobs > 10){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid number of jobs: " + std::to_string(request.jobs));
+    }
+
+    std::vector<ResolvedTarget> targets;
+    for (const SeedSearchTarget& target : request.targets){
+        const char* slug = item_printer_prize_slug(target.slug);
+        if (slug == nullptr){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Item cannot be printed: " + target.slug);
+        }
+        targets.emplace_back(ResolvedTarget{slug, target.min_quantity, target.weight});
+    }
+
+    std::vector<SeedSearchResult> best;
+    if (request.start_seed >= request.end_seed || request.max_results == 0){
+        return best;
+    }
+
+    const uint64_t total = (uint64_t)request.end_seed - (uint64_t)request.start_seed;
+    const uint64_t blocks = (total + SEED_SEARCH_BLOCK_SIZE - 1) / SEED_SEARCH_BLOCK_SIZE;
+
+    size_t threads = request.threads;
+    if (threads == 0){
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = (size_t)std::min<uint64_t>(threads, blocks);
+
+    std::atomic<uint64_t> next_block(0);
+    std::mutex lock;
+    uint64_t seeds_searched = 0;
+
+    //  Each thread pulls blocks until there are none left.
+    AsyncDispatcher dispatcher(nullptr, threads);
+    dispatcher.run_in_parallel(
+        0, threads,
+        [&](size_t){
+            std::vector<SeedSearchResult> local;
+            std::array<ItemPrinterPrize, 10> prizes;
+            std::vector<uint32_t> quantities(targets.size());
+            while (true){
+                if (cancellable != nullptr && cancellable->cancelled()){
+                    return;
+                }
+                uint64_t block = next_block.fetch_add(1);
+                if (block >= blocks){
+                    return;
+                }
+
+                int64_t start = request.start_seed + (int64_t)(block * SEED_SEARCH_BLOCK_SIZE);
+                int64_t end = request.end_seed - start > (int64_t)SEED_SEARCH_BLOCK_SIZE
+                    ? start + (int64_t)SEED_SEARCH_BLOCK_SIZE
+                    : request.end_seed;
+
+                local.clear();
+                for (int64_t seed = start; seed < end; seed++){
+                    calculate_prizes(prizes, seed, request.mode);
+
+                    std::fill(quantities.begin(), quantities.end(), 0);
+                    for (size_t c = 0; c < request.jobs; c++){
+                        for (size_t t = 0; t < targets.size(); t++){
+                            if (prizes[c].slug == targets[t].slug){
+                                quantities[t] += prizes[c].quantity;
+                            }
+                        }
+                    }
+
+                    bool match = true;
+                    double score = 0;
+                    for (size_t t = 0; t < targets.size(); t++){
+                        match &= quantities[t] >= targets[t].min_quantity;
+                        score += targets[t].weight * quantities[t];
+                    }
+                    if (!match){
+                        continue;
+                    }
+
+                    local.emplace_back(SeedSearchResult{seed, score, prizes});
+                    if (local.size() >= 2 * request.max_results){
+                        trim_results(local, request.max_results);
+                    }
+                }
+                trim_results(local, request.max_results);
+
+                std::lock_guard<std::mutex> lg(lock);
+                best.insert(best.end(), local.begin(), local.end());
+                trim_results(best, request.max_results);
+                seeds_searched += end - start;
+                if (progress){
+                    progress(best, seeds_searched);
+                }
+            }
+        }
+    );
+
+    if (cancellable != nullptr){
+        cancellable->throw_if_cancelled();
+    }
+
+    return best;
+}
+
+
+
+}
+}
+}
+}
@@ -0,0 +1,86 @@
+/*  Item Printer Seed Search
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Search a range of date seeds for the ones that print the most of the
+ *  requested items.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSV_ItemPrinterSeedSearch_H
+#define PokemonAutomation_PokemonSV_ItemPrinterSeedSearch_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include "PokemonSV_ItemPrinterSeedCalc.h"
+
+namespace PokemonAutomation{
+    class Cancellable;
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+struct SeedSearchTarget{
+    std::string slug;
+
+    //  A seed is only a match if it prints at least this many of the item.
+    uint16_t min_quantity = 0;
+
+    //  How much each printed item adds to the score of a seed.
+    double weight = 1.0;
+};
+
+struct SeedSearchRequest{
+    //  Search the seeds in [start_seed, end_seed).
+    int64_t start_seed = 0;
+    int64_t end_seed = 0;
+
+    PrintMode mode = PrintMode::Regular;
+
+    //  Only the first "jobs" prizes of each seed are counted.
+    size_t jobs = 10;
+
+    std::vector<SeedSearchTarget> targets;
+
+    //  Keep this many of the best seeds.
+    size_t max_results = 100;
+
+    //  Number of threads to use. Zero uses all the cores.
+    size_t threads = 0;
+};
+
+struct SeedSearchResult{
+    int64_t seed;
+    double score;
+    std::array<ItemPrinterPrize, 10> prizes;
+};
+
+//  Called with the best seeds found so far, ranked from best to worst, and
+//  the number of seeds that have been searched.
+using SeedSearchProgress = std::function<void(const std::vector<SeedSearchResult>& best, uint64_t seeds_searched)>;
+
+
+//  Search the requested range in parallel and return the best seeds, ranked
+//  from best to worst. Ties go to the earlier seed.
+//
+//  "progress" is called each time a block of seeds finishes. It is called
+//  from the search threads, but never from two threads at the same time.
+//
+//  If "cancellable" is cancelled, the search stops early and this function
+//  throws the cancellation exception.
+std::vector<SeedSearchResult> search_seeds(
+    const SeedSearchRequest& request,
+    const SeedSearchProgress& progress = nullptr,
+    const Cancellable* cancellable = nullptr
+);
+
+
+
+}
+}
+}
+}
+#endif
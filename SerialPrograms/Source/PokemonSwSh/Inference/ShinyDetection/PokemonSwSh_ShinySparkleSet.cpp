@@ -6,7 +6,7 @@
 
 #include <sstream>
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
-#include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_ObjectList.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 #include "PokemonSwSh/PokemonSwSh_Settings.h"
 #include "PokemonSwSh_SparkleDetectorRadial.h"
@@ -85,11 +85,36 @@ void ShinySparkleSetSwSh::update_alphas(){
 
 
 
-ShinySparkleSetSwSh find_sparkles(WaterfillSession& session){
+//  Cheap bounds from the stats alone. An object that fails all of these
+//  cannot pass any of the sparkle checks below.
+bool is_sparkle_candidate(const WaterfillObjectList& objects, size_t index){
+    size_t area = objects.area(index);
+    size_t width = objects.width(index);
+    size_t height = objects.height(index);
+
+    //  Ball or star.
+    if (RadialSparkleDetector::MIN_AREA <= area && area <= RadialSparkleDetector::MAX_AREA){
+        return true;
+    }
+
+    //  Square: needs room in the box for a center hole of at least 20 pixels.
+    if (width >= 10 && height >= 10 && width * height >= area + 20){
+        return true;
+    }
+
+    //  Line: same size limits as is_line_sparkle() with its default width.
+    if (width >= 100 && height >= 5 && width * width >= area * 50 && width >= height * 10){
+        return true;
+    }
+
+    return false;
+}
+ShinySparkleSetSwSh find_sparkles(WaterfillObjectList& objects){
+    objects.filter(is_sparkle_candidate);
+
     ShinySparkleSetSwSh sparkles;
-    auto finder = session.make_iterator(20);
-    WaterfillObject object;
-    while (finder->find_next(object, true)){
+    for (size_t c = 0; c < objects.size(); c++){
+        WaterfillObject object = objects.materialize(c);
         RadialSparkleDetector radial_sparkle(object);
         if (radial_sparkle.is_ball()){
             sparkles.balls.emplace_back(object.min_x, object.min_y, object.max_x, object.max_y);
@@ -125,12 +150,12 @@ void ShinySparkleSetSwSh::read_from_image(const ImageViewRGB32& image){
             {0xffd0d000, 0xffffffff},
         }
     );
-    auto session = make_WaterfillSession();
+    WaterfillObjectList objects;
 
     double best_alpha = 0;
     for (PackedBinaryMatrix& matrix : matrices){
-        session->set_source(matrix);
-        ShinySparkleSetSwSh sparkles = find_sparkles(*session);
+        objects.find_objects_inplace(matrix, RadialSparkleDetector::MIN_AREA);
+        ShinySparkleSetSwSh sparkles = find_sparkles(objects);
         sparkles.update_alphas();
         double alpha = sparkles.alpha_overall();
         if (best_alpha < alpha){
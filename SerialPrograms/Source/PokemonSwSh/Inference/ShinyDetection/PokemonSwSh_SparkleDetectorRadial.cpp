@@ -30,10 +30,10 @@ RadialSparkleDetector::~RadialSparkleDetector(){}
 RadialSparkleDetector::RadialSparkleDetector(const WaterfillObject& object)
     : m_object(object)
 {
-    if (object.area < 20){
+    if (object.area < MIN_AREA){
         return;
     }
-    if (object.area > 10000){
+    if (object.area > MAX_AREA){
         return;
     }
 
@@ -22,6 +22,11 @@ namespace PokemonSwSh{
 struct RadialSparkleDetector{
     using WaterfillObject = Kernels::Waterfill::WaterfillObject;
 
+public:
+    //  Objects outside this range are never balls or stars.
+    static constexpr size_t MIN_AREA = 20;
+    static constexpr size_t MAX_AREA = 10000;
+
 public:
     ~RadialSparkleDetector();
     RadialSparkleDetector(const WaterfillObject& obj);
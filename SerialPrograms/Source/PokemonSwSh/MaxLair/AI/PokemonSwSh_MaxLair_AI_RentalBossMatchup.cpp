@@ -4,12 +4,16 @@
  *
  */
 
-#include <map>
+#include <cmath>
+#include <algorithm>
+#include <thread>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonObject.h"
 #include "CommonFramework/Globals.h"
 #include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Matchup.h"
 #include "PokemonSwSh_MaxLair_AI_RentalBossMatchup.h"
 
 namespace PokemonAutomation{
@@ -19,60 +23,179 @@ namespace MaxLairInternal{
 
 
 
-struct MatchupDatabase{
-    std::map<std::string, std::map<std::string, double>> map;
+RentalBossMatchupTable RentalBossMatchupTable::compute(uint8_t lives){
+    RentalBossMatchupTable table;
+    table.init_slugs();
 
-    static const MatchupDatabase& instance(){
-        static MatchupDatabase database;
-        return database;
-    }
-
-    double get(const std::string& rental, const std::string& boss) const{
-        auto iter0 = map.find(rental);
-        if (iter0 == map.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Rental not found: " + rental);
-        }
-        auto iter1 = iter0->second.find(boss);
-        if (iter1 == iter0->second.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + rental);
-        }
-        return iter1->second;
+    std::vector<size_t> rows;
+    for (size_t c = 0; c < table.rental_count(); c++){
+        rows.emplace_back(c);
     }
+    table.fill(rows, lives);
+    table.update_averages();
+    return table;
+}
 
-private:
-    MatchupDatabase(){
+const RentalBossMatchupTable& RentalBossMatchupTable::instance(){
+    static const RentalBossMatchupTable table = []{
         std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/boss_matchup_LUT.json";
         JsonValue json = load_json_file(path);
         JsonObject& root = json.to_object_throw(path);
+
+        RentalBossMatchupTable ret;
+        ret.init_slugs();
+
         for (auto& item0 : root){
-            std::map<std::string, double>& sub = map[item0.first];
+            auto rental = ret.m_rental_ids.find(item0.first);
+            if (rental == ret.m_rental_ids.end()){
+                continue;
+            }
+            double* row = ret.m_matrix.data() + rental->second * ret.boss_count();
             JsonObject& obj = item0.second.to_object_throw(path);
             for (auto& item1 : obj){
-                sub[item1.first] = item1.second.to_double_throw(path);
+                auto boss = ret.m_boss_ids.find(item1.first);
+                if (boss != ret.m_boss_ids.end()){
+                    row[boss->second] = item1.second.to_double_throw(path);
+                }
+            }
+        }
+
+        //  Computing missing entries here would stall the first AI decision
+        //  for a long time. The LUT must be regenerated instead.
+        for (size_t r = 0; r < ret.rental_count(); r++){
+            const double* row = ret.row(r);
+            for (size_t b = 0; b < ret.boss_count(); b++){
+                if (std::isnan(row[b])){
+                    throw InternalProgramError(
+                        nullptr, PA_CURRENT_FUNCTION,
+                        "Matchup LUT is out of date. Missing: " + ret.m_rental_slugs[r] + " vs. " + ret.m_boss_slugs[b] +
+                        ". Regenerate it with RentalBossMatchupTable::compute()."
+                    );
+                }
             }
         }
+
+        ret.update_averages();
+        return ret;
+    }();
+    return table;
+}
+
+void RentalBossMatchupTable::save_json(const std::string& path) const{
+    JsonObject root;
+    for (size_t r = 0; r < rental_count(); r++){
+        JsonObject obj;
+        const double* scores = row(r);
+        for (size_t b = 0; b < boss_count(); b++){
+            obj[m_boss_slugs[b]] = scores[b];
+        }
+        root[m_rental_slugs[r]] = std::move(obj);
     }
-};
+    root.dump(path);
+}
 
-double rental_vs_boss_matchup(const std::string& rental, const std::string& boss){
-    return MatchupDatabase::instance().get(rental, boss);
+
+size_t RentalBossMatchupTable::rental_id(const std::string& slug) const{
+    auto iter = m_rental_ids.find(slug);
+    if (iter == m_rental_ids.end()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Rental not found: " + slug);
+    }
+    return iter->second;
 }
-double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses){
+size_t RentalBossMatchupTable::boss_id(const std::string& slug) const{
+    auto iter = m_boss_ids.find(slug);
+    if (iter == m_boss_ids.end()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + slug);
+    }
+    return iter->second;
+}
+
+
+void RentalBossMatchupTable::init_slugs(){
     using namespace papkmnlib;
 
-    double score = 0;
-    if (bosses.empty()){
-        const auto& all_bosses = all_boss_pokemon();
-        for (const auto& boss : all_bosses){
-            score += rental_vs_boss_matchup(rental, boss.second.name());
+    m_rental_slugs.clear();
+    m_boss_slugs.clear();
+    for (const auto& item : all_rental_pokemon()){
+        m_rental_slugs.emplace_back(item.first);
+    }
+    for (const auto& item : all_boss_pokemon()){
+        m_boss_slugs.emplace_back(item.first);
+    }
+    m_rental_ids.clear();
+    m_boss_ids.clear();
+    for (size_t c = 0; c < m_rental_slugs.size(); c++){
+        m_rental_ids[m_rental_slugs[c]] = c;
+    }
+    for (size_t c = 0; c < m_boss_slugs.size(); c++){
+        m_boss_ids[m_boss_slugs[c]] = c;
+    }
+    m_matrix.assign(m_rental_slugs.size() * m_boss_slugs.size(), std::nan(""));
+}
+void RentalBossMatchupTable::fill(const std::vector<size_t>& rentals, uint8_t lives){
+    using namespace papkmnlib;
+
+    if (rentals.empty()){
+        return;
+    }
+
+    std::vector<const Pokemon*> bosses;
+    for (const std::string& slug : m_boss_slugs){
+        bosses.emplace_back(&get_pokemon(slug));
+    }
+
+    //  Every entry is independent, so each rental gets its own task.
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    AsyncDispatcher dispatcher(nullptr, std::min(threads, rentals.size()));
+    dispatcher.run_in_parallel(
+        0, rentals.size(),
+        [&](size_t index){
+            size_t r = rentals[index];
+            const Pokemon& rental = get_pokemon(m_rental_slugs[r]);
+            double* row = m_matrix.data() + r * bosses.size();
+            for (size_t b = 0; b < bosses.size(); b++){
+                row[b] = evaluate_matchup(rental, *bosses[b], {}, lives);
+            }
         }
-        score /= bosses.size();
-    }else{
-        for (const std::string& boss : bosses){
-            score += rental_vs_boss_matchup(rental, boss);
+    );
+}
+void RentalBossMatchupTable::update_averages(){
+    size_t rentals = rental_count();
+    size_t bosses = boss_count();
+    m_rental_averages.assign(rentals, 0);
+    m_boss_averages.assign(bosses, 0);
+    for (size_t r = 0; r < rentals; r++){
+        const double* scores = row(r);
+        double sum = 0;
+        for (size_t b = 0; b < bosses; b++){
+            sum += scores[b];
+            m_boss_averages[b] += scores[b];
         }
-        score /= bosses.size();
+        m_rental_averages[r] = bosses == 0 ? 0 : sum / bosses;
+    }
+    for (size_t b = 0; b < bosses; b++){
+        m_boss_averages[b] = rentals == 0 ? 0 : m_boss_averages[b] / rentals;
+    }
+}
+
+
+
+double rental_vs_boss_matchup(const std::string& rental, const std::string& boss){
+    const RentalBossMatchupTable& table = RentalBossMatchupTable::instance();
+    return table.get(table.rental_id(rental), table.boss_id(boss));
+}
+double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses){
+    const RentalBossMatchupTable& table = RentalBossMatchupTable::instance();
+    size_t rental_id = table.rental_id(rental);
+    if (bosses.empty()){
+        return table.average_over_bosses(rental_id);
+    }
+
+    double score = 0;
+    for (const std::string& boss : bosses){
+        score += table.get(rental_id, table.boss_id(boss));
     }
+    score /= bosses.size();
     return score;
 }
 
@@ -7,8 +7,10 @@
 #ifndef PokemonAutomation_PokemonSwSh_MaxLair_AI_RentalBossMatchup_H
 #define PokemonAutomation_PokemonSwSh_MaxLair_AI_RentalBossMatchup_H
 
+#include <stdint.h>
 #include <string>
 #include <vector>
+#include <map>
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -16,6 +18,67 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+//  Matchup score of every rental against every boss.
+//
+//  Slugs are interned to dense ids. The scores are stored in one contiguous
+//  row-major matrix: one row per rental, one column per boss. The averages of
+//  each row and each column are computed once when the table is built.
+class RentalBossMatchupTable{
+public:
+    //  The table loaded from "boss_matchup_LUT.json". It covers the rentals
+    //  and bosses in PkmnLib. Throws if the file is missing any of them.
+    //  Entries for Pokemon that PkmnLib doesn't have are ignored.
+    static const RentalBossMatchupTable& instance();
+
+    //  Compute the entire table from PkmnLib. This runs in parallel over the
+    //  rentals. Use with "save_json()" to regenerate the LUT after the move or
+    //  Pokemon data changes. (see TestProgramComputer)
+    static RentalBossMatchupTable compute(uint8_t lives = 4);
+
+    void save_json(const std::string& path) const;
+
+    size_t rental_count() const{ return m_rental_slugs.size(); }
+    size_t boss_count() const{ return m_boss_slugs.size(); }
+
+    const std::string& rental_slug(size_t rental) const{ return m_rental_slugs[rental]; }
+    const std::string& boss_slug(size_t boss) const{ return m_boss_slugs[boss]; }
+
+    //  Return the id of a slug. Throws if it isn't in the table.
+    size_t rental_id(const std::string& slug) const;
+    size_t boss_id(const std::string& slug) const;
+
+    double get(size_t rental, size_t boss) const{
+        return m_matrix[rental * m_boss_slugs.size() + boss];
+    }
+    const double* row(size_t rental) const{
+        return m_matrix.data() + rental * m_boss_slugs.size();
+    }
+
+    //  Average score of a rental against all bosses.
+    double average_over_bosses(size_t rental) const{ return m_rental_averages[rental]; }
+
+    //  Average score of all rentals against a boss.
+    double average_over_rentals(size_t boss) const{ return m_boss_averages[boss]; }
+
+
+private:
+    RentalBossMatchupTable() = default;
+    //  Use all the rentals and bosses in PkmnLib. All scores are set to NaN.
+    void init_slugs();
+    void fill(const std::vector<size_t>& rentals, uint8_t lives);
+    void update_averages();
+
+private:
+    std::vector<std::string> m_rental_slugs;
+    std::vector<std::string> m_boss_slugs;
+    std::map<std::string, size_t> m_rental_ids;
+    std::map<std::string, size_t> m_boss_ids;
+    std::vector<double> m_matrix;
+    std::vector<double> m_rental_averages;
+    std::vector<double> m_boss_averages;
+};
+
+
 double rental_vs_boss_matchup(const std::string& rental, const std::string& boss);
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses);
 
@@ -38,16 +38,23 @@ int8_t select_starter(
         return 0;
     }
 
+    const RentalBossMatchupTable& table = RentalBossMatchupTable::instance();
+    std::vector<size_t> boss_ids;
+    for (const Pokemon* boss : bosses){
+        boss_ids.emplace_back(table.boss_id(boss->name()));
+    }
+
     std::multimap<double, uint8_t, std::greater<double>> rank;
     for (uint8_t c = 0; c < 3; c++){
         if (options[c].empty()){
             continue;
         }
 //        const Pokemon& rental = get_pokemon(options[c]);
+        const double* scores = table.row(table.rental_id(options[c]));
         double score = 0;
-        for (const Pokemon* boss : bosses){
+        for (size_t boss : boss_ids){
 //            score += evaluate_matchup(rental, *boss, {}, 4);
-            score += rental_vs_boss_matchup(options[c], boss->name());
+            score += scores[boss];
         }
         score /= bosses.size();
         rank.emplace(score, c);
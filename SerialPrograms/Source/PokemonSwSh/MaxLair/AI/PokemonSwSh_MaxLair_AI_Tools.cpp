@@ -97,20 +97,19 @@ double rental_vs_boss_matchup(const std::string& rental, const std::vector<const
     if (bosses.empty()){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss list cannot be empty.");
     }
+    const RentalBossMatchupTable& table = RentalBossMatchupTable::instance();
     double score = 0;
     if (rental.empty()){
         for (const Pokemon* boss : bosses){
-            for (const auto& candidate : all_rental_pokemon()){
-                score += rental_vs_boss_matchup(candidate.first, boss->name());
-            }
+            score += table.average_over_rentals(table.boss_id(boss->name()));
         }
-        score /= bosses.size() * all_rental_pokemon().size();
     }else{
+        size_t rental_id = table.rental_id(rental);
         for (const Pokemon* boss : bosses){
-            score += rental_vs_boss_matchup(rental, boss->name());
+            score += table.get(rental_id, table.boss_id(boss->name()));
         }
-        score /= bosses.size();
     }
+    score /= bosses.size();
     return score;
 }
 double rental_vs_boss_matchup(const papkmnlib::Pokemon* rental, const std::vector<const papkmnlib::Pokemon*>& bosses){
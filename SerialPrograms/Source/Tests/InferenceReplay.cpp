@@ -0,0 +1,353 @@
+/*  Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <sstream>
+#include <thread>
+#include <QDir>
+#include "Common/Cpp/PrettyPrint.h"
+#include "ClientSource/Connection/BotBase.h"
+#include "CommonFramework/AudioPipeline/AudioConstants.h"
+#include "CommonFramework/AudioPipeline/AudioTemplate.h"
+#include "CommonFramework/InferenceInfra/InferenceRoutines.h"
+#include "InferenceReplay.h"
+
+namespace PokemonAutomation{
+
+
+
+ReplayVideoFeed::ReplayVideoFeed(ReplaySpeed speed)
+    : m_speed(speed)
+    , m_fps(0)
+    , m_start(current_time())
+{}
+ReplayVideoFeed::ReplayVideoFeed(std::vector<ImageRGB32> frames, double fps, ReplaySpeed speed)
+    : m_speed(speed)
+    , m_fps(fps)
+    , m_start(current_time())
+{
+    for (ImageRGB32& frame : frames){
+        m_frames.emplace_back(std::make_shared<const ImageRGB32>(std::move(frame)));
+    }
+}
+std::vector<ImageRGB32> ReplayVideoFeed::load_frames(const std::string& directory){
+    QDir dir(QString::fromStdString(directory));
+    dir.setNameFilters({"*.png", "*.jpg", "*.jpeg", "*.bmp"});
+    dir.setFilter(QDir::Files);
+    dir.setSorting(QDir::Name);
+
+    std::vector<ImageRGB32> frames;
+    for (const QFileInfo& info : dir.entryInfoList()){
+        frames.emplace_back(info.filePath().toStdString());
+    }
+    return frames;
+}
+
+void ReplayVideoFeed::start(WallClock start, const Cancellable* scope){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_started = true;
+    m_scope = scope;
+    m_start = start;
+    m_next = 0;
+    m_finished = false;
+    m_served = 0;
+    m_skipped = 0;
+}
+void ReplayVideoFeed::stop(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_started = false;
+    m_scope = nullptr;
+}
+bool ReplayVideoFeed::finished() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_frames.empty()){
+        return true;
+    }
+    if (m_speed == ReplaySpeed::REAL_TIME){
+        return current_time() >= m_start + frame_time(m_frames.size());
+    }
+    return m_finished;
+}
+std::chrono::microseconds ReplayVideoFeed::position() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_next == 0 ? std::chrono::microseconds(0) : frame_time(m_next - 1);
+}
+uint64_t ReplayVideoFeed::frames_served() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_served;
+}
+uint64_t ReplayVideoFeed::frames_skipped() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_skipped;
+}
+std::chrono::microseconds ReplayVideoFeed::frame_time(size_t index) const{
+    return std::chrono::microseconds((int64_t)(index * 1000000. / m_fps));
+}
+
+VideoSnapshot ReplayVideoFeed::snapshot(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_frames.empty()){
+        m_finished = true;
+        return VideoSnapshot();
+    }
+
+    //  The callbacks are attached before playback starts. Show them the first
+    //  frame until then.
+    if (!m_started){
+        return VideoSnapshot(m_frames[0], m_start);
+    }
+
+    size_t index = 0;
+    if (m_scope != nullptr && m_scope->cancelled()){
+        //  Something triggered. Stay on the frame that triggered it.
+        index = m_next == 0 ? 0 : m_next - 1;
+    }else switch (m_speed){
+    case ReplaySpeed::REAL_TIME:{
+        int64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - m_start).count();
+        index = elapsed <= 0 ? 0 : (size_t)(elapsed * m_fps / 1000000);
+        break;
+    }
+    case ReplaySpeed::AS_FAST_AS_POSSIBLE:
+        index = m_next;
+        break;
+    }
+    if (index >= m_frames.size()){
+        m_finished = true;
+        index = m_frames.size() - 1;
+    }
+
+    //  A frame that nobody has seen yet.
+    if (index >= m_next){
+        m_skipped += index - m_next;
+        m_served++;
+        m_next = index + 1;
+    }
+
+    return VideoSnapshot(m_frames[index], m_start + frame_time(index), index + 1);
+}
+
+
+
+ReplayAudioFeed::ReplayAudioFeed(ReplaySpeed speed)
+    : m_speed(speed)
+    , m_sample_rate(48000)
+    , m_start(current_time())
+{}
+ReplayAudioFeed::ReplayAudioFeed(const std::string& filename, ReplaySpeed speed, size_t sample_rate)
+    : m_speed(speed)
+    , m_sample_rate(sample_rate)
+    , m_start(current_time())
+{
+    AudioTemplate audio = loadAudioTemplate(filename, sample_rate);
+    for (size_t c = 0; c < audio.numWindows(); c++){
+        AlignedVector<float> magnitudes(audio.numFrequencies());
+        memcpy(magnitudes.data(), audio.getWindow(c), sizeof(float) * audio.numFrequencies());
+        m_spectrums.emplace_back(c, sample_rate, std::make_shared<const AlignedVector<float>>(std::move(magnitudes)));
+    }
+}
+
+void ReplayAudioFeed::start(WallClock start, const Cancellable* scope){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_started = true;
+    m_scope = scope;
+    m_start = start;
+    m_available = 0;
+    m_finished = false;
+}
+void ReplayAudioFeed::stop(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_started = false;
+    m_scope = nullptr;
+}
+bool ReplayAudioFeed::finished() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_spectrums.empty()){
+        return true;
+    }
+    if (m_speed == ReplaySpeed::REAL_TIME){
+        return current_time() >= m_start + spectrum_time(m_spectrums.size() - 1);
+    }
+    return m_finished;
+}
+std::chrono::microseconds ReplayAudioFeed::position() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_available == 0 ? std::chrono::microseconds(0) : spectrum_time(m_available - 1);
+}
+uint64_t ReplayAudioFeed::spectrums_served() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_available;
+}
+std::chrono::microseconds ReplayAudioFeed::spectrum_time(size_t index) const{
+    //  A spectrum is available once the last sample of its window is in.
+    size_t samples = index * FFT_SLIDING_WINDOW_STEP + NUM_FFT_SAMPLES;
+    return std::chrono::microseconds((int64_t)(samples * 1000000 / m_sample_rate));
+}
+
+size_t ReplayAudioFeed::advance(){
+    //  Nothing has been played before playback starts.
+    if (!m_started){
+        return 0;
+    }
+    if (m_scope != nullptr && m_scope->cancelled()){
+        return m_available;
+    }
+    switch (m_speed){
+    case ReplaySpeed::REAL_TIME:{
+        std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - m_start);
+        while (m_available < m_spectrums.size() && spectrum_time(m_available) <= elapsed){
+            m_available++;
+        }
+        break;
+    }
+    case ReplaySpeed::AS_FAST_AS_POSSIBLE:
+        if (m_available < m_spectrums.size()){
+            m_available++;
+        }else{
+            m_finished = true;
+        }
+        break;
+    }
+    return m_available;
+}
+void ReplayAudioFeed::load_spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_seqnum){
+    spectrums.clear();
+    std::lock_guard<std::mutex> lg(m_lock);
+    size_t available = advance();
+    for (size_t c = available; c > starting_seqnum; c--){
+        spectrums.emplace_back(m_spectrums[c - 1]);
+    }
+}
+void ReplayAudioFeed::load_spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_last_spectrums){
+    spectrums.clear();
+    std::lock_guard<std::mutex> lg(m_lock);
+    size_t available = advance();
+    for (size_t c = available; c > 0 && spectrums.size() < num_last_spectrums; c--){
+        spectrums.emplace_back(m_spectrums[c - 1]);
+    }
+}
+
+
+
+double InferenceReplayStats::frames_per_second() const{
+    return wall_time.count() == 0 ? 0 : frames_served * 1000000. / wall_time.count();
+}
+double InferenceReplayStats::spectrums_per_second() const{
+    return wall_time.count() == 0 ? 0 : spectrums_served * 1000000. / wall_time.count();
+}
+std::string InferenceReplayStats::to_str() const{
+    std::stringstream ss;
+    ss << "Wall Time: " << tostr_fixed(wall_time.count() / 1000., 3) << " ms";
+    ss << ", Frames: " << frames_served << " (" << tostr_fixed(frames_per_second(), 2) << "/s, " << frames_skipped << " skipped)";
+    ss << ", Spectrums: " << spectrums_served << " (" << tostr_fixed(spectrums_per_second(), 2) << "/s)";
+    if (triggered_index >= 0){
+        ss << ", Callback " << triggered_index << " triggered at " << tostr_fixed(detection_position.count() / 1000., 3) << " ms";
+    }else{
+        ss << ", Nothing triggered";
+    }
+    return ss.str();
+}
+
+
+
+InferenceReplay::InferenceReplay(Logger& logger, ReplayVideoFeed& video, ReplayAudioFeed& audio)
+    : m_video(video)
+    , m_audio(audio)
+    , m_dispatcher(nullptr, 2)
+    , m_botbase(logger)
+    , m_console(0, logger, &m_botbase, video, m_overlay, audio)
+{
+    m_console.initialize_inference_threads(m_scope, m_dispatcher);
+}
+
+InferenceReplayStats InferenceReplay::run(
+    const std::vector<PeriodicInferenceCallback>& callbacks,
+    std::chrono::milliseconds linger
+){
+    if (m_video.speed() == ReplaySpeed::AS_FAST_AS_POSSIBLE){
+        return run(callbacks, std::chrono::milliseconds(0), std::chrono::milliseconds(0), linger);
+    }else{
+        return run(callbacks, std::chrono::milliseconds(50), std::chrono::milliseconds(20), linger);
+    }
+}
+InferenceReplayStats InferenceReplay::run(
+    const std::vector<PeriodicInferenceCallback>& callbacks,
+    std::chrono::milliseconds video_period,
+    std::chrono::milliseconds audio_period,
+    std::chrono::milliseconds linger
+){
+    //  Only wait for the feeds that something is reading.
+    bool has_video = false;
+    bool has_audio = false;
+    for (const PeriodicInferenceCallback& callback : callbacks){
+        if (callback.callback == nullptr){
+            continue;
+        }
+        switch (callback.callback->type()){
+        case InferenceType::VISUAL:
+            has_video = true;
+            break;
+        case InferenceType::AUDIO:
+            has_audio = true;
+            break;
+        }
+    }
+
+    const bool real_time = m_video.speed() == ReplaySpeed::REAL_TIME;
+
+    InferenceReplayStats stats;
+    WallClock start = current_time();
+    BotBaseContext context(m_scope, m_botbase);
+    stats.triggered_index = run_until(
+        m_console, context,
+        [&](BotBaseContext& context){
+            //  The callbacks are attached now. Start the feeds with the scope
+            //  that the callbacks will cancel when they trigger.
+            start = current_time();
+            m_video.start(start, &context);
+            m_audio.start(start, &context);
+            while ((has_video && !m_video.finished()) || (has_audio && !m_audio.finished())){
+                if (real_time){
+                    context.wait_for(std::chrono::milliseconds(1));
+                }else{
+                    //  The pivots are running back-to-back. Sleeping here
+                    //  would make the callbacks run over the last frame
+                    //  hundreds of times.
+                    context.throw_if_cancelled();
+                    std::this_thread::yield();
+                }
+            }
+            context.wait_for(linger);
+        },
+        callbacks,
+        video_period, audio_period
+    );
+    stats.wall_time = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - start);
+    m_video.stop();
+    m_audio.stop();
+
+    stats.frames_served = m_video.frames_served();
+    stats.frames_skipped = m_video.frames_skipped();
+    stats.spectrums_served = m_audio.spectrums_served();
+
+    //  The feeds stopped advancing when the callback triggered. In
+    //  AS_FAST_AS_POSSIBLE they don't advance together, so use the one that
+    //  the triggered callback was reading.
+    if (stats.triggered_index >= 0){
+        stats.detection_position = callbacks[stats.triggered_index].callback->type() == InferenceType::VISUAL
+            ? m_video.position()
+            : m_audio.position();
+    }else{
+        stats.detection_position = std::max(m_video.position(), m_audio.position());
+    }
+
+    return stats;
+}
+
+
+
+
+}
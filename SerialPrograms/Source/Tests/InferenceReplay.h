@@ -0,0 +1,214 @@
+/*  Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Replay a recorded session through the real inference pivots.
+ *
+ *  The detector tests feed single images or spectrums directly to a detector.
+ *  This instead plays back a sequence of frames and a WAV file through
+ *  "VideoFeed" and "AudioFeed" implementations, so callbacks run exactly as
+ *  they do in a program: batched in the pivots, at their periods, through
+ *  "run_until()". This lets whole-program inference loads be profiled offline.
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_InferenceReplay_H
+#define PokemonAutomation_Tests_InferenceReplay_H
+
+#include <stdint.h>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include "Common/Cpp/CancellableScope.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "CommonFramework/InferenceInfra/InferenceCallback.h"
+#include "TestUtils.h"
+
+namespace PokemonAutomation{
+
+
+enum class ReplaySpeed{
+    //  Play the recording at the speed it was recorded. Frames that the
+    //  inference is too slow to look at are skipped, just like a live feed.
+    REAL_TIME,
+
+    //  Every snapshot returns the next frame and every audio request returns
+    //  the next spectrum. Nothing is skipped and nothing waits.
+    //  Detectors that measure wall-clock time will see the time compressed.
+    AS_FAST_AS_POSSIBLE,
+};
+
+
+
+//  A video feed that plays back a list of frames at a fixed frame rate.
+class ReplayVideoFeed : public VideoFeed{
+public:
+    //  An empty feed. Snapshots are always null.
+    ReplayVideoFeed(ReplaySpeed speed);
+
+    ReplayVideoFeed(std::vector<ImageRGB32> frames, double fps, ReplaySpeed speed);
+
+    ReplaySpeed speed() const{ return m_speed; }
+
+    //  Load every image in "directory" sorted by filename.
+    static std::vector<ImageRGB32> load_frames(const std::string& directory);
+
+    //  Start playback. The frame timestamps are relative to "start".
+    //  Until this is called, snapshots return the first frame.
+    //
+    //  Once "scope" is cancelled, the feed stops advancing. So the position
+    //  stays at the frame that triggered the cancel.
+    void start(WallClock start, const Cancellable* scope = nullptr);
+    void stop();
+
+    //  True once the recording is over. In AS_FAST_AS_POSSIBLE, this is when
+    //  something asks for a frame after the last one has been handed out.
+    bool finished() const;
+
+    //  The time in the recording of the last frame that was handed out.
+    std::chrono::microseconds position() const;
+
+    uint64_t frames_served() const;
+    uint64_t frames_skipped() const;
+
+    virtual void reset() override{}
+    virtual VideoSnapshot snapshot() override;
+    virtual double fps_source() override{ return m_fps; }
+    virtual double fps_display() override{ return m_fps; }
+
+private:
+    std::chrono::microseconds frame_time(size_t index) const;
+
+private:
+    const ReplaySpeed m_speed;
+    const double m_fps;
+    std::vector<std::shared_ptr<const ImageRGB32>> m_frames;
+
+    mutable std::mutex m_lock;
+    bool m_started = false;
+    const Cancellable* m_scope = nullptr;
+    WallClock m_start;
+    size_t m_next = 0;
+    bool m_finished = false;
+    uint64_t m_served = 0;
+    uint64_t m_skipped = 0;
+};
+
+
+
+//  An audio feed that plays back the spectrums of a WAV file.
+class ReplayAudioFeed : public AudioFeed{
+public:
+    //  An empty feed. There are never any spectrums.
+    ReplayAudioFeed(ReplaySpeed speed);
+
+    ReplayAudioFeed(const std::string& filename, ReplaySpeed speed, size_t sample_rate = 48000);
+
+    //  Same as "ReplayVideoFeed::start()". Until this is called, there are
+    //  no spectrums.
+    void start(WallClock start, const Cancellable* scope = nullptr);
+    void stop();
+
+    //  True once the recording is over. In AS_FAST_AS_POSSIBLE, this is when
+    //  something asks for spectrums after the last one has been handed out.
+    bool finished() const;
+
+    //  The time in the recording of the last spectrum that was handed out.
+    std::chrono::microseconds position() const;
+
+    uint64_t spectrums_served() const;
+
+    virtual void reset() override{}
+    virtual void load_spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_seqnum) override;
+    virtual void load_spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_last_spectrums) override;
+    virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) override{}
+
+private:
+    //  Release the spectrums that are now available. Returns the number of
+    //  spectrums that are available.
+    size_t advance();
+    std::chrono::microseconds spectrum_time(size_t index) const;
+
+private:
+    const ReplaySpeed m_speed;
+    const size_t m_sample_rate;
+    std::vector<AudioSpectrum> m_spectrums;
+
+    mutable std::mutex m_lock;
+    bool m_started = false;
+    const Cancellable* m_scope = nullptr;
+    WallClock m_start;
+    size_t m_available = 0;
+    bool m_finished = false;
+};
+
+
+
+struct InferenceReplayStats{
+    //  Same as the return value of "run_until()".
+    int triggered_index = -1;
+
+    //  How long the replay took.
+    std::chrono::microseconds wall_time = std::chrono::microseconds(0);
+
+    //  The time in the recording when the replay stopped. When a callback
+    //  triggers, this is when it detected its target.
+    std::chrono::microseconds detection_position = std::chrono::microseconds(0);
+
+    uint64_t frames_served = 0;
+    uint64_t frames_skipped = 0;
+    uint64_t spectrums_served = 0;
+
+    double frames_per_second() const;
+    double spectrums_per_second() const;
+
+    std::string to_str() const;
+};
+
+
+
+//  Runs inference callbacks over a replayed session.
+//
+//  Construct the callbacks using "console()", then call "run()". The latency
+//  stats of each callback are logged to "logger" when "run()" returns, the
+//  same as in a program.
+class InferenceReplay{
+public:
+    InferenceReplay(Logger& logger, ReplayVideoFeed& video, ReplayAudioFeed& audio);
+
+    ConsoleHandle& console(){ return m_console; }
+
+    //  Play back the recording until either it ends or a callback triggers.
+    //
+    //  "linger" is how long to keep running the callbacks after the recording
+    //  ends. Some detectors wait a bit after a match before reporting it.
+    //
+    //  If the periods are zero, the pivots run the callbacks back-to-back.
+    //  This is the default for AS_FAST_AS_POSSIBLE.
+    InferenceReplayStats run(
+        const std::vector<PeriodicInferenceCallback>& callbacks,
+        std::chrono::milliseconds linger = std::chrono::milliseconds(500)
+    );
+    InferenceReplayStats run(
+        const std::vector<PeriodicInferenceCallback>& callbacks,
+        std::chrono::milliseconds video_period,
+        std::chrono::milliseconds audio_period,
+        std::chrono::milliseconds linger = std::chrono::milliseconds(500)
+    );
+
+private:
+    ReplayVideoFeed& m_video;
+    ReplayAudioFeed& m_audio;
+    AsyncDispatcher m_dispatcher;
+    CancellableHolder<CancellableScope> m_scope;
+    DummyBotBase m_botbase;
+    DummyVideoOverlay m_overlay;
+    ConsoleHandle m_console;
+};
+
+
+
+}
+#endif
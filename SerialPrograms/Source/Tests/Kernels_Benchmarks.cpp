@@ -0,0 +1,583 @@
+/*  Kernels Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <iostream>
+#include "Common/Cpp/Color.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "Kernels/AbsFFT/Kernels_AbsFFT.h"
+#include "Kernels/AudioStreamConversion/AudioStreamConversion.h"
+#include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "Kernels/ImageConvert/Kernels_ImageConvert_HSV32.h"
+#include "Kernels/ImageGradient/Kernels_ImageGradient.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic.h"
+#include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h"
+#include "Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h"
+#include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
+#include "Kernels/Waterfill/Kernels_Waterfill.h"
+#include "Kernels_Benchmarks.h"
+
+using std::cout;
+using std::endl;
+
+namespace PokemonAutomation{
+
+using namespace Kernels;
+
+
+const char* KERNEL_BENCHMARK_OUTPUT = "KernelBenchmarks.json";
+
+
+namespace{
+
+
+//  Each kernel is run for at least this long (and at least this many times)
+//  before any samples are taken.
+const std::chrono::milliseconds WARMUP_DURATION(50);
+const size_t WARMUP_MIN_REPETITIONS = 3;
+
+//  Samples are collected until both the minimum count and the time budget are
+//  reached, or until the maximum count is hit.
+const std::chrono::milliseconds SAMPLE_DURATION(500);
+const size_t SAMPLE_MIN_REPETITIONS = 10;
+const size_t SAMPLE_MAX_REPETITIONS = 10000;
+
+const std::vector<std::pair<size_t, size_t>> IMAGE_SIZES{
+    {640, 360},
+    {1280, 720},
+    {1920, 1080},
+};
+
+
+
+struct BenchmarkStats{
+    size_t repetitions = 0;
+    double min_us = 0;
+    double median_us = 0;
+    double mean_us = 0;
+    double stddev_us = 0;
+};
+
+//  Run "setup" untimed, then "body" timed, for every repetition.
+template <typename SetupFunction, typename BodyFunction>
+BenchmarkStats run_benchmark(SetupFunction&& setup, BodyFunction&& body){
+    WallClock warmup_end = current_time() + WARMUP_DURATION;
+    for (size_t c = 0; c < WARMUP_MIN_REPETITIONS || current_time() < warmup_end; c++){
+        setup();
+        body();
+    }
+
+    std::vector<double> samples;
+    WallClock sample_end = current_time() + SAMPLE_DURATION;
+    while (samples.size() < SAMPLE_MAX_REPETITIONS){
+        if (samples.size() >= SAMPLE_MIN_REPETITIONS && current_time() >= sample_end){
+            break;
+        }
+        setup();
+        WallClock time_start = current_time();
+        body();
+        WallClock time_end = current_time();
+        samples.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count() / 1000.);
+    }
+
+    BenchmarkStats stats;
+    stats.repetitions = samples.size();
+
+    double sum = 0;
+    for (double x : samples){
+        sum += x;
+    }
+    stats.mean_us = sum / samples.size();
+
+    double sum_sqr = 0;
+    for (double x : samples){
+        double diff = x - stats.mean_us;
+        sum_sqr += diff * diff;
+    }
+    stats.stddev_us = std::sqrt(sum_sqr / samples.size());
+
+    std::sort(samples.begin(), samples.end());
+    stats.min_us = samples.front();
+    size_t mid = samples.size() / 2;
+    stats.median_us = samples.size() % 2 ? samples[mid] : (samples[mid - 1] + samples[mid]) / 2;
+
+    return stats;
+}
+template <typename BodyFunction>
+BenchmarkStats run_benchmark(BodyFunction&& body){
+    return run_benchmark([]{}, std::forward<BodyFunction>(body));
+}
+
+
+
+class BenchmarkReport{
+public:
+    BenchmarkReport(const CpuCapabilityOption& isa)
+        : m_isa(isa)
+    {}
+
+    void add(
+        JsonArray& results,
+        const std::string& kernel, const std::string& size,
+        const BenchmarkStats& stats
+    ) const{
+        cout << m_isa.slug << " | " << kernel << " | " << size
+             << " | median: " << stats.median_us << " us"
+             << ", min: " << stats.min_us << " us"
+             << ", mean: " << stats.mean_us << " us"
+             << ", stddev: " << stats.stddev_us << " us"
+             << ", reps: " << stats.repetitions << endl;
+
+        JsonObject obj;
+        obj["Kernel"] = kernel;
+        obj["ISA"] = m_isa.slug;
+        obj["Size"] = size;
+        obj["Repetitions"] = stats.repetitions;
+        obj["Min (us)"] = stats.min_us;
+        obj["Median (us)"] = stats.median_us;
+        obj["Mean (us)"] = stats.mean_us;
+        obj["StdDev (us)"] = stats.stddev_us;
+        results.push_back(std::move(obj));
+    }
+
+private:
+    const CpuCapabilityOption& m_isa;
+};
+
+
+//  Restores CPU_CAPABILITY_CURRENT even if a kernel throws.
+class CpuCapabilityScope{
+public:
+    CpuCapabilityScope()
+        : m_saved(CPU_CAPABILITY_CURRENT)
+    {}
+    ~CpuCapabilityScope(){
+        CPU_CAPABILITY_CURRENT = m_saved;
+    }
+private:
+    CPU_Features m_saved;
+};
+
+
+
+//  Prevents the compiler from optimizing away kernels whose only output is a
+//  return value.
+size_t execution_enforcer = 0;
+
+
+
+void benchmark_image_kernels(
+    JsonArray& results, const BenchmarkReport& report,
+    const ImageViewRGB32& image
+){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    const std::string size = std::to_string(width) + "x" + std::to_string(height);
+
+    const uint32_t mins = combine_rgb(0, 0, 0);
+    const uint32_t maxs = combine_rgb(63, 63, 63);
+    const uint32_t expected = image.pixel(width / 2, height / 2);
+    const double max_euclidean_distance = 50;
+
+    ImageRGB32 out(width, height);
+
+    //  ImageScaleBrightness
+    report.add(results, "ImageScaleBrightness::scale_brightness", size, run_benchmark(
+        [&]{
+            scale_brightness(width, height, out.data(), out.bytes_per_row(), 1.2f, 1.3f, 0.5f);
+        }
+    ));
+
+    //  ImageConvert
+    report.add(results, "ImageConvert::convert_rgb32_to_hsv32", size, run_benchmark(
+        [&]{
+            convert_rgb32_to_hsv32(
+                image.data(), image.bytes_per_row(),
+                out.data(), out.bytes_per_row(),
+                width, height
+            );
+        }
+    ));
+    report.add(results, "ImageConvert::convert_hsv32_to_rgb32", size, run_benchmark(
+        [&]{
+            convert_hsv32_to_rgb32(
+                image.data(), image.bytes_per_row(),
+                out.data(), out.bytes_per_row(),
+                width, height
+            );
+        }
+    ));
+
+    //  ImageGradient
+    report.add(results, "ImageGradient::smooth_rgb32", size, run_benchmark(
+        [&]{
+            smooth_rgb32(
+                image.data(), image.bytes_per_row(),
+                out.data(), out.bytes_per_row(),
+                width, height
+            );
+        }
+    ));
+    report.add(results, "ImageGradient::sobel_gradient_rgb32", size, run_benchmark(
+        [&]{
+            sobel_gradient_rgb32(
+                image.data(), image.bytes_per_row(),
+                out.data(), out.bytes_per_row(),
+                width, height
+            );
+        }
+    ));
+    report.add(results, "ImageGradient::sobel_orientation_histogram_rgb32", size, run_benchmark(
+        [&]{
+            size_t bins[SOBEL_ORIENTATION_BINS];
+            execution_enforcer += sobel_orientation_histogram_rgb32(
+                image.data(), image.bytes_per_row(), width, height, 2000, bins
+            );
+        }
+    ));
+
+    //  ImageFilters
+    report.add(results, "ImageFilters::filter_rgb32_range", size, run_benchmark(
+        [&]{
+            execution_enforcer += filter_rgb32_range(
+                image.data(), image.bytes_per_row(), width, height,
+                out.data(), out.bytes_per_row(), mins, maxs, (uint32_t)COLOR_WHITE, true
+            );
+        }
+    ));
+    {
+        std::vector<ImageRGB32> outs;
+        std::vector<FilterRgb32RangeFilter> filters;
+        for (size_t c = 0; c < 4; c++){
+            outs.emplace_back(width, height);
+        }
+        report.add(results, "ImageFilters::filter_rgb32_range (x4)", size, run_benchmark(
+            [&]{
+                filters.clear();
+                for (size_t c = 0; c < 4; c++){
+                    filters.emplace_back(
+                        outs[c].data(), outs[c].bytes_per_row(),
+                        mins, combine_rgb(uint8_t(63 + 64*c), uint8_t(63 + 64*c), uint8_t(63 + 64*c)),
+                        (uint32_t)COLOR_WHITE, false
+                    );
+                }
+            },
+            [&]{
+                filter_rgb32_range(image.data(), image.bytes_per_row(), width, height, filters.data(), filters.size());
+            }
+        ));
+    }
+    report.add(results, "ImageFilters::filter_rgb32_euclidean", size, run_benchmark(
+        [&]{
+            execution_enforcer += filter_rgb32_euclidean(
+                image.data(), image.bytes_per_row(), width, height,
+                out.data(), out.bytes_per_row(), expected, max_euclidean_distance, (uint32_t)COLOR_WHITE, true
+            );
+        }
+    ));
+    report.add(results, "ImageFilters::to_blackwhite_rgb32_range", size, run_benchmark(
+        [&]{
+            execution_enforcer += to_blackwhite_rgb32_range(
+                image.data(), image.bytes_per_row(), width, height,
+                out.data(), out.bytes_per_row(), mins, maxs, true
+            );
+        }
+    ));
+
+    //  BinaryImageFilters
+    std::unique_ptr<PackedBinaryMatrix_IB> matrix = make_PackedBinaryMatrix(get_BinaryMatrixType(), width, height);
+    report.add(results, "BinaryImageFilters::compress_rgb32_to_binary_range", size, run_benchmark(
+        [&]{
+            compress_rgb32_to_binary_range(image.data(), image.bytes_per_row(), *matrix, mins, maxs);
+        }
+    ));
+    {
+        std::vector<std::unique_ptr<PackedBinaryMatrix_IB>> matrices;
+        std::vector<CompressRgb32ToBinaryRangeFilter> filters;
+        for (size_t c = 0; c < 4; c++){
+            matrices.emplace_back(make_PackedBinaryMatrix(get_BinaryMatrixType(), width, height));
+            filters.emplace_back(
+                *matrices.back(),
+                mins, combine_rgb(uint8_t(63 + 64*c), uint8_t(63 + 64*c), uint8_t(63 + 64*c))
+            );
+        }
+        report.add(results, "BinaryImageFilters::compress_rgb32_to_binary_range (x4)", size, run_benchmark(
+            [&]{
+                compress_rgb32_to_binary_range(image.data(), image.bytes_per_row(), filters.data(), filters.size());
+            }
+        ));
+    }
+    report.add(results, "BinaryImageFilters::compress_rgb32_to_binary_euclidean", size, run_benchmark(
+        [&]{
+            compress_rgb32_to_binary_euclidean(
+                image.data(), image.bytes_per_row(), *matrix, expected, max_euclidean_distance
+            );
+        }
+    ));
+    compress_rgb32_to_binary_range(image.data(), image.bytes_per_row(), *matrix, mins, maxs);
+    report.add(results, "BinaryImageFilters::filter_by_mask", size, run_benchmark(
+        [&]{
+            filter_by_mask(*matrix, out.data(), out.bytes_per_row(), (uint32_t)COLOR_WHITE, true);
+        }
+    ));
+
+    //  Waterfill
+    {
+        std::unique_ptr<PackedBinaryMatrix_IB> working;
+        report.add(results, "Waterfill::find_objects_inplace", size, run_benchmark(
+            [&]{
+                working = matrix->clone();
+            },
+            [&]{
+                execution_enforcer += Waterfill::find_objects_inplace(*working, 10).size();
+            }
+        ));
+    }
+
+    //  ImageStats
+    report.add(results, "ImageStats::pixel_sum_sqr", size, run_benchmark(
+        [&]{
+            PixelSums sums;
+            pixel_sum_sqr(
+                sums, width, height,
+                image.data(), image.bytes_per_row(),
+                image.data(), image.bytes_per_row()
+            );
+            execution_enforcer += sums.sumR;
+        }
+    ));
+    ImageRGB32 reference = image.copy();
+    scale_brightness(width, height, reference.data(), reference.bytes_per_row(), 0.9f, 1.0f, 1.1f);
+    report.add(results, "ImageStats::sum_sqr_deviation", size, run_benchmark(
+        [&]{
+            uint64_t count, sumsqrs;
+            sum_sqr_deviation(
+                count, sumsqrs, width, height,
+                reference.data(), reference.bytes_per_row(),
+                image.data(), image.bytes_per_row()
+            );
+            execution_enforcer += sumsqrs;
+        }
+    ));
+    report.add(results, "ImageStats::sum_sqr_deviation_masked", size, run_benchmark(
+        [&]{
+            uint64_t count, sumsqrs;
+            sum_sqr_deviation_masked(
+                count, sumsqrs, width, height,
+                reference.data(), reference.bytes_per_row(),
+                image.data(), image.bytes_per_row()
+            );
+            execution_enforcer += sumsqrs;
+        }
+    ));
+}
+
+
+
+void benchmark_audio_kernels(JsonArray& results, const BenchmarkReport& report){
+    //  AbsFFT
+    for (int k : {10, 12, 14}){
+        const size_t length = (size_t)1 << k;
+        AlignedVector<float> input(length);
+        AlignedVector<float> real(length);
+        AlignedVector<float> abs(length / 2);
+        for (size_t c = 0; c < length; c++){
+            input[c] = std::sin(0.1f * c) + 0.5f * std::cos(0.37f * c);
+        }
+        report.add(results, "AbsFFT::fft_abs", std::to_string(length), run_benchmark(
+            [&]{
+                memcpy(real.data(), input.data(), length * sizeof(float));
+            },
+            [&]{
+                AbsFFT::fft_abs(k, abs.data(), real.data());
+            }
+        ));
+    }
+
+    //  AudioStreamConversion
+    for (size_t length : {4096, 65536}){
+        const std::string size = std::to_string(length);
+        AlignedVector<float> f(length);
+        AlignedVector<int32_t> i32(length);
+        AlignedVector<int16_t> i16(length);
+        AlignedVector<uint8_t> u8(length);
+        AlignedVector<float> mono(length / 2);
+        for (size_t c = 0; c < length; c++){
+            f[c] = std::sin(0.01f * c) * 0.9f;
+        }
+        report.add(results, "AudioStreamConversion::convert_audio_float_to_uint8", size, run_benchmark(
+            [&]{ AudioStreamConversion::convert_audio_float_to_uint8(u8.data(), f.data(), length); }
+        ));
+        report.add(results, "AudioStreamConversion::convert_audio_uint8_to_float", size, run_benchmark(
+            [&]{ AudioStreamConversion::convert_audio_uint8_to_float(f.data(), u8.data(), length, 1.0f); }
+        ));
+        report.add(results, "AudioStreamConversion::convert_audio_float_to_sint16", size, run_benchmark(
+            [&]{ AudioStreamConversion::convert_audio_float_to_sint16(i16.data(), f.data(), length); }
+        ));
+        report.add(results, "AudioStreamConversion::convert_audio_sint16_to_float", size, run_benchmark(
+            [&]{ AudioStreamConversion::convert_audio_sint16_to_float(f.data(), i16.data(), length, 1.0f); }
+        ));
+        report.add(results, "AudioStreamConversion::convert_audio_float_to_sint32", size, run_benchmark(
+            [&]{ AudioStreamConversion::convert_audio_float_to_sint32(i32.data(), f.data(), length); }
+        ));
+        report.add(results, "AudioStreamConversion::convert_audio_sint32_to_float", size, run_benchmark(
+            [&]{ AudioStreamConversion::convert_audio_sint32_to_float(f.data(), i32.data(), length, 1.0f); }
+        ));
+        report.add(results, "AudioStreamConversion::convert_audio_stereo_to_mono", size, run_benchmark(
+            [&]{ AudioStreamConversion::convert_audio_stereo_to_mono(mono.data(), f.data(), length / 2); }
+        ));
+    }
+
+    //  SpikeConvolution
+    //  Same shape as the kernel SpectrogramMatcher builds for 48kHz / 2048 frequencies.
+    const std::vector<float> spike_kernel{
+        -4.f, -3.f, -2.f, -1.f, 0.f, 1.f, 2.f, 3.f, 4.f, 4.f, 3.f, 2.f, 1.f, 0.f, -1.f, -2.f, -3.f, -4.f
+    };
+    for (size_t length : {512, 2048, 8192}){
+        AlignedVector<float> in(length);
+        AlignedVector<float> out(length);
+        for (size_t c = 0; c < length; c++){
+            in[c] = std::abs(std::sin(0.05f * c));
+        }
+        report.add(results, "SpikeConvolution::compute_spike_kernel", std::to_string(length), run_benchmark(
+            [&]{
+                SpikeConvolution::compute_spike_kernel(
+                    out.data(), in.data(), length,
+                    spike_kernel.data(), spike_kernel.size()
+                );
+            }
+        ));
+    }
+}
+
+
+
+void benchmark_matrix_kernels(JsonArray& results, const BenchmarkReport& report){
+    //  ScaleInvariantMatrixMatch
+    //  The largest size is roughly that of a spectrogram template match.
+    const std::vector<std::pair<size_t, size_t>> sizes{
+        {64, 64},
+        {512, 32},
+        {1712, 32},
+    };
+    for (const auto& item : sizes){
+        const size_t width = item.first;
+        const size_t height = item.second;
+        const std::string size = std::to_string(width) + "x" + std::to_string(height);
+
+        //  Rows are padded to keep every row aligned.
+        const size_t stride = (width + 15) / 16 * 16;
+        AlignedVector<float> A(stride * height);
+        AlignedVector<float> T(stride * height);
+        AlignedVector<float> W(stride * height);
+        AlignedVector<float> TW(stride * height);
+        std::vector<const float*> rowsA, rowsT, rowsW, rowsTW;
+        for (size_t r = 0; r < height; r++){
+            for (size_t c = 0; c < stride; c++){
+                size_t index = r * stride + c;
+                A[index] = std::abs(std::sin(0.01f * index));
+                T[index] = 2 * A[index] + 0.1f * std::cos(0.3f * index);
+                W[index] = (index % 7) ? 1.0f : 0.0f;
+                TW[index] = T[index] * W[index];
+            }
+            rowsA.emplace_back(A.data() + r * stride);
+            rowsT.emplace_back(T.data() + r * stride);
+            rowsW.emplace_back(W.data() + r * stride);
+            rowsTW.emplace_back(TW.data() + r * stride);
+        }
+
+        float scale = 0;
+        report.add(results, "ScaleInvariantMatrixMatch::compute_scale", size, run_benchmark(
+            [&]{
+                scale = ScaleInvariantMatrixMatch::compute_scale(width, height, rowsA.data(), rowsT.data());
+            }
+        ));
+        report.add(results, "ScaleInvariantMatrixMatch::compute_error", size, run_benchmark(
+            [&]{
+                execution_enforcer += (size_t)ScaleInvariantMatrixMatch::compute_error(
+                    width, height, scale, rowsA.data(), rowsT.data()
+                );
+            }
+        ));
+        report.add(results, "ScaleInvariantMatrixMatch::compute_scale (weighted)", size, run_benchmark(
+            [&]{
+                scale = ScaleInvariantMatrixMatch::compute_scale(
+                    width, height, rowsA.data(), rowsTW.data(), rowsW.data()
+                );
+            }
+        ));
+        report.add(results, "ScaleInvariantMatrixMatch::compute_error (weighted)", size, run_benchmark(
+            [&]{
+                execution_enforcer += (size_t)ScaleInvariantMatrixMatch::compute_error(
+                    width, height, scale, rowsA.data(), rowsTW.data(), rowsW.data()
+                );
+            }
+        ));
+    }
+}
+
+
+
+}
+
+
+
+int benchmark_kernels(const ImageViewRGB32& image){
+    cout << "Benchmarking kernels, source image size " << image.width() << " x " << image.height() << endl;
+
+    std::vector<ImageRGB32> images;
+    for (const auto& size : IMAGE_SIZES){
+        images.emplace_back(image.scale_to(size.first, size.second));
+    }
+
+    JsonArray results;
+    {
+        CpuCapabilityScope scope;
+        for (const CpuCapabilityOption& isa : AVAILABLE_CAPABILITIES()){
+            if (!isa.available){
+                cout << "Skipping unavailable ISA: " << isa.display << endl;
+                continue;
+            }
+            cout << "===========================================" << endl;
+            cout << "ISA: " << isa.display << endl;
+
+            CPU_CAPABILITY_CURRENT = isa.features;
+            BenchmarkReport report(isa);
+            for (const ImageRGB32& scaled : images){
+                benchmark_image_kernels(results, report, scaled);
+            }
+            benchmark_audio_kernels(results, report);
+            benchmark_matrix_kernels(results, report);
+        }
+    }
+    cout << "Execution enforcer: " << execution_enforcer << endl;
+
+    JsonObject json;
+    json["Architecture"] = PA_ARCH_STRING;
+    json["SourceWidth"] = image.width();
+    json["SourceHeight"] = image.height();
+    json["Results"] = std::move(results);
+    json.dump(KERNEL_BENCHMARK_OUTPUT);
+    cout << "Benchmark results written to " << KERNEL_BENCHMARK_OUTPUT << endl;
+
+    return 0;
+}
+
+
+
+}
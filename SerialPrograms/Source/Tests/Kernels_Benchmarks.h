@@ -0,0 +1,38 @@
+/*  Kernels Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Micro-benchmarks for every kernel under every CPU capability level that
+ *  the host machine supports.
+ *
+ *  Each kernel is first warmed up and then repeated until enough samples are
+ *  collected. The min, median, mean and standard deviation of the samples are
+ *  reported per kernel, per ISA and per input size.
+ *
+ *  Image kernels are run on the test image scaled to several resolutions.
+ *  Audio and matrix kernels are run on synthetic data of several lengths.
+ *
+ *  Results are printed to stdout and written as JSON to KERNEL_BENCHMARK_OUTPUT
+ *  in the current working directory.
+ *
+ *  To run, put any screenshot under the command line test folder at
+ *  "CommandLineTests/Kernels/Benchmark/". See CommandLineTests.h.
+ *
+ */
+
+
+#ifndef PokemonAutomation_Tests_Kernels_Benchmarks_H
+#define PokemonAutomation_Tests_Kernels_Benchmarks_H
+
+namespace PokemonAutomation{
+
+class ImageViewRGB32;
+
+extern const char* KERNEL_BENCHMARK_OUTPUT;
+
+int benchmark_kernels(const ImageViewRGB32& image);
+
+
+}
+
+#endif
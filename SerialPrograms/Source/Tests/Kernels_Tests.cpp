@@ -23,15 +23,25 @@
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrixTile_64x4_Default.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrixTile_64xH_Default.h"
 #include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "Kernels/ImageConvert/Kernels_ImageConvert_HSV32.h"
+#include "Kernels/ImageConvert/Kernels_ImageConvert_HSV32_Default.h"
 #include "Kernels/ImageFilters/Kernels_ImageFilter_Basic.h"
+#include "Kernels/ImageGradient/Kernels_ImageGradient.h"
+#include "Kernels/ImageGradient/Kernels_ImageGradient_Default.h"
+#include "Kernels/ImageGradient/Kernels_ImageGradient_Routines.h"
 #include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_FilterRgb32Range.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Routines.h"
 #include "Kernels_Tests.h"
 #include "TestUtils.h"
 
+#include <cmath>
+#include <tuple>
+#include <vector>
+#include <algorithm>
 #include <functional>
 #include <iostream>
 using std::cout;
@@ -48,6 +58,43 @@ namespace Kernels{}
 namespace{
 
 
+//  The original per-pixel RGB32 to HSV32 conversion of ImageHSV32.
+//  All the ImageConvert kernels must match this exactly.
+uint32_t rgb32_to_hsv32_reference(uint32_t p){
+    int r = (uint32_t(0xff) & (p >> 16));
+    int g = (uint32_t(0xff) & (p >> 8));
+    int b = (uint32_t(0xff) & p);
+
+    int M = std::max(std::max(r, g), b);
+    int m = std::min(std::min(r, g), b);
+
+    int delta = M - m;
+
+    int S = 0;
+    if (M > 0){
+        S = std::min(std::max(255 - (m*255 + M/2)/M, 0), 255);
+    }
+
+    int V = M;
+
+    double Hf = 0;
+    if (delta > 0){
+        if (M == r){
+            Hf = fmod((g - b)/(double)delta, 6.0);
+        }else if (M == g){
+            Hf = (b - r)/(double)delta + 2.0;
+        }else{
+            Hf = (r - g)/(double)delta + 4.0;
+        }
+    }
+    int H = std::max(int(Hf * 256.0 / 6.0 + 0.5) % 256, 0);
+
+    return (p & 0xff000000) |
+           ((uint32_t)(uint8_t)H << 16) |
+           ((uint32_t)(uint8_t)S << 8) |
+           (uint8_t)V;
+}
+
 
 }
 
@@ -73,6 +120,189 @@ int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image){
 }
 
 
+int test_kernels_ImageConvertHSV32(const ImageViewRGB32& image){
+    //  Every 24-bit color, with a mix of alphas. The odd width covers the
+    //  leftover pixels of every vector size.
+    const size_t width = 4099;
+    const size_t height = ((size_t)1 << 24) / width + 1;
+    std::vector<uint32_t> colors(width * height);
+    for (size_t c = 0; c < colors.size(); c++){
+        colors[c] = (uint32_t)(c & 0xffffff) | ((uint32_t)(c * 2654435761u) & 0xff000000);
+    }
+    std::vector<uint32_t> converted(colors.size());
+
+    std::vector<uint32_t> expected_hsv(colors.size());
+    std::vector<uint32_t> expected_rgb(colors.size());
+    for (size_t c = 0; c < colors.size(); c++){
+        expected_hsv[c] = rgb32_to_hsv32_reference(colors[c]);
+        expected_rgb[c] = convert_hsv32_to_rgb32_Default(colors[c]);
+    }
+
+    const CPU_Features saved = CPU_CAPABILITY_CURRENT;
+    size_t error_count = 0;
+    for (const CpuCapabilityOption& isa : AVAILABLE_CAPABILITIES()){
+        if (!isa.available){
+            continue;
+        }
+        CPU_CAPABILITY_CURRENT = isa.features;
+        cout << "Testing HSV32 conversions on all colors, ISA: " << isa.display << endl;
+
+        convert_rgb32_to_hsv32(
+            colors.data(), width * sizeof(uint32_t),
+            converted.data(), width * sizeof(uint32_t),
+            width, height
+        );
+        for (size_t c = 0; c < colors.size(); c++){
+            if (converted[c] != expected_hsv[c] && error_count++ < 10){
+                cout << "Error: RGB32 " << Color(colors[c]).to_string() << " converted to "
+                     << converted[c] << " but expected " << expected_hsv[c] << endl;
+            }
+        }
+
+        convert_hsv32_to_rgb32(
+            colors.data(), width * sizeof(uint32_t),
+            converted.data(), width * sizeof(uint32_t),
+            width, height
+        );
+        for (size_t c = 0; c < colors.size(); c++){
+            if (converted[c] != expected_rgb[c] && error_count++ < 10){
+                cout << "Error: HSV32 " << colors[c] << " converted to " << Color(converted[c]).to_string()
+                     << " but expected " << Color(expected_rgb[c]).to_string() << endl;
+            }
+        }
+    }
+    CPU_CAPABILITY_CURRENT = saved;
+    if (error_count){
+        cout << "Found " << error_count << " errors." << endl;
+        return 1;
+    }
+
+    ImageRGB32 image_hsv(image.width(), image.height());
+    auto time_start = current_time();
+    convert_rgb32_to_hsv32(
+        image.data(), image.bytes_per_row(),
+        image_hsv.data(), image_hsv.bytes_per_row(),
+        image.width(), image.height()
+    );
+    auto time_end = current_time();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+    cout << "One RGB32 to HSV32 conversion time: " << ns / 1000000. << " ms" << endl;
+
+    return 0;
+}
+
+
+int test_kernels_ImageGradient(const ImageViewRGB32& image){
+    //  Punch some transparent holes into the image so that the alpha handling
+    //  is covered. The odd width covers the leftover pixels of every vector size.
+    const size_t width = std::min<size_t>(image.width(), 301) | 1;
+    const size_t height = std::min<size_t>(image.height(), 200);
+    ImageRGB32 input(width, height);
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            uint32_t pixel = image.pixel(c, r);
+            if ((r * 31 + c * 17) % 97 < 5 || (c / 40 + r / 40) % 5 == 0){
+                pixel &= 0x7fffffff;
+            }
+            input.pixel(c, r) = pixel;
+        }
+    }
+    const size_t bpr = input.bytes_per_row();
+    const size_t templ_width = width / 2;
+    const size_t templ_height = height / 2;
+
+    ImageRGB32 expected_smooth(width, height);
+    ImageRGB32 expected_gradient(width, height);
+    size_t expected_bins[SOBEL_ORIENTATION_BINS];
+    smooth_rgb32<ImageGradient_Default>(input.data(), bpr, expected_smooth.data(), expected_smooth.bytes_per_row(), width, height);
+    sobel_gradient_rgb32<ImageGradient_Default>(
+        expected_smooth.data(), expected_smooth.bytes_per_row(),
+        expected_gradient.data(), expected_gradient.bytes_per_row(),
+        width, height
+    );
+    size_t expected_count = sobel_orientation_histogram_rgb32<ImageGradient_Default>(
+        expected_smooth.data(), expected_smooth.bytes_per_row(), width, height, 2000, expected_bins
+    );
+    double expected_distance = gradient_block_distance<ImageGradient_Default>(
+        expected_gradient.data(), expected_gradient.bytes_per_row(), templ_width, templ_height,
+        expected_gradient.data(), expected_gradient.bytes_per_row(), width, height,
+        2, 5
+    );
+
+    ImageRGB32 smooth(width, height);
+    ImageRGB32 gradient(width, height);
+    const CPU_Features saved = CPU_CAPABILITY_CURRENT;
+    size_t error_count = 0;
+    for (const CpuCapabilityOption& isa : AVAILABLE_CAPABILITIES()){
+        if (!isa.available){
+            continue;
+        }
+        CPU_CAPABILITY_CURRENT = isa.features;
+        cout << "Testing image gradient kernels, ISA: " << isa.display << endl;
+
+        smooth_rgb32(input.data(), bpr, smooth.data(), smooth.bytes_per_row(), width, height);
+        sobel_gradient_rgb32(
+            expected_smooth.data(), expected_smooth.bytes_per_row(),
+            gradient.data(), gradient.bytes_per_row(),
+            width, height
+        );
+        for (size_t r = 0; r < height; r++){
+            for (size_t c = 0; c < width; c++){
+                if (smooth.pixel(c, r) != expected_smooth.pixel(c, r) && error_count++ < 10){
+                    cout << "Error: smoothed pixel (" << c << "," << r << ") is " << Color(smooth.pixel(c, r)).to_string()
+                         << " but expected " << Color(expected_smooth.pixel(c, r)).to_string() << endl;
+                }
+                if (gradient.pixel(c, r) != expected_gradient.pixel(c, r) && error_count++ < 10){
+                    cout << "Error: gradient pixel (" << c << "," << r << ") is " << Color(gradient.pixel(c, r)).to_string()
+                         << " but expected " << Color(expected_gradient.pixel(c, r)).to_string() << endl;
+                }
+            }
+        }
+
+        size_t bins[SOBEL_ORIENTATION_BINS];
+        size_t count = sobel_orientation_histogram_rgb32(
+            expected_smooth.data(), expected_smooth.bytes_per_row(), width, height, 2000, bins
+        );
+        if (count != expected_count){
+            cout << "Error: histogram counted " << count << " gradients but expected " << expected_count << endl;
+            error_count++;
+        }
+        for (size_t c = 0; c < SOBEL_ORIENTATION_BINS; c++){
+            if (bins[c] != expected_bins[c]){
+                cout << "Error: histogram bin " << c << " is " << bins[c] << " but expected " << expected_bins[c] << endl;
+                error_count++;
+            }
+        }
+
+        double distance = gradient_block_distance(
+            expected_gradient.data(), expected_gradient.bytes_per_row(), templ_width, templ_height,
+            expected_gradient.data(), expected_gradient.bytes_per_row(), width, height,
+            2, 5
+        );
+        if (std::abs(distance - expected_distance) > 1e-9 * std::max(1.0, expected_distance)){
+            cout << "Error: gradient distance is " << distance << " but expected " << expected_distance << endl;
+            error_count++;
+        }
+    }
+    CPU_CAPABILITY_CURRENT = saved;
+    if (error_count){
+        cout << "Found " << error_count << " errors." << endl;
+        return 1;
+    }
+
+    auto time_start = current_time();
+    double distance = gradient_block_distance(
+        expected_gradient.data(), expected_gradient.bytes_per_row(), templ_width, templ_height,
+        expected_gradient.data(), expected_gradient.bytes_per_row(), width, height,
+        2, 5
+    );
+    auto time_end = current_time();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+    cout << "Gradient distance " << distance << " time: " << ns / 1000000. << " ms" << endl;
+
+    return 0;
+}
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image){
 
     if (test_binary_matrix_tile() != 0){
@@ -663,6 +893,79 @@ int test_kernels_Waterfill(const ImageViewRGB32& image){
     return 0;
 }
 
+int test_kernels_WaterfillFilterRgb32Range(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing test_kernels_WaterfillFilterRgb32Range(), image size " << width << " x " << height << endl;
+
+    const std::vector<std::pair<uint32_t, uint32_t>> filters{
+        {combine_rgb(0, 0, 0), combine_rgb(63, 63, 63)},
+        {combine_rgb(0, 0, 0), combine_rgb(127, 127, 127)},
+        {combine_rgb(128, 128, 128), combine_rgb(255, 255, 255)},
+        {combine_rgb(150, 0, 0), combine_rgb(255, 100, 100)},
+    };
+    const size_t min_area = 10;
+
+    //  The banded objects are merged across band edges in a different order
+    //  from the waterfill. So compare them after sorting.
+    auto sort_objects = [](std::vector<Kernels::Waterfill::WaterfillObject>& objects){
+        std::sort(
+            objects.begin(), objects.end(),
+            [](const Kernels::Waterfill::WaterfillObject& x, const Kernels::Waterfill::WaterfillObject& y){
+                return std::make_tuple(x.min_y, x.min_x, x.max_y, x.max_x, x.area, x.sum_x, x.sum_y)
+                     < std::make_tuple(y.min_y, y.min_x, y.max_y, y.max_x, y.area, y.sum_x, y.sum_y);
+            }
+        );
+    };
+
+    std::vector<PackedBinaryMatrix> matrices;
+    std::vector<Kernels::CompressRgb32ToBinaryRangeFilter> gt_filters;
+    matrices.reserve(filters.size());
+    gt_filters.reserve(filters.size());
+    for (const auto& filter : filters){
+        matrices.emplace_back(width, height);
+        gt_filters.emplace_back(matrices.back(), filter.first, filter.second);
+    }
+    Kernels::compress_rgb32_to_binary_range(
+        image.data(), image.bytes_per_row(),
+        gt_filters.data(), gt_filters.size()
+    );
+
+    auto time_start = current_time();
+    std::vector<std::vector<Kernels::Waterfill::WaterfillObject>> objects = Kernels::Waterfill::find_objects_rgb32_range(
+        image.data(), image.bytes_per_row(), width, height, filters, min_area
+    );
+    auto time_end = current_time();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+    auto ms = ns / 1000000.;
+    cout << "One banded filter and waterfill time: " << ms << " ms" << endl;
+
+    TEST_RESULT_COMPONENT_EQUAL(objects.size(), filters.size(), "number of filters");
+    for (size_t c = 0; c < filters.size(); c++){
+        std::vector<Kernels::Waterfill::WaterfillObject> gt_objects = Kernels::Waterfill::find_objects_inplace(matrices[c], min_area);
+        sort_objects(gt_objects);
+        sort_objects(objects[c]);
+        cout << "Filter " << c << ", num objects: " << gt_objects.size() << endl;
+
+        const std::string prefix = "filter " + std::to_string(c) + " ";
+        TEST_RESULT_COMPONENT_EQUAL(objects[c].size(), gt_objects.size(), prefix + "num objects");
+        for (size_t i = 0; i < objects[c].size(); i++){
+            const Kernels::Waterfill::WaterfillObject& object = objects[c][i];
+            const Kernels::Waterfill::WaterfillObject& gt_object = gt_objects[i];
+            const std::string name = prefix + "object " + std::to_string(i) + " ";
+            TEST_RESULT_COMPONENT_EQUAL(object.area, gt_object.area, name + "area");
+            TEST_RESULT_COMPONENT_EQUAL(object.min_x, gt_object.min_x, name + "min_x");
+            TEST_RESULT_COMPONENT_EQUAL(object.min_y, gt_object.min_y, name + "min_y");
+            TEST_RESULT_COMPONENT_EQUAL(object.max_x, gt_object.max_x, name + "max_x");
+            TEST_RESULT_COMPONENT_EQUAL(object.max_y, gt_object.max_y, name + "max_y");
+            TEST_RESULT_COMPONENT_EQUAL(object.sum_x, gt_object.sum_x, name + "sum_x");
+            TEST_RESULT_COMPONENT_EQUAL(object.sum_y, gt_object.sum_y, name + "sum_y");
+        }
+    }
+
+    return 0;
+}
+
 // Additional tests on binary matrix tile implementation
 template<class Tile> int test_binary_matrix_tile_t(){
     size_t num_iters = 100000;
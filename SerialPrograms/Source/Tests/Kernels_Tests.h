@@ -15,6 +15,9 @@ class ImageViewRGB32;
 
 int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image);
 
+int test_kernels_ImageConvertHSV32(const ImageViewRGB32& image);
+int test_kernels_ImageGradient(const ImageViewRGB32& image);
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image);
 
 int test_kernels_FilterRGB32Range(const ImageViewRGB32& image);
@@ -31,6 +34,8 @@ int test_kernels_CompressRGB32ToBinaryEuclidean(const ImageViewRGB32& image);
 
 int test_kernels_Waterfill(const ImageViewRGB32& image);
 
+int test_kernels_WaterfillFilterRgb32Range(const ImageViewRGB32& image);
+
 
 }
 
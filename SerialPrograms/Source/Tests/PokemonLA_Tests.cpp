@@ -8,6 +8,7 @@
 #include "Common/Compiler.h"
 #include "PokemonLA_Tests.h"
 #include "TestUtils.h"
+#include "InferenceReplay.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/Language.h"
 #include "PokemonLA/Inference/Battles/PokemonLA_BattleMenuDetector.h"
@@ -501,6 +502,24 @@ int test_pokemonLA_shinySoundDetector(const std::vector<AudioSpectrum>& spectrum
     return 0;
 }
 
+int test_pokemonLA_shinySoundReplay(const std::string& filepath, bool target){
+    auto& logger = global_logger_command_line();
+    ReplayVideoFeed video_feed(ReplaySpeed::AS_FAST_AS_POSSIBLE);
+    ReplayAudioFeed audio_feed(filepath, ReplaySpeed::AS_FAST_AS_POSSIBLE);
+
+    InferenceReplay replay(logger, video_feed, audio_feed);
+    ShinySoundDetector detector(replay.console(), [&](float error_coefficient) -> bool{
+        return true;
+    });
+
+    InferenceReplayStats stats = replay.run({detector});
+    cout << stats.to_str() << endl;
+
+    bool result = stats.triggered_index == 0;
+    TEST_RESULT_EQUAL(result, target);
+    return 0;
+}
+
 // Load an image with MMO question marks from an MMO event, with filename <XXX.png>
 // Load an image with MMO question marks revealed by Munchlax to show each pokemon sprite from the same MMO event, with filename <_XXX.png>
 // Load a text file with each line the pokemon in the MMO event, with filename <_XXX.txt>. If more than one pokemon of the same species appears,
@@ -55,6 +55,9 @@ int test_pokemonLA_BerryTreeDetector(const ImageViewRGB32& image);
 
 int test_pokemonLA_shinySoundDetector(const std::vector<AudioSpectrum>& spectrums, bool target);
 
+// Replay the audio file through the audio inference pivot, the same as in a program.
+int test_pokemonLA_shinySoundReplay(const std::string& filepath, bool target);
+
 int test_pokemonLA_MMOSpriteMatcher(const std::string& filepath);
 
 int test_pokemonLA_MapWeatherAndTimeReader(const ImageViewRGB32& image, const std::vector<std::string>& keywords);
@@ -10,6 +10,8 @@
 #include "TestUtils.h"
 
 #include "Common/Cpp/Containers/FixedLimitVector.tpp"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/Inference/LocationTracker.h"
 #include "PokemonSV/Inference/Battles/PokemonSV_NormalBattleMenus.h"
 #include "PokemonSV/Inference/Boxes/PokemonSV_BoxDetection.h"
 #include "PokemonSV/Inference/Boxes/PokemonSV_BoxEggDetector.h"
@@ -31,7 +33,12 @@
 #include "PokemonSV/Inference/Overworld/PokemonSV_OverworldDetector.h"
 #include "PokemonSV/Inference/Dialogs/PokemonSV_DialogDetector.h"
 #include "PokemonSV/Inference/PokemonSV_ESPEmotionDetector.h"
+#include "PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch.h"
 
+#include <QFileInfo>
+
+#include <set>
+#include <cmath>
 #include <iostream>
 using std::cout;
 using std::cerr;
@@ -196,6 +203,108 @@ int test_pokemonSV_SandwichRecipeDetector(const ImageViewRGB32& image, const std
     return 0;
 }
 
+namespace{
+
+//  Return a copy of "image" moved right by "dx" and down by "dy" pixels. The
+//  uncovered part is black.
+ImageRGB32 shift_image(const ImageViewRGB32& image, ptrdiff_t dx, ptrdiff_t dy){
+    const ptrdiff_t width = (ptrdiff_t)image.width();
+    const ptrdiff_t height = (ptrdiff_t)image.height();
+    ImageRGB32 ret(image.width(), image.height());
+    ret.fill(0xff000000);
+    for (ptrdiff_t r = std::max<ptrdiff_t>(0, dy); r < std::min(height, height + dy); r++){
+        for (ptrdiff_t c = std::max<ptrdiff_t>(0, dx); c < std::min(width, width + dx); c++){
+            ret.pixel((size_t)c, (size_t)r) = image.pixel((size_t)(c - dx), (size_t)(r - dy));
+        }
+    }
+    return ret;
+}
+
+//  Replay the hand in "image", found at "start", moving at "speed" screen
+//  units per frame. The hand turns sharply every few frames, which is the
+//  hardest case for predicting where it goes next.
+//
+//  Return false if the tracker's window finds the hand on fewer frames than
+//  re-centering a box 4 times the hand size on each detection, which is what
+//  move_sandwich_hand() searches.
+bool replay_sandwich_hand(
+    const SandwichHandLocator& locator, const ImageViewRGB32& image,
+    std::pair<double, double> start, double speed
+){
+    const double hand_width = 0.071, hand_height = 0.106;
+    const std::chrono::milliseconds frame_period(50);
+
+    //  The directions the hand moves in. Each is held for "LEG_FRAMES"
+    //  frames. The first leg is the hand sitting still.
+    const double directions[][2] = {
+        {0, 0}, {1, 0}, {-1, 0}, {0.6, 0.8}, {0, -1}, {-0.8, 0.6}, {0, 0}, {1, 0},
+    };
+    const size_t LEG_FRAMES = 6;
+
+    LocationTracker tracker(ImageFloatBox(0, 0, 1, 1), hand_width, hand_height);
+    std::pair<double, double> baseline_location = start;
+    WallClock timestamp = current_time();
+    tracker.locate(image, timestamp, [&](const ImageViewRGB32& screen, const ImageFloatBox& area){
+        return locator.locate_sandwich_hand(screen, area);
+    });
+
+    double x = start.first;
+    double y = start.second;
+    size_t frames = 0;
+    size_t tracker_hits = 0;
+    size_t baseline_hits = 0;
+    double tracker_area = 0;
+    double baseline_area = 0;
+    for (const auto& direction : directions){
+        for (size_t c = 0; c < LEG_FRAMES; c++){
+            //  Keep the whole hand on the screen.
+            x = std::min(std::max(x + direction[0] * speed, hand_width), 1 - hand_width);
+            y = std::min(std::max(y + direction[1] * speed, hand_height), 1 - hand_height);
+            ImageRGB32 frame = shift_image(
+                image,
+                (ptrdiff_t)std::round((x - start.first) * image.width()),
+                (ptrdiff_t)std::round((y - start.second) * image.height())
+            );
+            timestamp += frame_period;
+            frames++;
+
+            //  The box used by move_sandwich_hand().
+            const double box_x = std::max(0.0, baseline_location.first - hand_width * 2);
+            const double box_y = std::max(0.0, baseline_location.second - hand_height * 2);
+            const ImageFloatBox box(
+                box_x, box_y,
+                std::min(hand_width * 4, 1.0 - box_x),
+                std::min(hand_height * 4, 1.0 - box_y)
+            );
+            baseline_area += box.width * box.height;
+            std::pair<double, double> location = locator.locate_sandwich_hand(frame, box);
+            if (location.first >= 0){
+                baseline_hits++;
+            }else{
+                location = locator.locate_sandwich_hand(frame, ImageFloatBox(0, 0, 1, 1));
+            }
+            if (location.first >= 0){
+                baseline_location = location;
+            }
+
+            const ImageFloatBox window = tracker.search_window(timestamp);
+            tracker_area += window.width * window.height;
+            uint64_t hits = tracker.window_hits();
+            tracker.locate(frame, timestamp, [&](const ImageViewRGB32& screen, const ImageFloatBox& area){
+                return locator.locate_sandwich_hand(screen, area);
+            });
+            tracker_hits += tracker.window_hits() - hits;
+        }
+    }
+
+    cout << "Hand speed " << speed << ": tracker found the hand in its window on " << tracker_hits << "/" << frames
+         << " frames, searching " << tracker_area / frames << " of the screen. Re-centered box found it on "
+         << baseline_hits << "/" << frames << " frames, searching " << baseline_area / frames << " of the screen." << endl;
+    return tracker_hits >= baseline_hits;
+}
+
+}
+
 // - the last 4 words should be the coordinates for the FloatBox, that the detector will search
 // - the 5th word from last should be the Hand type (Free or Grabbing)
 // - optional: if the image should not detect the hand, the 6th word from last should "False"
@@ -242,6 +351,14 @@ int test_pokemonSV_SandwichHandDetector(const ImageViewRGB32& image, const std::
 
     TEST_RESULT_EQUAL(has_hand, hand_expected);
 
+    //  Move the hand around and check that tracking it doesn't lose it more
+    //  often than the routines' re-centered box does.
+    if (has_hand){
+        for (double speed : {0.005, 0.015, 0.03, 0.05}){
+            TEST_RESULT_COMPONENT_EQUAL(replay_sandwich_hand(detector, image, result, speed), true, "hand tracking at speed " + std::to_string(speed));
+        }
+    }
+
     return 0;
 }
 
@@ -560,4 +677,98 @@ int test_pokemonSV_RecentlyBattledDetector(const ImageViewRGB32& image, bool tar
     return 0;
 }
 
+// The filename is a seed from the date seed database, e.g. <958172368.txt>. The file content is not used.
+// Search the seeds around it and check the results against calculate_seed_prizes().
+int test_pokemonSV_ItemPrinterSeedSearch(const std::string& filepath){
+    using namespace ItemPrinter;
+
+    bool ok = false;
+    const int64_t center = QFileInfo(QString::fromStdString(filepath)).baseName().toLongLong(&ok);
+    if (!ok){
+        cerr << "Error: filename should be a date seed (e.g. \"958172368.txt\")." << endl;
+        return 1;
+    }
+    if (get_date_seed(center).seed != center){
+        cerr << "Error: seed " << center << " is not in the date seed database." << endl;
+        return 1;
+    }
+
+    const int64_t start = center - 2;
+    const int64_t end = center + 3;
+
+    for (PrintMode mode : {PrintMode::Regular, PrintMode::ItemBonus, PrintMode::BallBonus}){
+        std::array<ItemPrinterPrize, 10> center_prizes;
+        calculate_prizes(center_prizes, center, mode);
+
+        // Score on the first prize of the center seed. With no minimum quantity every seed is kept.
+        SeedSearchRequest request;
+        request.start_seed = start;
+        request.end_seed = end;
+        request.mode = mode;
+        request.targets.emplace_back(SeedSearchTarget{center_prizes[0].slug, 0, 1.0});
+        request.threads = 2;
+
+        const std::vector<SeedSearchResult> results = search_seeds(request);
+        TEST_RESULT_COMPONENT_EQUAL(results.size(), (size_t)(end - start), "number of results");
+
+        std::set<int64_t> seeds;
+        for (size_t c = 0; c < results.size(); c++){
+            const SeedSearchResult& result = results[c];
+            seeds.insert(result.seed);
+
+            if (c > 0){
+                const SeedSearchResult& previous = results[c - 1];
+                bool ranked = previous.score > result.score || (previous.score == result.score && previous.seed < result.seed);
+                TEST_RESULT_COMPONENT_EQUAL(ranked, true, "ranking of seed " + std::to_string(result.seed));
+            }
+
+            const DateSeed expected = calculate_seed_prizes(result.seed);
+            const std::array<std::string, 10>& slugs =
+                mode == PrintMode::Regular ? expected.regular :
+                mode == PrintMode::ItemBonus ? expected.item_bonus : expected.ball_bonus;
+
+            double score = 0;
+            for (size_t i = 0; i < 10; i++){
+                TEST_RESULT_COMPONENT_EQUAL(std::string(result.prizes[i].slug), slugs[i], "prize " + std::to_string(i) + " of seed " + std::to_string(result.seed));
+                if (result.prizes[i].slug == center_prizes[0].slug){
+                    score += result.prizes[i].quantity;
+                }
+            }
+            TEST_RESULT_COMPONENT_EQUAL(result.score, score, "score of seed " + std::to_string(result.seed));
+        }
+        TEST_RESULT_COMPONENT_EQUAL(seeds.size(), (size_t)(end - start), "number of distinct seeds");
+
+        // Requiring the center seed's own quantity must keep the center seed.
+        for (const SeedSearchResult& result : results){
+            if (result.seed == center){
+                request.targets[0].min_quantity = (uint16_t)result.score;
+            }
+        }
+        const std::vector<SeedSearchResult> filtered = search_seeds(request);
+        bool has_center = false;
+        for (const SeedSearchResult& result : filtered){
+            has_center |= result.seed == center;
+            TEST_RESULT_COMPONENT_EQUAL(result.score >= request.targets[0].min_quantity, true, "minimum quantity of seed " + std::to_string(result.seed));
+        }
+        TEST_RESULT_COMPONENT_EQUAL(has_center, true, "center seed kept by minimum quantity");
+    }
+
+    // The item bonus doubles every quantity. The regular mode draws one extra number after its
+    // first bonus roll, so only the first prize is guaranteed to be the same item in both modes.
+    for (int64_t seed = start; seed < end; seed++){
+        std::array<ItemPrinterPrize, 10> regular;
+        std::array<ItemPrinterPrize, 10> item_bonus;
+        calculate_prizes(regular, seed, PrintMode::Regular);
+        calculate_prizes(item_bonus, seed, PrintMode::ItemBonus);
+
+        TEST_RESULT_COMPONENT_EQUAL(std::string(item_bonus[0].slug), std::string(regular[0].slug), "item bonus first prize of seed " + std::to_string(seed));
+        TEST_RESULT_COMPONENT_EQUAL((int)item_bonus[0].quantity, 2 * (int)regular[0].quantity, "item bonus first quantity of seed " + std::to_string(seed));
+        for (size_t i = 0; i < 10; i++){
+            TEST_RESULT_COMPONENT_EQUAL(item_bonus[i].quantity % 2, 0, "item bonus quantity " + std::to_string(i) + " of seed " + std::to_string(seed));
+        }
+    }
+
+    return 0;
+}
+
 }
@@ -8,6 +8,7 @@
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "CommonFramework_Tests.h"
 #include "Kernels_Tests.h"
+#include "Kernels_Benchmarks.h"
 #include "NintendoSwitch_Tests.h"
 #include "PokemonLA_Tests.h"
 #include "PokemonSwSh_Tests.h"
@@ -48,6 +49,8 @@ using ImageVoidDetectorFunction = std::function<int(const ImageViewRGB32& image)
 
 using SoundBoolDetectorFunction = std::function<int(const std::vector<AudioSpectrum>& spectrums, bool target)>;
 
+using SoundFileBoolDetectorFunction = std::function<int(const std::string& filepath, bool target)>;
+
 // Basic check on whether an image can be loaded.
 // Also strip the image format suffix (.png and so on)
 
@@ -169,7 +172,9 @@ int image_void_detector_helper(ImageVoidDetectorFunction test_func, const std::s
 // Basic check on whether an image can be loaded.
 // Also strip the image format suffix (.png and so on)
 
-int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::string& test_path){
+// Read the target detection result (_True/_False) from an audio test filename.
+// Return 0 if succeed.
+int parse_sound_bool_target(const std::string& test_path, bool& target_bool){
     QFileInfo file_info(QString::fromStdString(test_path));
     std::string filename = file_info.fileName().toStdString();
 
@@ -184,7 +189,6 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
     const auto filename_base = filename.substr(0, target_pos);
 
     const auto name_base = QString::fromStdString(filename_base);
-    bool target_bool = false;
     if (name_base.endsWith("_True")){
         target_bool = true;
     }else if (name_base.endsWith("_False")){
@@ -193,8 +197,15 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
         cerr << "Error: audio test file " << test_path << " has incorrect target detection result (_True/_False) set in the filename." << endl;
         return 1;
     }
+    return 0;
+}
 
-
+int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::string& test_path){
+    bool target_bool = false;
+    int ret = parse_sound_bool_target(test_path, target_bool);
+    if (ret != 0){
+        return ret;
+    }
 
     // XXX for now we assume the audio in the command line test is always 48000.
     //     in future we can read sample rate from filename
@@ -215,11 +226,33 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
     return test_func(spectrums, target_bool);
 }
 
+// Helper for testing code that replays an audio file through the audio inference pivot.
+int sound_file_bool_detector_helper(SoundFileBoolDetectorFunction test_func, const std::string& test_path){
+    bool target_bool = false;
+    int ret = parse_sound_bool_target(test_path, target_bool);
+    if (ret != 0){
+        return ret;
+    }
+    return test_func(test_path, target_bool);
+}
+
+// Run each WAV file in the PokemonLA shiny sound folder twice: once on its spectrums directly,
+// then replayed through the audio inference pivot the same way a program runs the detector.
+int pokemonLA_shiny_sound_helper(const std::string& test_path){
+    int ret = sound_bool_detector_helper(test_pokemonLA_shinySoundDetector, test_path);
+    if (ret != 0){
+        return ret;
+    }
+    return sound_file_bool_detector_helper(test_pokemonLA_shinySoundReplay, test_path);
+}
+
 
 
 
 const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_ImageScaleBrightness", std::bind(image_void_detector_helper, test_kernels_ImageScaleBrightness, _1)},
+    {"Kernels_ImageConvertHSV32", std::bind(image_void_detector_helper, test_kernels_ImageConvertHSV32, _1)},
+    {"Kernels_ImageGradient", std::bind(image_void_detector_helper, test_kernels_ImageGradient, _1)},
     {"Kernels_BinaryMatrix", std::bind(image_void_detector_helper, test_kernels_BinaryMatrix, _1)},
     {"Kernels_FilterRGB32Range", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Range, _1)},
     {"Kernels_FilterRGB32Euclidean", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Euclidean, _1)},
@@ -227,6 +260,8 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_FilterByMask", std::bind(image_void_detector_helper, test_kernels_FilterByMask, _1)},
     {"Kernels_CompressRGB32ToBinaryEuclidean", std::bind(image_void_detector_helper, test_kernels_CompressRGB32ToBinaryEuclidean, _1)},
     {"Kernels_Waterfill", std::bind(image_void_detector_helper, test_kernels_Waterfill, _1)},
+    {"Kernels_WaterfillFilterRgb32Range", std::bind(image_void_detector_helper, test_kernels_WaterfillFilterRgb32Range, _1)},
+    {"Kernels_Benchmark", std::bind(image_void_detector_helper, benchmark_kernels, _1)},
     {"CommonFramework_BlackBorderDetector", std::bind(image_bool_detector_helper, test_CommonFramework_BlackBorderDetector, _1)},
     {"NintendoSwitch_UpdateMenuDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_UpdateMenuDetector, _1)},
     {"PokemonSwSh_YCommMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_YCommMenuDetector, _1)},
@@ -257,7 +292,7 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonLA_MapZoomLevelReader", std::bind(image_int_detector_helper, test_pokemonLA_MapZoomLevelReader, _1)},
     {"PokemonLA_BattleSpriteArrowDetector", std::bind(image_int_detector_helper, test_pokemonLA_BattleSpriteArrowDetector, _1)},
     {"PokemonLA_MapMissionTabReader", std::bind(image_bool_detector_helper, test_pokemonLA_MapMissionTabReader, _1)},
-    {"PokemonLA_ShinySoundDetector", std::bind(sound_bool_detector_helper, test_pokemonLA_shinySoundDetector, _1)},
+    {"PokemonLA_ShinySoundDetector", pokemonLA_shiny_sound_helper},
     {"PokemonLA_MMOSpriteMatcher", test_pokemonLA_MMOSpriteMatcher},
     {"PokemonLA_MapWeatherAndTimeReader", std::bind(image_words_detector_helper, test_pokemonLA_MapWeatherAndTimeReader, _1)},
     {"PokemonLA_FlagTrackerPerformance", std::bind(image_int_detector_helper, test_pokemonLA_FlagTracker_performance, _1)},
@@ -285,7 +320,8 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSV_ESPPressedEmotionDetector", std::bind(image_bool_detector_helper, test_pokemonSV_ESPPressedEmotionDetector, _1)},
     {"PokemonSV_MapFlyMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSV_MapFlyMenuDetector, _1)},
     {"PokemonSV_SandwichPlateDetector", std::bind(image_words_detector_helper, test_pokemonSV_SandwichPlateDetector, _1)},
-    {"PokemonSV_RecentlyBattledDetector", std::bind(image_bool_detector_helper, test_pokemonSV_RecentlyBattledDetector, _1)}
+    {"PokemonSV_RecentlyBattledDetector", std::bind(image_bool_detector_helper, test_pokemonSV_RecentlyBattledDetector, _1)},
+    {"PokemonSV_ItemPrinterSeedSearch", test_pokemonSV_ItemPrinterSeedSearch}
 };
 
 TestFunction find_test_function(const std::string& test_space, const std::string& test_name){
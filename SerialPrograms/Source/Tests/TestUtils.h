@@ -126,9 +126,9 @@ public:
     DummyAudioFeed() {}
     virtual void reset() override {}
 
-    virtual std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum) override { return std::vector<AudioSpectrum>(); }
+    virtual void load_spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_seqnum) override { spectrums.clear(); }
 
-    virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) override { return std::vector<AudioSpectrum>(); }
+    virtual void load_spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_last_spectrums) override { spectrums.clear(); }
 
     void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) override {}
 };